@@ -0,0 +1,2063 @@
+/**
+ * @file bench_list.c
+ * @brief Embedded-List 性能基准测试程序
+ *
+ * 用于对比批量接口与逐节点操作的耗时，编译运行：make bench
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "embedded_list.h"
+#include "list_save.h"
+#include "list_pq.h"
+#include "list_hash.h"
+#include "list_order.h"
+#include "list_lru.h"
+#include "list_parallel.h"
+#include "list_algo.h"
+#include "list_journal.h"
+#include "list_crc.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// 获取单调时钟时间（纳秒）
+static uint64_t bench_now_ns(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER freq, counter;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&counter);
+	return (uint64_t)(counter.QuadPart * 1000000000.0 / freq.QuadPart);
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void bench_report(const char *name, uint64_t elapsed_ns, uint32_t ops)
+{
+	printf("  %-40s %10.3f ms  %8.1f ns/op\n", name, elapsed_ns / 1e6, ops ? (double)elapsed_ns / ops : 0.0);
+}
+
+static void bench_fill(list_handle_t list, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		list_push_back(list, &i);
+	}
+}
+
+// ========================= 范围删除 =========================
+static void bench_erase_range(void)
+{
+	const int list_len = 10000;
+	const int prefix = 2000;
+	const int rounds = 200;
+
+	printf("[范围删除] 列表长度 %d，每轮删除前 %d 个元素，共 %d 轮\n", list_len, prefix, rounds);
+
+	list_handle_t list = list_create(list_len, sizeof(int));
+	if (list == NULL)
+		return;
+
+	uint64_t loop_ns = 0;
+	uint64_t range_ns = 0;
+	uint64_t truncate_ns = 0;
+
+	for (int r = 0; r < rounds; r++)
+	{
+		// 逐节点删除
+		list_clear(list);
+		bench_fill(list, list_len);
+		uint64_t start = bench_now_ns();
+		for (int i = 0; i < prefix; i++)
+		{
+			list_erase(list, list_begin(list));
+		}
+		loop_ns += bench_now_ns() - start;
+
+		// list_erase_range
+		list_clear(list);
+		bench_fill(list, list_len);
+		list_iterator_t last = list_at(list, prefix);  // 定位结束节点不计入删除时间
+		start = bench_now_ns();
+		list_erase_range(list, list_begin(list), last, NULL);
+		range_ns += bench_now_ns() - start;
+
+		// list_truncate_front
+		list_clear(list);
+		bench_fill(list, list_len);
+		start = bench_now_ns();
+		list_truncate_front(list, prefix);
+		truncate_ns += bench_now_ns() - start;
+	}
+
+	bench_report("list_erase 逐节点循环", loop_ns, prefix * rounds);
+	bench_report("list_erase_range", range_ns, prefix * rounds);
+	bench_report("list_truncate_front", truncate_ns, prefix * rounds);
+
+	list_free(list);
+}
+
+// ========================= 拼接与合并 =========================
+static void bench_merge(void)
+{
+	const int lengths[] = {100, 1000, 10000, 60000};
+	const int rounds = 10000;
+
+	printf("[合并] 共享节点池的两个列表整表 list_merge 往返 %d 次，对比需要计数的 list_splice(first, last)\n", rounds);
+
+	for (size_t n = 0; n < sizeof(lengths) / sizeof(lengths[0]); n++)
+	{
+		int len = lengths[n];
+		list_handle_t list1 = list_create(len, sizeof(int));
+		list_handle_t list2 = list_create_shared(list1);
+		if (list1 == NULL || list2 == NULL)
+		{
+			if (list2)
+				list_free(list2);
+			if (list1)
+				list_free(list1);
+			return;
+		}
+		bench_fill(list2, len);
+
+		uint64_t start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+		{
+			list_merge(list1, list2);
+			list_merge(list2, list1);
+		}
+		uint64_t merge_ns = bench_now_ns() - start;
+
+		// 移动除尾节点以外的所有节点，需要遍历计数
+		start = bench_now_ns();
+		for (int r = 0; r < rounds / 100; r++)
+		{
+			list_splice(list1, NULL, list2, list_begin(list2), list_end(list2));
+			list_merge(list2, list1);
+		}
+		uint64_t splice_ns = bench_now_ns() - start;
+
+		char name[64];
+		snprintf(name, sizeof(name), "list_merge        n=%d", len);
+		bench_report(name, merge_ns, rounds * 2);
+		snprintf(name, sizeof(name), "list_splice(计数) n=%d", len);
+		bench_report(name, splice_ns, rounds / 100);
+
+		list_free(list2);
+		list_free(list1);
+	}
+}
+
+// ========================= 跨节点池拼接 =========================
+typedef struct
+{
+	uint32_t timestamp;
+	uint8_t payload[28];
+} bench_record_t;
+
+static void bench_cross_pool_splice(void)
+{
+	const int capacity = 4096;
+	const int batch = 64;
+	const int rounds = 20000;
+
+	printf("[跨节点池拼接] 两个独立创建的列表之间移动 %d 个 %zu 字节元素的批次，共 %d 次\n",
+	       batch, sizeof(bench_record_t), rounds);
+
+	list_handle_t src = list_create(capacity, sizeof(bench_record_t));
+	list_handle_t dst = list_create(capacity, sizeof(bench_record_t));
+	if (src == NULL || dst == NULL)
+	{
+		if (src)
+			list_free(src);
+		if (dst)
+			list_free(dst);
+		return;
+	}
+
+	bench_record_t record;
+	memset(&record, 0, sizeof(record));
+	for (int i = 0; i < capacity / 2; i++)
+	{
+		record.timestamp = (uint32_t)i;
+		list_push_back(src, &record);
+	}
+
+	// 逐元素 pop_front + push_back
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+	{
+		list_handle_t from = (r & 1) ? dst : src;
+		list_handle_t to = (r & 1) ? src : dst;
+		for (int i = 0; i < batch; i++)
+		{
+			list_pop_front(from, &record);
+			list_push_back(to, &record);
+		}
+	}
+	uint64_t loop_ns = bench_now_ns() - start;
+
+	// list_splice_n 批量迁移
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+	{
+		list_handle_t from = (r & 1) ? dst : src;
+		list_handle_t to = (r & 1) ? src : dst;
+		list_iterator_t last = list_begin(from);
+		for (int i = 0; i < batch; i++)
+			last = list_next(last);
+		list_splice_n(to, NULL, from, list_begin(from), last, (uint16_t)batch);
+	}
+	uint64_t splice_ns = bench_now_ns() - start;
+
+	double mb = (double)rounds * batch * sizeof(bench_record_t) / (1024.0 * 1024.0);
+	bench_report("pop_front + push_back 逐元素", loop_ns, rounds * batch);
+	printf("  %-40s %10.1f MB/s\n", "", mb / (loop_ns / 1e9));
+	bench_report("list_splice_n 批量迁移", splice_ns, rounds * batch);
+	printf("  %-40s %10.1f MB/s\n", "", mb / (splice_ns / 1e9));
+
+	list_free(src);
+	list_free(dst);
+}
+
+// ========================= 环形缓冲 =========================
+typedef struct
+{
+	float temperature;
+	float humidity;
+	uint32_t timestamp;
+} bench_sample_t;
+
+static void bench_ring(void)
+{
+	const int capacity = 100;
+	const int samples = 1000000;
+
+	printf("[环形缓冲] 容量 %d 的已满列表中写入 %d 个采样\n", capacity, samples);
+
+	list_handle_t list = list_create(capacity, sizeof(bench_sample_t));
+	if (list == NULL)
+		return;
+
+	bench_sample_t sample = {25.5f, 60.0f, 0};
+	for (int i = 0; i < capacity; i++)
+		list_push_back(list, &sample);
+
+	// pop_front + push_back
+	uint64_t start = bench_now_ns();
+	for (int i = 0; i < samples; i++)
+	{
+		sample.timestamp = (uint32_t)i;
+		if (list_size(list) >= list_capacity(list))
+			list_pop_front(list, NULL);
+		list_push_back(list, &sample);
+	}
+	uint64_t loop_ns = bench_now_ns() - start;
+
+	// 环形模式
+	list_set_ring_mode(list, true);
+	start = bench_now_ns();
+	for (int i = 0; i < samples; i++)
+	{
+		sample.timestamp = (uint32_t)i;
+		list_push_back(list, &sample);
+	}
+	uint64_t ring_ns = bench_now_ns() - start;
+
+	bench_report("pop_front + push_back", loop_ns, samples);
+	bench_report("环形模式 list_push_back", ring_ns, samples);
+
+	list_free(list);
+}
+
+// ========================= 优先队列 =========================
+static uint32_t bench_rand_state = 12345;
+
+static uint32_t bench_rand(void)
+{
+	bench_rand_state = bench_rand_state * 1103515245u + 12345u;
+	return bench_rand_state >> 8;
+}
+
+static int bench_compare_u32(const void *a, const void *b)
+{
+	uint32_t va = *(const uint32_t *)a;
+	uint32_t vb = *(const uint32_t *)b;
+	return (va > vb) - (va < vb);
+}
+
+static bool bench_greater_u32(const void *list_data, const void *value)
+{
+	return *(const uint32_t *)list_data > *(const uint32_t *)value;
+}
+
+static void bench_pq(void)
+{
+	const int sizes[] = {1024, 4096, 16384, 65000};
+	const int ops = 2000;
+
+	printf("[优先队列] n 个定时器的队列上执行 %d 次 插入+弹出最小值\n", ops);
+
+	for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++)
+	{
+		int timers = sizes[n];
+		uint16_t capacity = (uint16_t)(timers + 1);
+
+		// 有序链表：list_find_if 查找插入点 + list_insert
+		list_handle_t sorted = list_create(capacity, sizeof(uint32_t));
+		list_pq_handle_t pq = list_pq_create(capacity, sizeof(uint32_t), bench_compare_u32);
+		if (sorted == NULL || pq == NULL)
+		{
+			if (sorted)
+				list_free(sorted);
+			if (pq)
+				list_pq_free(pq);
+			return;
+		}
+
+		for (int i = 0; i < timers; i++)
+		{
+			uint32_t deadline = (uint32_t)i * 1000;
+			list_push_back(sorted, &deadline);
+			list_pq_push(pq, &deadline);
+		}
+
+		bench_rand_state = 12345;
+		uint64_t start = bench_now_ns();
+		for (int i = 0; i < ops; i++)
+		{
+			uint32_t deadline = bench_rand() % ((uint32_t)timers * 1000);
+			list_insert(sorted, list_find_if(sorted, NULL, bench_greater_u32, &deadline), &deadline);
+			list_pop_front(sorted, NULL);
+		}
+		uint64_t sorted_ns = bench_now_ns() - start;
+
+		bench_rand_state = 12345;
+		start = bench_now_ns();
+		for (int i = 0; i < ops; i++)
+		{
+			uint32_t deadline = bench_rand() % ((uint32_t)timers * 1000);
+			list_pq_push(pq, &deadline);
+			list_pq_pop_min(pq, NULL);
+		}
+		uint64_t pq_ns = bench_now_ns() - start;
+
+		char name[64];
+		snprintf(name, sizeof(name), "有序链表    n=%d", timers);
+		bench_report(name, sorted_ns, ops);
+		snprintf(name, sizeof(name), "list_pq     n=%d", timers);
+		bench_report(name, pq_ns, ops);
+
+		list_free(sorted);
+		list_pq_free(pq);
+	}
+}
+
+// ========================= 哈希索引 =========================
+typedef struct
+{
+	uint32_t id;
+	uint32_t payload[3];
+} bench_session_t;
+
+static void bench_hash(void)
+{
+	const int sizes[] = {1000, 10000, 60000};
+	const int lookups = 1000;
+
+	printf("[哈希索引] 按会话键查找 %d 次\n", lookups);
+
+	for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++)
+	{
+		int count = sizes[n];
+		list_handle_t list = list_create((uint16_t)count, sizeof(bench_session_t));
+		if (list == NULL)
+			return;
+
+		bench_session_t session;
+		memset(&session, 0, sizeof(session));
+		for (int i = 0; i < count; i++)
+		{
+			session.id = (uint32_t)i * 2654435761u;
+			session.payload[0] = (uint32_t)i;
+			list_push_back(list, &session);
+		}
+
+		// 线性扫描
+		bench_rand_state = 777;
+		volatile uint32_t found = 0;
+		uint64_t start = bench_now_ns();
+		for (int i = 0; i < lookups; i++)
+		{
+			uint32_t k = bench_rand() % (uint32_t)count;
+			session.id = k * 2654435761u;
+			session.payload[0] = k;
+			found += list_find(list, &session) != NULL;
+		}
+		uint64_t scan_ns = bench_now_ns() - start;
+
+		// 哈希索引
+		list_hash_handle_t index = list_hash_create(list, offsetof(bench_session_t, id), sizeof(uint32_t));
+		if (index == NULL)
+		{
+			list_free(list);
+			return;
+		}
+		bench_rand_state = 777;
+		start = bench_now_ns();
+		for (int i = 0; i < lookups; i++)
+		{
+			uint32_t k = bench_rand() % (uint32_t)count;
+			session.id = k * 2654435761u;
+			session.payload[0] = k;
+			found += list_find(list, &session) != NULL;
+		}
+		uint64_t hash_ns = bench_now_ns() - start;
+
+		char name[64];
+		snprintf(name, sizeof(name), "list_find 线性扫描 n=%d", count);
+		bench_report(name, scan_ns, lookups);
+		snprintf(name, sizeof(name), "list_find 哈希索引 n=%d", count);
+		bench_report(name, hash_ns, lookups);
+		if (found != (uint32_t)lookups * 2)
+			printf("  查找结果错误: %u\n", (unsigned)found);
+
+		list_hash_free(index);
+		list_free(list);
+	}
+}
+
+// ========================= 有序索引 =========================
+typedef struct
+{
+	uint32_t low;
+	uint32_t high;
+	uint32_t hits;
+} bench_window_t;
+
+static int bench_compare_timestamp(const void *a, const void *b)
+{
+	uint32_t ta = ((const bench_record_t *)a)->timestamp;
+	uint32_t tb = ((const bench_record_t *)b)->timestamp;
+	return (ta > tb) - (ta < tb);
+}
+
+// 统计落在区间内的元素
+static void bench_count_window(list_iterator_t it, void *user_data)
+{
+	bench_window_t *window = (bench_window_t *)user_data;
+	uint32_t t = ((const bench_record_t *)it->data)->timestamp;
+	if (t >= window->low && t < window->high)
+		window->hits++;
+}
+
+static void bench_order(void)
+{
+	// size 为 uint16_t，元素数量上限为 65535
+	const int sizes[] = {10000, 30000, 60000};
+	const int queries = 200;
+	const uint32_t width = 100;
+
+	printf("[有序索引] 时间戳区间 [a, a+%u) 查询 %d 次\n", (unsigned)width, queries);
+
+	for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++)
+	{
+		int count = sizes[n];
+		list_handle_t list = list_create((uint16_t)count, sizeof(bench_record_t));
+		if (list == NULL)
+			return;
+
+		bench_record_t record;
+		memset(&record, 0, sizeof(record));
+		bench_rand_state = 4242;
+		for (int i = 0; i < count; i++)
+		{
+			record.timestamp = bench_rand() % (uint32_t)(count * 4);
+			list_push_back(list, &record);
+		}
+
+		// 线性扫描
+		bench_rand_state = 99;
+		uint32_t scan_hits = 0;
+		uint64_t start = bench_now_ns();
+		for (int i = 0; i < queries; i++)
+		{
+			bench_window_t window;
+			window.low = bench_rand() % (uint32_t)(count * 4);
+			window.high = window.low + width;
+			window.hits = 0;
+			list_for_each_if(list, bench_count_window, &window);
+			scan_hits += window.hits;
+		}
+		uint64_t scan_ns = bench_now_ns() - start;
+
+		// 有序索引
+		start = bench_now_ns();
+		list_order_handle_t index = list_order_create(list, bench_compare_timestamp);
+		uint64_t build_ns = bench_now_ns() - start;
+		if (index == NULL)
+		{
+			list_free(list);
+			return;
+		}
+
+		bench_rand_state = 99;
+		uint32_t index_hits = 0;
+		start = bench_now_ns();
+		for (int i = 0; i < queries; i++)
+		{
+			bench_record_t low;
+			bench_record_t high;
+			low.timestamp = bench_rand() % (uint32_t)(count * 4);
+			high.timestamp = low.timestamp + width;
+
+			list_order_range_t range;
+			list_order_range(index, &low, &high, &range);
+			while (list_order_range_next(&range) != NULL)
+				index_hits++;
+		}
+		uint64_t index_ns = bench_now_ns() - start;
+
+		char name[64];
+		snprintf(name, sizeof(name), "区间查询 线性扫描 n=%d", count);
+		bench_report(name, scan_ns, queries);
+		snprintf(name, sizeof(name), "区间查询 有序索引 n=%d", count);
+		bench_report(name, index_ns, queries);
+		snprintf(name, sizeof(name), "建立索引 n=%d", count);
+		bench_report(name, build_ns, (uint32_t)count);
+		if (scan_hits != index_hits)
+			printf("  查询结果不一致: %u / %u\n", (unsigned)scan_hits, (unsigned)index_hits);
+
+		list_order_free(index);
+		list_free(list);
+	}
+}
+
+// ========================= LRU缓存 =========================
+// 偏斜的键分布：小键值被访问得更频繁
+static uint32_t bench_skewed_key(uint32_t key_space)
+{
+	uint32_t limit = bench_rand() % key_space + 1;
+	limit = bench_rand() % limit + 1;
+	return bench_rand() % limit;
+}
+
+static void bench_lru(void)
+{
+	const int capacities[] = {256, 4096};
+	const int accesses = 200000;
+
+	printf("[LRU缓存] 偏斜分布访问 %d 次，键空间为容量的8倍\n", accesses);
+
+	for (size_t n = 0; n < sizeof(capacities) / sizeof(capacities[0]); n++)
+	{
+		int capacity = capacities[n];
+		uint32_t key_space = (uint32_t)capacity * 8;
+		bench_session_t session;
+		memset(&session, 0, sizeof(session));
+
+		// 通过公共接口实现：哈希查找 + list_erase + list_push_front，满时 list_pop_back
+		list_handle_t list = list_create((uint16_t)capacity, sizeof(bench_session_t));
+		list_hash_handle_t index = list_hash_create(list, offsetof(bench_session_t, id), sizeof(uint32_t));
+		if (list == NULL || index == NULL)
+		{
+			list_hash_free(index);
+			if (list)
+				list_free(list);
+			return;
+		}
+
+		bench_rand_state = 2024;
+		uint32_t manual_hits = 0;
+		uint64_t start = bench_now_ns();
+		for (int i = 0; i < accesses; i++)
+		{
+			session.id = bench_skewed_key(key_space);
+			list_iterator_t it = list_hash_find(index, &session.id);
+			if (it != NULL)
+			{
+				memcpy(&session, it->data, sizeof(session));
+				list_erase(list, it);
+				manual_hits++;
+			}
+			else if (list_size(list) >= list_capacity(list))
+			{
+				list_pop_back(list, NULL);
+			}
+			list_push_front(list, &session);
+		}
+		uint64_t manual_ns = bench_now_ns() - start;
+		list_hash_free(index);
+		list_free(list);
+
+		// list_lru_t
+		list_lru_handle_t lru = list_lru_create((uint16_t)capacity, sizeof(bench_session_t),
+		                                        offsetof(bench_session_t, id), sizeof(uint32_t));
+		if (lru == NULL)
+			return;
+
+		bench_rand_state = 2024;
+		start = bench_now_ns();
+		for (int i = 0; i < accesses; i++)
+		{
+			session.id = bench_skewed_key(key_space);
+			if (list_lru_get(lru, &session.id) == NULL)
+				list_lru_put(lru, &session);
+		}
+		uint64_t lru_ns = bench_now_ns() - start;
+
+		uint32_t hits = 0;
+		uint32_t misses = 0;
+		list_lru_stats(lru, &hits, &misses);
+
+		char name[64];
+		snprintf(name, sizeof(name), "公共接口 erase+push_front cap=%d", capacity);
+		bench_report(name, manual_ns, accesses);
+		snprintf(name, sizeof(name), "list_lru get/put cap=%d", capacity);
+		bench_report(name, lru_ns, accesses);
+		printf("  命中率: %.1f%%\n", 100.0 * hits / (hits + misses));
+		if (hits != manual_hits)
+			printf("  命中次数不一致: %u / %u\n", (unsigned)manual_hits, (unsigned)hits);
+
+		list_lru_free(lru);
+	}
+}
+
+// ========================= 预取遍历与无序遍历 =========================
+typedef struct
+{
+	uint32_t key;
+	uint32_t payload[15];
+} bench_wide_t;
+
+// 把列表顺序随机打乱，使逻辑相邻的节点分散在节点池各处
+static void bench_shuffle(list_handle_t list)
+{
+	uint16_t count = list_size(list);
+	list_iterator_t *nodes = (list_iterator_t *)malloc(count * sizeof(list_iterator_t));
+	if (nodes == NULL)
+		return;
+
+	uint16_t i = 0;
+	for (list_iterator_t it = list_begin(list); it != NULL; it = list_next(it))
+		nodes[i++] = it;
+
+	for (i = count; i > 1; i--)
+	{
+		uint16_t j = (uint16_t)(bench_rand() % i);
+		list_iterator_t temp = nodes[i - 1];
+		nodes[i - 1] = nodes[j];
+		nodes[j] = temp;
+	}
+
+	for (i = 0; i < count; i++)
+		list_move_to_back(list, nodes[i]);
+
+	free(nodes);
+}
+
+static void bench_sum_key(list_iterator_t it, void *user_data)
+{
+	*(uint64_t *)user_data += ((const bench_wide_t *)it->data)->key;
+}
+
+static bool bench_key_equals(const void *list_data, const void *predicate_data)
+{
+	return ((const bench_wide_t *)list_data)->key == *(const uint32_t *)predicate_data;
+}
+
+static void bench_traversal(void)
+{
+	// size 为 uint16_t，元素数量上限为 65535
+	const int count = 65535;
+	const int rounds = 20;
+
+	printf("[遍历] 打乱顺序的 %d 个 %zu 字节元素，遍历 %d 次（预取距离 %d）\n",
+	       count, sizeof(bench_wide_t), rounds, LIST_PREFETCH_DISTANCE);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	if (list == NULL)
+		return;
+
+	bench_wide_t element;
+	memset(&element, 0, sizeof(element));
+	for (int i = 0; i < count; i++)
+	{
+		element.key = (uint32_t)i;
+		list_push_back(list, &element);
+	}
+	bench_rand_state = 31337;
+	bench_shuffle(list);
+
+	// 逐个追踪 next 指针（不预取）
+	uint64_t plain_sum = 0;
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+	{
+		for (list_iterator_t it = list_begin(list); it != NULL; it = it->next)
+			bench_sum_key(it, &plain_sum);
+	}
+	uint64_t plain_ns = bench_now_ns() - start;
+
+	uint64_t prefetch_sum = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_if(list, bench_sum_key, &prefetch_sum);
+	uint64_t prefetch_ns = bench_now_ns() - start;
+
+	uint64_t unordered_sum = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_unordered(list, bench_sum_key, &unordered_sum);
+	uint64_t unordered_ns = bench_now_ns() - start;
+
+	// 查找不存在的键，需要遍历整个列表
+	uint32_t missing = (uint32_t)count;
+	volatile uintptr_t found = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		found += (uintptr_t)list_find_if(list, NULL, bench_key_equals, &missing);
+	uint64_t find_ns = bench_now_ns() - start;
+
+	uint32_t ops = (uint32_t)count * rounds;
+	bench_report("逐个追踪 next", plain_ns, ops);
+	bench_report("list_for_each_if（预取）", prefetch_ns, ops);
+	bench_report("list_for_each_unordered", unordered_ns, ops);
+	bench_report("list_find_if 未命中（预取）", find_ns, ops);
+	if (plain_sum != prefetch_sum || plain_sum != unordered_sum || found != 0)
+		printf("  遍历结果不一致\n");
+
+	list_free(list);
+}
+
+// ========================= 节点池整理 =========================
+static void bench_compact(void)
+{
+	const int count = 65535;
+	const int rounds = 20;
+	const uint16_t budget = 256;
+
+	printf("[节点池整理] 打乱顺序的 %d 个 %zu 字节元素，整理前后各遍历 %d 次\n",
+	       count, sizeof(bench_wide_t), rounds);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	if (list == NULL)
+		return;
+
+	bench_wide_t element;
+	memset(&element, 0, sizeof(element));
+	for (int i = 0; i < count; i++)
+	{
+		element.key = (uint32_t)i;
+		list_push_back(list, &element);
+	}
+	bench_rand_state = 4711;
+	bench_shuffle(list);
+	uint8_t before_frag = list_fragmentation(list);
+
+	uint64_t sum = 0;
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_if(list, bench_sum_key, &sum);
+	uint64_t before_ns = bench_now_ns() - start;
+
+	start = bench_now_ns();
+	list_compact(list);
+	uint64_t compact_ns = bench_now_ns() - start;
+
+	uint64_t sum_after = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_if(list, bench_sum_key, &sum_after);
+	uint64_t after_ns = bench_now_ns() - start;
+
+	// 增量整理：每步最多处理 budget 个位置
+	bench_shuffle(list);
+	list_compact_t state;
+	uint32_t steps = 0;
+	uint64_t max_step_ns = 0;
+	uint64_t incremental_ns = 0;
+	list_compact_begin(list, &state);
+	for (bool done = false; !done; steps++)
+	{
+		uint64_t step_start = bench_now_ns();
+		done = list_compact_step(&state, budget);
+		uint64_t step_ns = bench_now_ns() - step_start;
+		incremental_ns += step_ns;
+		if (step_ns > max_step_ns)
+			max_step_ns = step_ns;
+	}
+
+	uint32_t ops = (uint32_t)count * rounds;
+	printf("  碎片程度: 整理前 %u%%，整理后 %u%%\n", (unsigned)before_frag, (unsigned)list_fragmentation(list));
+	bench_report("整理前遍历", before_ns, ops);
+	bench_report("list_compact", compact_ns, (uint32_t)count);
+	bench_report("整理后遍历", after_ns, ops);
+	bench_report("list_compact_step 总计", incremental_ns, (uint32_t)count);
+	printf("  增量整理: %u 步，每步最多 %u 个位置，单步最长 %.3f ms\n",
+	       (unsigned)steps, (unsigned)budget, max_step_ns / 1e6);
+	if (sum != sum_after)
+		printf("  整理后遍历结果不一致\n");
+
+	list_free(list);
+}
+
+// ========================= 活动槽位位图扫描 =========================
+static bool bench_key_odd(const void *list_data, const void *predicate_data)
+{
+	(void)predicate_data;
+	return (((const bench_wide_t *)list_data)->key & 1u) != 0;
+}
+
+static void bench_scan_pool(void)
+{
+	const int count = 65535;
+	const int rounds = 20;
+
+	printf("[位图扫描] 打乱顺序、删除一半后的 %d 个槽位，遍历 %d 次\n", count, rounds);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	if (list == NULL)
+		return;
+
+	bench_wide_t element;
+	memset(&element, 0, sizeof(element));
+	for (int i = 0; i < count; i++)
+	{
+		element.key = (uint32_t)i;
+		list_push_back(list, &element);
+	}
+	bench_rand_state = 8086;
+	bench_shuffle(list);
+	list_remove_if(list, bench_key_odd, NULL);
+	list_enable_live_map(list, NULL);
+	uint32_t ops = (uint32_t)list_size(list) * rounds;
+
+	uint64_t ordered_sum = 0;
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_if(list, bench_sum_key, &ordered_sum);
+	uint64_t ordered_ns = bench_now_ns() - start;
+
+	uint64_t scan_sum = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_scan_pool(list, bench_sum_key, &scan_sum);
+	uint64_t scan_ns = bench_now_ns() - start;
+
+	// 不存在的元素：顺序扫描节点池 vs 追踪 next 指针
+	element.key = (uint32_t)count + 1;
+	volatile uint32_t found = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		found += list_contains(list, &element);
+	uint64_t contains_scan_ns = bench_now_ns() - start;
+
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		found += list_find_if(list, NULL, NULL, &element) != NULL;
+	uint64_t contains_chase_ns = bench_now_ns() - start;
+
+	list_disable_live_map(list);
+	uint64_t mark_sum = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_unordered(list, bench_sum_key, &mark_sum);
+	uint64_t mark_ns = bench_now_ns() - start;
+
+	bench_report("list_for_each_if（追踪 next）", ordered_ns, ops);
+	bench_report("list_scan_pool（位图）", scan_ns, ops);
+	bench_report("list_for_each_unordered（标记空闲）", mark_ns, ops);
+	bench_report("list_contains 未命中（位图）", contains_scan_ns, ops);
+	bench_report("list_find_if 未命中（追踪 next）", contains_chase_ns, ops);
+	if (ordered_sum != scan_sum || ordered_sum != mark_sum || found != 0)
+		printf("  扫描结果不一致\n");
+
+	list_free(list);
+}
+
+// ========================= 并行遍历 =========================
+// 计算量较大的回调：对元素做多轮校验和并写回
+static void bench_checksum(list_iterator_t it, void *user_data)
+{
+	(void)user_data;
+	bench_wide_t *element = (bench_wide_t *)it->data;
+	uint32_t hash = element->key;
+	for (int round = 0; round < 16; round++)
+	{
+		for (int i = 0; i < 15; i++)
+			hash = (hash ^ element->payload[i]) * 16777619u;
+	}
+	element->payload[0] = hash;
+}
+
+static bool bench_checksum_odd(const void *list_data, const void *predicate_data)
+{
+	(void)predicate_data;
+	return (((const bench_wide_t *)list_data)->payload[0] & 1u) != 0;
+}
+
+static void bench_parallel(void)
+{
+	const int count = 60000;
+	const uint8_t thread_counts[] = {1, 2, 4, 8};
+
+	printf("[并行遍历] %d 个元素，每个元素 %d 次乘法的校验和\n", count, 16 * 15);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	if (list == NULL)
+		return;
+
+	bench_wide_t element;
+	memset(&element, 0, sizeof(element));
+	for (int i = 0; i < count; i++)
+	{
+		element.key = (uint32_t)i;
+		list_push_back(list, &element);
+	}
+
+	uint64_t base_ns = 0;
+	for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++)
+	{
+		list_workers_handle_t workers = list_workers_create(thread_counts[t]);
+		if (workers == NULL)
+			break;
+
+		uint64_t start = bench_now_ns();
+		list_parallel_for_each(workers, list, bench_checksum, NULL);
+		uint64_t for_each_ns = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		volatile uint16_t odd = list_parallel_count_if(workers, list, bench_checksum_odd, NULL);
+		uint64_t count_ns = bench_now_ns() - start;
+		(void)odd;
+
+		if (t == 0)
+			base_ns = for_each_ns;
+
+		char name[64];
+		snprintf(name, sizeof(name), "list_parallel_for_each %u 线程", (unsigned)thread_counts[t]);
+		bench_report(name, for_each_ns, (uint32_t)count);
+		snprintf(name, sizeof(name), "list_parallel_count_if %u 线程", (unsigned)thread_counts[t]);
+		bench_report(name, count_ns, (uint32_t)count);
+		printf("  for_each 加速比: %.2f\n", for_each_ns ? (double)base_ns / for_each_ns : 0.0);
+
+		list_workers_free(workers);
+	}
+
+	list_free(list);
+}
+
+// ========================= 内联批量算法 =========================
+static void bench_sum_payload(list_iterator_t it, void *user_data)
+{
+	const bench_wide_t *element = (const bench_wide_t *)it->data;
+	uint32_t sum = 0;
+	for (int i = 0; i < 15; i++)
+		sum += element->payload[i];
+	*(uint64_t *)user_data += sum;
+}
+
+static void bench_count_key_odd(list_iterator_t it, void *user_data)
+{
+	*(uint32_t *)user_data += ((const bench_wide_t *)it->data)->key & 1u;
+}
+
+typedef struct
+{
+	uint32_t min;
+	uint32_t max;
+} bench_range_t;
+
+static void bench_min_max_key(list_iterator_t it, void *user_data)
+{
+	bench_range_t *range = (bench_range_t *)user_data;
+	uint32_t key = ((const bench_wide_t *)it->data)->key;
+	if (key < range->min)
+		range->min = key;
+	if (key > range->max)
+		range->max = key;
+}
+
+static void bench_scale_u32(list_iterator_t it, void *user_data)
+{
+	(void)user_data;
+	uint32_t *value = (uint32_t *)it->data;
+	*value = *value * 3u + 1u;
+}
+
+static void bench_algorithms(void)
+{
+	const int count = 65535;
+	const int rounds = 20;
+
+	printf("[批量算法] %d 个 %zu 字节元素，回调与内联宏对比，各 %d 次\n", count, sizeof(bench_wide_t), rounds);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	if (list == NULL)
+		return;
+
+	bench_wide_t element;
+	for (int i = 0; i < count; i++)
+	{
+		element.key = (uint32_t)i * 2654435761u;
+		for (int j = 0; j < 15; j++)
+			element.payload[j] = (uint32_t)(i + j);
+		list_push_back(list, &element);
+	}
+
+	uint32_t ops = (uint32_t)count * rounds;
+	uint64_t callback_sum = 0, macro_sum = 0;
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_if(list, bench_sum_payload, &callback_sum);
+	bench_report("累加 payload：list_for_each_if", bench_now_ns() - start, ops);
+
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+	{
+		LIST_ACCUMULATE(list, bench_wide_t, e, macro_sum,
+		                (uint64_t)e.payload[0] + e.payload[1] + e.payload[2] + e.payload[3] + e.payload[4] +
+		                    e.payload[5] + e.payload[6] + e.payload[7] + e.payload[8] + e.payload[9] +
+		                    e.payload[10] + e.payload[11] + e.payload[12] + e.payload[13] + e.payload[14]);
+	}
+	bench_report("累加 payload：LIST_ACCUMULATE", bench_now_ns() - start, ops);
+
+	uint32_t callback_odd = 0, macro_odd = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_if(list, bench_count_key_odd, &callback_odd);
+	bench_report("条件计数：list_for_each_if", bench_now_ns() - start, ops);
+
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		LIST_COUNT_IF(list, bench_wide_t, e, macro_odd, (e.key & 1u) != 0);
+	bench_report("条件计数：LIST_COUNT_IF", bench_now_ns() - start, ops);
+
+	bench_range_t range = {UINT32_MAX, 0};
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_if(list, bench_min_max_key, &range);
+	bench_report("最小最大值：list_for_each_if", bench_now_ns() - start, ops);
+
+	list_iterator_t min_it = NULL, max_it = NULL;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		LIST_MIN_MAX(list, bench_wide_t, a, b, min_it, max_it, a.key < b.key);
+	bench_report("最小最大值：LIST_MIN_MAX", bench_now_ns() - start, ops);
+
+	if (callback_sum != macro_sum || callback_odd != macro_odd || min_it == NULL ||
+	    ((bench_wide_t *)min_it->data)->key != range.min || ((bench_wide_t *)max_it->data)->key != range.max)
+		printf("  批量算法结果不一致\n");
+
+	list_free(list);
+
+	// 原地变换按值传递整个元素，用4字节元素对比
+	list = list_create((uint16_t)count, sizeof(uint32_t));
+	if (list == NULL)
+		return;
+	bench_fill(list, count);
+
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_for_each_if(list, bench_scale_u32, NULL);
+	bench_report("原地变换（4字节）：list_for_each_if", bench_now_ns() - start, ops);
+
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		LIST_TRANSFORM_INPLACE(list, uint32_t, x, x * 3u + 1u);
+	bench_report("原地变换（4字节）：LIST_TRANSFORM_INPLACE", bench_now_ns() - start, ops);
+
+	list_free(list);
+}
+
+// ========================= 稳定划分与第n小元素 =========================
+static bool bench_below_threshold(const void *list_data, const void *predicate_data)
+{
+	return *(const uint32_t *)list_data < *(const uint32_t *)predicate_data;
+}
+
+static void bench_fill_random(list_handle_t list, int count)
+{
+	bench_rand_state = 4242;
+	for (int i = 0; i < count; i++)
+	{
+		uint32_t value = bench_rand();
+		list_push_back(list, &value);
+	}
+}
+
+static void bench_partition_select(void)
+{
+	// size 为 uint16_t，元素数量上限为 65535
+	const int count = 65535;
+	const int rounds = 10;
+	uint32_t threshold = 1u << 23;
+
+	printf("[划分与选择] %d 个随机 uint32_t，各 %d 次\n", count, rounds);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(uint32_t));
+	list_handle_t fail = list_create((uint16_t)count, sizeof(uint32_t));
+	uint32_t *values = (uint32_t *)malloc(count * sizeof(uint32_t));
+	if (list == NULL || fail == NULL || values == NULL)
+	{
+		list_free(list);
+		list_free(fail);
+		free(values);
+		return;
+	}
+
+	// 原来的做法：把不满足的元素复制到临时列表并删除，再接回尾部
+	uint64_t copy_ns = 0;
+	for (int r = 0; r < rounds; r++)
+	{
+		list_clear(list);
+		bench_fill_random(list, count);
+		uint64_t start = bench_now_ns();
+		for (list_iterator_t it = list_begin(list); it != NULL; it = list_next(it))
+		{
+			if (!bench_below_threshold(it->data, &threshold))
+				list_push_back(fail, it->data);
+		}
+		list_remove_if(list, bench_greater_u32, &(uint32_t){threshold - 1});
+		while (list_pop_front(fail, &values[0]))
+			list_push_back(list, &values[0]);
+		copy_ns += bench_now_ns() - start;
+	}
+
+	uint64_t partition_ns = 0;
+	for (int r = 0; r < rounds; r++)
+	{
+		list_clear(list);
+		bench_fill_random(list, count);
+		uint64_t start = bench_now_ns();
+		list_partition(list, bench_below_threshold, &threshold);
+		partition_ns += bench_now_ns() - start;
+	}
+
+	// 中位数：复制出来排序 vs 链表上快速选择
+	uint16_t median = (uint16_t)(count / 2);
+	uint32_t sorted_median = 0;
+	uint64_t sort_ns = 0;
+	for (int r = 0; r < rounds; r++)
+	{
+		list_clear(list);
+		bench_fill_random(list, count);
+		uint64_t start = bench_now_ns();
+		int i = 0;
+		for (list_iterator_t it = list_begin(list); it != NULL; it = list_next(it))
+			values[i++] = *(uint32_t *)it->data;
+		qsort(values, (size_t)count, sizeof(uint32_t), bench_compare_u32);
+		sorted_median = values[median];
+		sort_ns += bench_now_ns() - start;
+	}
+
+	uint32_t select_median = 0;
+	uint64_t select_ns = 0;
+	for (int r = 0; r < rounds; r++)
+	{
+		list_clear(list);
+		bench_fill_random(list, count);
+		uint64_t start = bench_now_ns();
+		list_iterator_t nth = list_nth_element(list, median, bench_compare_u32);
+		select_median = *(uint32_t *)nth->data;
+		select_ns += bench_now_ns() - start;
+	}
+
+	uint32_t ops = (uint32_t)count * rounds;
+	bench_report("复制到临时列表再删除", copy_ns, ops);
+	bench_report("list_partition", partition_ns, ops);
+	bench_report("复制出来 qsort 取中位数", sort_ns, ops);
+	bench_report("list_nth_element 取中位数", select_ns, ops);
+	if (sorted_median != select_median)
+		printf("  中位数不一致\n");
+
+	free(values);
+	list_free(fail);
+	list_free(list);
+}
+
+// ========================= 节点池映像 =========================
+static void bench_image(void)
+{
+	const int count = 65535;
+	const int rounds = 10;
+
+	printf("[映像] %d 个 %zu 字节元素，启动 %d 次\n", count, sizeof(bench_wide_t), rounds);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	list_handle_t restored = list_create((uint16_t)count, sizeof(bench_wide_t));
+	if (list == NULL || restored == NULL)
+	{
+		list_free(list);
+		list_free(restored);
+		return;
+	}
+
+	bench_wide_t element;
+	memset(&element, 0, sizeof(element));
+	for (int i = 0; i < count; i++)
+	{
+		element.key = (uint32_t)i;
+		list_push_back(list, &element);
+	}
+
+	uint32_t serialize_size = list_get_serialize_size(list);
+	uint32_t image_size = list_image_size(list);
+	uint8_t *snapshot = (uint8_t *)malloc(serialize_size);
+	uint8_t *image_buf = (uint8_t *)malloc(image_size);
+	if (snapshot == NULL || image_buf == NULL || list_serialize(list, snapshot, serialize_size) == 0 ||
+	    list_image_write(list, image_buf, image_size) != image_size)
+	{
+		free(snapshot);
+		free(image_buf);
+		list_free(list);
+		list_free(restored);
+		return;
+	}
+
+	// 启动：反序列化 vs 打开映像，之后都读取第一个元素
+	uint32_t first_key = 0;
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+	{
+		list_deserialize(restored, snapshot, serialize_size);
+		first_key += ((const bench_wide_t *)list_begin(restored)->data)->key;
+	}
+	uint64_t deserialize_ns = bench_now_ns() - start;
+
+	list_image_t image;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+	{
+		list_image_open(&image, image_buf, image_size);
+		first_key += ((const bench_wide_t *)list_image_data(&image, list_image_begin(&image)))->key;
+	}
+	uint64_t open_ns = bench_now_ns() - start;
+
+	// 只读遍历：恢复后的链表 vs 直接遍历映像
+	uint64_t list_sum = 0;
+	start = bench_now_ns();
+	for (list_iterator_t it = list_begin(restored); it != NULL; it = it->next)
+		list_sum += ((const bench_wide_t *)it->data)->key;
+	uint64_t list_ns = bench_now_ns() - start;
+
+	uint64_t image_sum = 0;
+	start = bench_now_ns();
+	for (uint16_t slot = list_image_begin(&image); slot != LIST_INVALID_SLOT; slot = list_image_next(&image, slot))
+		image_sum += ((const bench_wide_t *)list_image_data(&image, slot))->key;
+	uint64_t image_ns = bench_now_ns() - start;
+
+	printf("  快照 %u 字节，映像 %u 字节\n", (unsigned)serialize_size, (unsigned)image_size);
+	bench_report("启动：list_deserialize", deserialize_ns / rounds, 1);
+	bench_report("启动：list_image_open", open_ns / rounds, 1);
+	bench_report("遍历恢复后的链表", list_ns, (uint32_t)count);
+	bench_report("遍历映像", image_ns, (uint32_t)count);
+	if (list_sum != image_sum || first_key != 0)
+		printf("  映像结果不一致\n");
+
+	free(image_buf);
+	free(snapshot);
+	list_free(restored);
+	list_free(list);
+}
+
+// ========================= 增量序列化 =========================
+typedef struct
+{
+	uint32_t id;
+	uint32_t timestamp;
+	int32_t value;
+	uint32_t flags;
+} bench_reading_t;
+
+static void bench_delta(void)
+{
+	const int count = 60000;
+	const int checkpoints = 20;
+	const int updates = count / 100;  // 每个检查点周期更新1%的元素
+	const int churn = count / 500;    // 并删除、新增0.2%的元素
+
+	printf("[增量序列化] %d 个 %zu 字节记录，每周期更新 %d 个、替换 %d 个，%d 个检查点\n",
+	       count, sizeof(bench_reading_t), updates, churn, checkpoints);
+
+	list_handle_t list = list_create((uint16_t)(count + churn), sizeof(bench_reading_t));
+	uint32_t buffer_size = sizeof(list_delta_header_t) +
+	                       (uint32_t)(count + churn) * (sizeof(list_delta_record_t) + sizeof(bench_reading_t));
+	uint8_t *buffer = (uint8_t *)malloc(buffer_size);
+	if (list == NULL || buffer == NULL)
+	{
+		list_free(list);
+		free(buffer);
+		return;
+	}
+
+	bench_reading_t record = {0, 0, 0, 0};
+	for (int i = 0; i < count; i++)
+	{
+		record.id = (uint32_t)i;
+		list_push_back(list, &record);
+	}
+
+	// 初始完整快照之后开始跟踪
+	list_delta_handle_t delta = list_delta_create(list);
+	if (delta == NULL)
+	{
+		list_free(list);
+		free(buffer);
+		return;
+	}
+
+	bench_rand_state = 2024;
+	uint64_t full_bytes = 0, delta_bytes = 0;
+	uint64_t full_ns = 0, delta_ns = 0;
+	uint32_t since = 0;
+	for (int c = 0; c < checkpoints; c++)
+	{
+		for (int i = 0; i < updates; i++)
+		{
+			list_iterator_t it = list_at(list, (int16_t)(bench_rand() % list_size(list)));
+			record = *(bench_reading_t *)it->data;
+			record.timestamp = (uint32_t)c;
+			record.value = (int32_t)bench_rand();
+			list_replace(list, it, &record);
+		}
+		for (int i = 0; i < churn; i++)
+		{
+			list_erase(list, list_at(list, (int16_t)(bench_rand() % list_size(list))));
+			record.id = (uint32_t)(count + c * churn + i);
+			list_push_back(list, &record);
+		}
+
+		uint64_t start = bench_now_ns();
+		uint32_t written = list_serialize(list, buffer, buffer_size);
+		full_ns += bench_now_ns() - start;
+		full_bytes += written;
+
+		start = bench_now_ns();
+		written = list_serialize_delta(delta, buffer, buffer_size, since);
+		delta_ns += bench_now_ns() - start;
+		delta_bytes += written;
+		since = ((list_delta_header_t *)buffer)->epoch;
+	}
+
+	printf("  每个检查点：完整快照 %llu 字节，增量 %llu 字节（%.1f%%）\n",
+	       (unsigned long long)(full_bytes / checkpoints), (unsigned long long)(delta_bytes / checkpoints),
+	       full_bytes ? 100.0 * delta_bytes / full_bytes : 0.0);
+	bench_report("list_serialize（每个检查点）", full_ns / checkpoints, 1);
+	bench_report("list_serialize_delta（每个检查点）", delta_ns / checkpoints, 1);
+
+	list_delta_free(delta);
+	list_free(list);
+	free(buffer);
+}
+
+static bool bench_journal_write(const void *data, uint32_t size, void *ctx)
+{
+	return fwrite(data, 1, size, (FILE *)ctx) == size;
+}
+
+static bool bench_journal_sync(void *ctx)
+{
+	FILE *file = (FILE *)ctx;
+	if (fflush(file) != 0)
+		return false;
+#ifndef _WIN32
+	return fsync(fileno(file)) == 0;
+#else
+	return true;
+#endif
+}
+
+// 记录 ops 次插入/替换/删除的平均耗时，config 为NULL时不记录日志
+static uint64_t bench_journal_run(list_handle_t list, int ops, uint32_t buffer_size, const list_journal_config_t *config)
+{
+	list_journal_handle_t journal = NULL;
+	if (buffer_size != 0)
+	{
+		journal = list_journal_create(list, buffer_size, config);
+		if (journal == NULL)
+			return 0;
+	}
+
+	bench_reading_t record = {0, 0, 0, 0};
+	uint64_t start = bench_now_ns();
+	for (int i = 0; i < ops; i++)
+	{
+		record.id = (uint32_t)i;
+		record.value = (int32_t)bench_rand();
+		list_push_back(list, &record);
+		list_replace(list, list_begin(list), &record);
+		list_pop_front(list, NULL);
+		// 只用缓冲区时由调用者定期取走日志
+		if (journal != NULL && config == NULL && journal->used + 256 > journal->buffer_size)
+			list_journal_clear(journal);
+	}
+	uint64_t elapsed = bench_now_ns() - start;
+
+	list_journal_free(journal);
+	return elapsed;
+}
+
+static void bench_journal(void)
+{
+	const int count = 1000;
+	const int ops = 50000;
+
+	printf("[变更日志] %d 个 %zu 字节记录，%d 次（插入、替换、删除）\n", count, sizeof(bench_reading_t), ops);
+
+	list_handle_t list = list_create((uint16_t)(count + 1), sizeof(bench_reading_t));
+	FILE *file = tmpfile();
+	if (list == NULL || file == NULL)
+	{
+		list_free(list);
+		if (file)
+			fclose(file);
+		return;
+	}
+
+	bench_reading_t record = {0, 0, 0, 0};
+	for (int i = 0; i < count; i++)
+	{
+		record.id = (uint32_t)i;
+		list_push_back(list, &record);
+	}
+
+	bench_rand_state = 99;
+	bench_report("不记录日志", bench_journal_run(list, ops, 0, NULL), (uint32_t)ops);
+	bench_report("日志只写缓冲区", bench_journal_run(list, ops, 64 * 1024, NULL), (uint32_t)ops);
+
+	list_journal_config_t config = {bench_journal_write, NULL, file, 64};
+	bench_report("写入文件（每64条提交）", bench_journal_run(list, ops, 64 * 1024, &config), (uint32_t)ops);
+
+	// 同步开销远大于写入，减少次数
+	const int sync_ops = ops / 50;
+	config.sync = bench_journal_sync;
+	config.group_records = 1;
+	bench_report("写入并同步（每条提交）", bench_journal_run(list, sync_ops, 4096, &config), (uint32_t)sync_ops);
+	config.group_records = 64;
+	bench_report("写入并同步（每64条提交）", bench_journal_run(list, sync_ops, 64 * 1024, &config), (uint32_t)sync_ops);
+
+	fclose(file);
+	list_free(list);
+}
+
+static void bench_packed(void)
+{
+	const int count = 60000;
+	const int rounds = 10;
+
+	printf("[压缩序列化] %d 个 %zu 字节缓慢变化的记录，%d 轮\n", count, sizeof(bench_reading_t), rounds);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_reading_t));
+	list_handle_t restored = list_create((uint16_t)count, sizeof(bench_reading_t));
+	uint32_t buffer_size = 0;
+	uint8_t *buffer = NULL;
+	if (list != NULL && restored != NULL)
+	{
+		bench_rand_state = 7;
+		bench_reading_t record = {0, 0, 2000, 0};
+		for (int i = 0; i < count; i++)
+		{
+			record.id = (uint32_t)i;
+			record.timestamp = (uint32_t)i * 10;
+			if (bench_rand() % 8 == 0)
+				record.value += (int32_t)(bench_rand() % 3) - 1;  // 偶尔变化的读数
+			list_push_back(list, &record);
+		}
+		buffer_size = list_get_pack_bound(list, LIST_PACK_INDEX_DELTA, &list_pack_lz);
+		buffer = (uint8_t *)malloc(buffer_size);
+	}
+	if (buffer == NULL)
+	{
+		list_free(list);
+		list_free(restored);
+		return;
+	}
+
+	uint32_t plain = list_serialize(list, buffer, buffer_size);
+	double mb = (double)plain * rounds / (1024.0 * 1024.0);
+	printf("  %-30s %9u 字节\n", "list_serialize", plain);
+
+	static const struct
+	{
+		const char *name;
+		uint16_t flags;
+		bool lz;
+	} variants[] = {
+		{"索引差值", LIST_PACK_INDEX_DELTA, false},
+		{"索引差值 + 异或", LIST_PACK_INDEX_DELTA | LIST_PACK_XOR_DELTA, false},
+		{"LZ", 0, true},
+		{"索引差值 + LZ", LIST_PACK_INDEX_DELTA, true},
+		{"索引差值 + 异或 + LZ", LIST_PACK_INDEX_DELTA | LIST_PACK_XOR_DELTA, true},
+	};
+	for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++)
+	{
+		const list_pack_codec_t *codec = variants[v].lz ? &list_pack_lz : NULL;
+		uint32_t size = 0;
+		uint64_t start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			size = list_serialize_packed(list, buffer, buffer_size, variants[v].flags, codec);
+		uint64_t encode_ns = bench_now_ns() - start;
+
+		bool ok = true;
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			ok = list_deserialize_packed(restored, buffer, size, codec) && ok;
+		uint64_t decode_ns = bench_now_ns() - start;
+
+		printf("  %-30s %9u 字节（节省 %5.1f%%）  编码 %7.1f MB/s  解码 %7.1f MB/s%s\n", variants[v].name, size,
+		       plain ? 100.0 - 100.0 * size / plain : 0.0, mb * 1e9 / (double)encode_ns, mb * 1e9 / (double)decode_ns,
+		       ok && list_size(restored) == count ? "" : "（失败）");
+	}
+
+	free(buffer);
+	list_free(list);
+	list_free(restored);
+}
+
+// 比较保留槽位的 list_serialize 与只保存顺序的压缩格式（不压缩）
+static void bench_order_only_size(uint16_t element_size, int count, int rounds)
+{
+	list_handle_t list = list_create((uint16_t)count, element_size);
+	list_handle_t restored = list_create((uint16_t)count, element_size);
+	uint32_t buffer_size = list != NULL ? (uint32_t)sizeof(list_persist_header_t) +
+	                                          (uint32_t)count * (sizeof(uint16_t) + element_size) + 64
+	                                    : 0;
+	uint8_t *buffer = (uint8_t *)malloc(buffer_size > 0 ? buffer_size : 1);
+	if (list == NULL || restored == NULL || buffer == NULL)
+	{
+		list_free(list);
+		list_free(restored);
+		free(buffer);
+		return;
+	}
+
+	uint32_t value = 0;
+	for (int i = 0; i < count; i++)
+	{
+		value = bench_rand();
+		list_push_back(list, &value);
+	}
+
+	char name[64];
+	uint32_t size = 0;
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		size = list_serialize(list, buffer, buffer_size);
+	uint64_t elapsed = bench_now_ns() - start;
+	snprintf(name, sizeof(name), "list_serialize（%u 字节元素）", element_size);
+	bench_report(name, elapsed / rounds, (uint32_t)count);
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_deserialize(restored, buffer, size);
+	elapsed = bench_now_ns() - start;
+	snprintf(name, sizeof(name), "list_deserialize（%u 字节元素）", element_size);
+	bench_report(name, elapsed / rounds, (uint32_t)count);
+
+	uint32_t order_size = 0;
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		order_size = list_serialize_packed(list, buffer, buffer_size, LIST_PACK_ORDER_ONLY, NULL);
+	elapsed = bench_now_ns() - start;
+	snprintf(name, sizeof(name), "只保存顺序 序列化（%u 字节元素）", element_size);
+	bench_report(name, elapsed / rounds, (uint32_t)count);
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_deserialize_packed(restored, buffer, order_size, NULL);
+	elapsed = bench_now_ns() - start;
+	snprintf(name, sizeof(name), "只保存顺序 反序列化（%u 字节元素）", element_size);
+	bench_report(name, elapsed / rounds, (uint32_t)count);
+	printf("  %u 字节元素快照：保留槽位 %u 字节，只保存顺序 %u 字节（%.1f%%）\n", element_size, size, order_size,
+	       size ? 100.0 * order_size / size : 0.0);
+
+	list_free(list);
+	list_free(restored);
+	free(buffer);
+}
+
+static void bench_order_only(void)
+{
+	const int count = 60000;
+	printf("[只保存顺序的快照] %d 个元素\n", count);
+	bench_rand_state = 11;
+	bench_order_only_size(2, count, 20);
+	bench_order_only_size(4, count, 20);
+}
+
+static void bench_crc(void)
+{
+	static const int counts[] = {64, 1024, 16384, 65535};
+
+	printf("[CRC32C 校验] %zu 字节记录，硬件指令：%s\n", sizeof(bench_reading_t),
+	       list_crc32c_accelerated() ? "是" : "否");
+
+	for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+	{
+		int count = counts[c];
+		int rounds = 8000000 / count;
+		list_handle_t list = list_create((uint16_t)count, sizeof(bench_reading_t));
+		list_handle_t restored = list_create((uint16_t)count, sizeof(bench_reading_t));
+		uint32_t buffer_size = list != NULL ? list_get_pack_bound(list, 0, NULL) +
+		                                          (uint32_t)count * (sizeof(uint16_t) + sizeof(bench_reading_t))
+		                                    : 0;
+		uint8_t *buffer = (uint8_t *)malloc(buffer_size > 0 ? buffer_size : 1);
+		if (list == NULL || restored == NULL || buffer == NULL)
+		{
+			list_free(list);
+			list_free(restored);
+			free(buffer);
+			return;
+		}
+
+		bench_reading_t record = {0, 0, 0, 0};
+		for (int i = 0; i < count; i++)
+		{
+			record.id = (uint32_t)i;
+			record.value = (int32_t)bench_rand();
+			list_push_back(list, &record);
+		}
+
+		// 同一份数据分别按版本2（带 CRC32C）和版本1（不带校验）读取
+		uint32_t checked = list_serialize_packed(list, buffer, buffer_size, 0, NULL);
+		list_deserialize_packed(restored, buffer, checked, NULL);  // 预热
+		uint64_t start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			list_deserialize_packed(restored, buffer, checked, NULL);
+		uint64_t checked_ns = (bench_now_ns() - start) / rounds;
+
+		list_store_le16(buffer + offsetof(list_pack_header_t, version), 1);
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			list_deserialize_packed(restored, buffer, checked - LIST_PACK_CRC_SIZE, NULL);
+		uint64_t plain_ns = (bench_now_ns() - start) / rounds;
+
+		volatile uint32_t sink = 0;
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			sink ^= list_crc32c(0, buffer, checked);
+		uint64_t hw_ns = (bench_now_ns() - start) / rounds;
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			sink ^= list_crc32c_table_only(0, buffer, checked);
+		uint64_t table_ns = (bench_now_ns() - start) / rounds;
+		(void)sink;
+
+		printf("  %5d 个元素（%7u 字节）：不校验 %8.2f us，校验 %8.2f us（%+.1f%%）；"
+		       "CRC %6.0f MB/s，查表 %6.0f MB/s\n",
+		       count, checked, plain_ns / 1000.0, checked_ns / 1000.0,
+		       plain_ns ? 100.0 * ((double)checked_ns - (double)plain_ns) / (double)plain_ns : 0.0,
+		       hw_ns ? checked * 1000.0 / (double)hw_ns : 0.0, table_ns ? checked * 1000.0 / (double)table_ns : 0.0);
+
+		// list_serialize 的数据分别带校验头部和去掉校验头部（旧格式）读取
+		uint32_t saved = list_serialize(list, buffer, buffer_size);
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			list_deserialize(restored, buffer, saved);
+		checked_ns = (bench_now_ns() - start) / rounds;
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			list_deserialize(restored, buffer + sizeof(list_save_header_t), saved - sizeof(list_save_header_t));
+		plain_ns = (bench_now_ns() - start) / rounds;
+		printf("  %5d 个元素（%7u 字节）：list_deserialize 旧格式 %8.2f us，校验头部 %8.2f us（%+.1f%%）\n",
+		       count, saved, plain_ns / 1000.0, checked_ns / 1000.0,
+		       plain_ns ? 100.0 * ((double)checked_ns - (double)plain_ns) / (double)plain_ns : 0.0);
+
+		list_free(list);
+		list_free(restored);
+		free(buffer);
+	}
+}
+
+static void bench_portable(void)
+{
+	static const int counts[] = {1024, 65535};
+
+	printf("[固定字节序格式] %zu 字节记录，头部和索引按小端字节序读写\n", sizeof(bench_reading_t));
+
+	for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+	{
+		int count = counts[c];
+		int rounds = 4000000 / count;
+		list_handle_t list = list_create((uint16_t)count, sizeof(bench_reading_t));
+		list_handle_t restored = list_create((uint16_t)count, sizeof(bench_reading_t));
+		bench_reading_t record = {0, 0, 0, 0};
+		for (int i = 0; list != NULL && i < count; i++)
+		{
+			record.id = (uint32_t)i;
+			record.value = (int32_t)bench_rand();
+			list_push_back(list, &record);
+		}
+
+		uint32_t buffer_size = list != NULL ? list_get_serialize_size(list) : 0;
+		if (list != NULL && list_image_size(list) > buffer_size)
+			buffer_size = list_image_size(list);
+		uint8_t *buffer = (uint8_t *)malloc(buffer_size > 0 ? buffer_size : 1);
+		if (list == NULL || restored == NULL || buffer == NULL)
+		{
+			list_free(list);
+			list_free(restored);
+			free(buffer);
+			return;
+		}
+
+		uint32_t size = list_serialize(list, buffer, buffer_size);
+		uint64_t start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			list_serialize(list, buffer, buffer_size);
+		uint64_t save_ns = (bench_now_ns() - start) / rounds;
+
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			list_deserialize(restored, buffer, size);
+		uint64_t load_ns = (bench_now_ns() - start) / rounds;
+
+		uint32_t image_size = list_image_write(list, buffer, buffer_size);
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			list_image_write(list, buffer, buffer_size);
+		uint64_t image_ns = (bench_now_ns() - start) / rounds;
+
+		// 映像按链表顺序遍历，每一步都要解码 next
+		volatile uint32_t sink = 0;
+		list_image_t view;
+		list_image_open(&view, buffer, image_size);
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			for (uint16_t slot = list_image_begin(&view); slot != list_image_end(&view);
+			     slot = list_image_next(&view, slot))
+				sink ^= ((const bench_reading_t *)list_image_data(&view, slot))->id;
+		uint64_t walk_ns = (bench_now_ns() - start) / rounds;
+		(void)sink;
+
+		printf("  %5d 个元素（%7u 字节）：序列化 %6.0f MB/s，反序列化 %6.0f MB/s，写映像 %6.0f MB/s，"
+		       "遍历映像 %6.0f MB/s\n",
+		       count, size, save_ns ? size * 1000.0 / (double)save_ns : 0.0,
+		       load_ns ? size * 1000.0 / (double)load_ns : 0.0,
+		       image_ns ? image_size * 1000.0 / (double)image_ns : 0.0,
+		       walk_ns ? image_size * 1000.0 / (double)walk_ns : 0.0);
+
+		list_free(list);
+		list_free(restored);
+		free(buffer);
+	}
+}
+
+static void bench_parallel_restore(void)
+{
+	const int count = 65535;
+	const int rounds = 20;
+	const uint8_t thread_counts[] = {1, 2, 4, 8};
+
+	printf("[并行反序列化] %d 个 %zu 字节元素，重启恢复 %d 次\n", count, sizeof(bench_wide_t), rounds);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	list_handle_t restored = list_create((uint16_t)count, sizeof(bench_wide_t));
+	bench_wide_t element;
+	memset(&element, 0, sizeof(element));
+	for (int i = 0; list != NULL && i < count; i++)
+	{
+		element.key = (uint32_t)i;
+		element.payload[0] = bench_rand();
+		list_push_back(list, &element);
+	}
+	uint32_t buffer_size = list != NULL ? list_get_serialize_size(list) : 0;
+	uint8_t *buffer = (uint8_t *)malloc(buffer_size > 0 ? buffer_size : 1);
+	if (list == NULL || restored == NULL || buffer == NULL)
+	{
+		list_free(list);
+		list_free(restored);
+		free(buffer);
+		return;
+	}
+
+	// 删除一半元素再写回，使快照中的槽位顺序不连续
+	list_remove_if(list, bench_checksum_odd, NULL);
+	while (list_size(list) < count)
+		list_push_back(list, &element);
+	uint32_t size = list_serialize(list, buffer, buffer_size);
+
+	list_deserialize(restored, buffer, size);  // 预热
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+		list_deserialize(restored, buffer, size);
+	uint64_t serial_ns = (bench_now_ns() - start) / rounds;
+	bench_report("list_deserialize", serial_ns, (uint32_t)count);
+
+	for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++)
+	{
+		list_workers_handle_t workers = list_workers_create(thread_counts[t]);
+		if (workers == NULL)
+			break;
+
+		list_parallel_deserialize(workers, restored, buffer, size);
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+			list_parallel_deserialize(workers, restored, buffer, size);
+		uint64_t parallel_ns = (bench_now_ns() - start) / rounds;
+
+		char name[64];
+		snprintf(name, sizeof(name), "list_parallel_deserialize %u 线程", (unsigned)thread_counts[t]);
+		bench_report(name, parallel_ns, (uint32_t)count);
+		printf("  相对 list_deserialize 加速比: %.2f\n", parallel_ns ? (double)serial_ns / parallel_ns : 0.0);
+
+		list_workers_free(workers);
+	}
+
+	list_free(list);
+	list_free(restored);
+	free(buffer);
+}
+
+static int bench_compare_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+	return (x > y) - (x < y);
+}
+
+// 生产者每次操作（删除最旧、追加最新）的延迟，包括操作前后台写出线程持有列表锁的时间；
+// 没有真正的后台线程，写出按持锁的粒度与生产者交替执行：list_serialize 一次持锁写完，快照每次持锁读出一块
+static void bench_snapshot_run(const char *name, list_handle_t list, uint8_t *buffer, uint32_t buffer_size, int mode,
+                               uint64_t *latency, int ops, int period)
+{
+	const uint32_t chunk_size = 4096;
+	bench_wide_t element;
+	memset(&element, 0, sizeof(element));
+	list_snapshot_handle_t snapshot = NULL;
+	uint32_t used = 0;
+	uint32_t snapshots = 0;
+	uint64_t window_max[16] = {0};  // 每个快照周期内的最大延迟
+	int windows = ops / period;
+
+	for (int i = 0; i < ops; i++)
+	{
+		uint64_t start = bench_now_ns();
+		if (mode == 1 && i % period == 0)
+		{
+			list_serialize(list, buffer, buffer_size);
+			snapshots++;
+		}
+		else if (mode == 2 && snapshot == NULL && i % period == 0)
+		{
+			snapshot = list_snapshot_begin(list);
+			used = 0;
+		}
+		else if (snapshot != NULL)
+		{
+			uint32_t n = list_snapshot_read(snapshot, buffer + used, chunk_size);
+			used += n;
+			if (n == 0)
+			{
+				snapshots += list_snapshot_end(snapshot) ? 1 : 0;
+				snapshot = NULL;
+			}
+		}
+
+		element.key = (uint32_t)i;
+		list_pop_front(list, NULL);
+		list_push_back(list, &element);
+		latency[i] = bench_now_ns() - start;
+		if (latency[i] > window_max[i / period])
+			window_max[i / period] = latency[i];
+	}
+	if (snapshot != NULL)
+		list_snapshot_end(snapshot);
+
+	// 偶尔的调度抖动会让个别周期的最大值失真，取各周期最大延迟的中位数
+	qsort(latency, (size_t)ops, sizeof(uint64_t), bench_compare_u64);
+	qsort(window_max, (size_t)windows, sizeof(uint64_t), bench_compare_u64);
+	printf("  %-28s p50 %5.0f ns  p99 %6.0f ns  p99.99 %7.0f ns  每周期最大 %9.0f ns  完成快照 %u 次\n", name,
+	       (double)latency[ops / 2], (double)latency[(size_t)ops * 99 / 100], (double)latency[(size_t)ops * 9999 / 10000],
+	       (double)window_max[windows / 2], (unsigned)snapshots);
+}
+
+static void bench_snapshot(void)
+{
+	const int count = 60000;
+	const int ops = 400000;
+	const int period = 40000;
+
+	printf("[写时复制快照] %d 个 %zu 字节元素，生产者 %d 次操作，每 %d 次操作开始一次快照\n", count, sizeof(bench_wide_t),
+	       ops, period);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	uint32_t buffer_size = (uint32_t)(sizeof(list_save_header_t) + sizeof(list_persist_header_t) +
+	                                  (size_t)count * (sizeof(uint16_t) + sizeof(bench_wide_t)));
+	uint8_t *buffer = (uint8_t *)malloc(buffer_size);
+	uint64_t *latency = (uint64_t *)malloc((size_t)ops * sizeof(uint64_t));
+	if (list == NULL || buffer == NULL || latency == NULL)
+	{
+		list_free(list);
+		free(buffer);
+		free(latency);
+		return;
+	}
+
+	bench_wide_t element;
+	memset(&element, 0, sizeof(element));
+	for (int i = 0; i < count; i++)
+		list_push_back(list, &element);
+
+	bench_snapshot_run("不做快照", list, buffer, buffer_size, 0, latency, ops, period);
+	bench_snapshot_run("list_serialize（整体持锁）", list, buffer, buffer_size, 1, latency, ops, period);
+	bench_snapshot_run("list_snapshot（每块4KB）", list, buffer, buffer_size, 2, latency, ops, period);
+
+	list_free(list);
+	free(buffer);
+	free(latency);
+}
+
+#ifndef _WIN32
+static bool bench_fd_write(const void *data, uint32_t size, void *ctx)
+{
+	return write(*(int *)ctx, data, size) == (ssize_t)size;
+}
+
+static uint32_t bench_fd_read(void *data, uint32_t size, void *ctx)
+{
+	ssize_t n = read(*(int *)ctx, data, size);
+	return n > 0 ? (uint32_t)n : 0;
+}
+
+static void bench_stream(void)
+{
+	const int count = 60000;
+	const int rounds = 10;
+
+	printf("[流式序列化] %d 个 %zu 字节元素写入/读取文件描述符，%d 轮\n", count, sizeof(bench_wide_t), rounds);
+
+	list_handle_t list = list_create((uint16_t)count, sizeof(bench_wide_t));
+	list_handle_t restored = list_create((uint16_t)count, sizeof(bench_wide_t));
+	FILE *file = tmpfile();
+	uint32_t total = 0;
+	uint8_t *buffer = NULL;
+	if (list != NULL && restored != NULL && file != NULL)
+	{
+		bench_wide_t record;
+		memset(&record, 0, sizeof(record));
+		for (int i = 0; i < count; i++)
+		{
+			record.key = (uint32_t)i;
+			list_push_back(list, &record);
+		}
+		total = list_get_serialize_size(list);
+		buffer = (uint8_t *)malloc(total);
+	}
+	if (buffer == NULL)
+	{
+		list_free(list);
+		list_free(restored);
+		if (file)
+			fclose(file);
+		return;
+	}
+
+	int fd = fileno(file);
+	double mb = (double)total * rounds / (1024.0 * 1024.0);
+
+	// 整块缓冲区：需要额外 total 字节内存
+	uint64_t start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+	{
+		lseek(fd, 0, SEEK_SET);
+		uint32_t n = list_serialize(list, buffer, total);
+		bench_fd_write(buffer, n, &fd);
+	}
+	uint64_t elapsed = bench_now_ns() - start;
+	printf("  %-36s %8.1f MB/s  额外内存 %u 字节\n", "list_serialize + write", mb * 1e9 / (double)elapsed, total);
+
+	static const uint32_t chunks[] = {256, 4096, 65536};
+	for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++)
+	{
+		start = bench_now_ns();
+		for (int r = 0; r < rounds; r++)
+		{
+			lseek(fd, 0, SEEK_SET);
+			list_serialize_stream(list, bench_fd_write, &fd, chunks[c]);
+		}
+		elapsed = bench_now_ns() - start;
+		char name[64];
+		snprintf(name, sizeof(name), "list_serialize_stream（块 %u 字节）", chunks[c]);
+		printf("  %-36s %8.1f MB/s  额外内存 %u 字节\n", name, mb * 1e9 / (double)elapsed, chunks[c]);
+	}
+
+	start = bench_now_ns();
+	for (int r = 0; r < rounds; r++)
+	{
+		lseek(fd, 0, SEEK_SET);
+		if (read(fd, buffer, total) == (ssize_t)total)
+			list_deserialize(restored, buffer, total);
+	}
+	elapsed = bench_now_ns() - start;
+	printf("  %-36s %8.1f MB/s  额外内存 %u 字节\n", "read + list_deserialize", mb * 1e9 / (double)elapsed, total);
+
+	start = bench_now_ns();
+	bool ok = true;
+	for (int r = 0; r < rounds; r++)
+	{
+		lseek(fd, 0, SEEK_SET);
+		ok = list_deserialize_stream(restored, bench_fd_read, &fd) && ok;
+	}
+	elapsed = bench_now_ns() - start;
+	printf("  %-36s %8.1f MB/s  额外内存 %u 字节%s\n", "list_deserialize_stream", mb * 1e9 / (double)elapsed,
+	       (unsigned)LIST_STREAM_READ_SIZE, ok && list_size(restored) == count ? "" : "（失败）");
+
+	free(buffer);
+	fclose(file);
+	list_free(list);
+	list_free(restored);
+}
+#endif
+
+int main(void)
+{
+#ifdef _WIN32
+	SetConsoleOutputCP(65001);
+#endif
+
+	printf("链表性能基准测试\n");
+	printf("================\n\n");
+
+	bench_erase_range();
+	bench_merge();
+	bench_cross_pool_splice();
+	bench_ring();
+	bench_pq();
+	bench_hash();
+	bench_order();
+	bench_lru();
+	bench_traversal();
+	bench_compact();
+	bench_scan_pool();
+	bench_parallel();
+	bench_algorithms();
+	bench_partition_select();
+	bench_image();
+	bench_delta();
+	bench_journal();
+	bench_packed();
+	bench_order_only();
+	bench_crc();
+	bench_portable();
+	bench_parallel_restore();
+	bench_snapshot();
+#ifndef _WIN32
+	bench_stream();
+#endif
+
+	return 0;
+}
@@ -7,9 +7,47 @@
 #define LIST_LOCK(list) LIST_MUTEX_LOCK((list)->mutex)
 #define LIST_UNLOCK(list) LIST_MUTEX_UNLOCK((list)->mutex)
 #define LIST_NODE_SIZE(element_size) ALIGN_UP(sizeof(list_node_t) + ((element_size) > 0 ? (element_size) : 1), 4)
+// 节点池（以及 free_list）的实际所有者
+#define LIST_POOL(list) ((list)->pool_owner != NULL ? (list)->pool_owner : (list))
+// 通知变更观察者，未注册观察者时只有一次判断的开销
+#define LIST_NOTIFY(list, event, node)              \
+	do                                              \
+	{                                               \
+		if ((list)->observers != NULL)              \
+			list_notify((list), (event), (node));   \
+	} while (0)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIST_PREFETCH(addr) __builtin_prefetch((addr), 0, 1)
+#define LIST_CTZ32(x) ((uint32_t)__builtin_ctz(x))
+#else
+#define LIST_PREFETCH(addr) ((void)(addr))
+static inline uint32_t LIST_CTZ32(uint32_t x)
+{
+	uint32_t n = 0;
+	while ((x & 1u) == 0)
+	{
+		x >>= 1;
+		n++;
+	}
+	return n;
+}
+#endif
+
+// 活动槽位位图操作，pool 为节点池所有者
+#define LIST_LIVE_SET(pool, slot) ((pool)->live_map[(slot) >> 5] |= (uint32_t)1 << ((slot) & 31))
+#define LIST_LIVE_CLEAR(pool, slot) ((pool)->live_map[(slot) >> 5] &= ~((uint32_t)1 << ((slot) & 31)))
+
+// 节点在节点池中的槽位，只在启用活动槽位位图时使用
+static inline uint16_t list_pool_slot(list_handle_t pool, const list_node_t *node)
+{
+	return (uint16_t)(((const uint8_t *)node - (const uint8_t *)pool->node_pool) / LIST_NODE_SIZE(pool->element_size));
+}
 
 static list_node_t *list_alloc_node(list_handle_t list);
 static void list_free_node(list_handle_t list, list_node_t *node);
+static void list_free_segment(list_handle_t list, list_node_t *first, list_node_t *last);
+static void list_unlink_segment(list_handle_t list, list_node_t *first, list_node_t *last);
 static void list_init_free_list(list_handle_t list);
 
 list_handle_t list_create(uint16_t capacity, uint16_t element_size)
@@ -37,6 +75,12 @@ list_handle_t list_create(uint16_t capacity, uint16_t element_size)
 	list->tail = NULL;
 	list->free_list = NULL;
 	list->is_static = false;
+	list->is_ring = false;
+	list->pool_owner = NULL;
+	list->pool_users = 0;
+	list->observers = NULL;
+	list->live_map = NULL;
+	list->live_map_static = false;
 
 	// 初始化空闲链表
 	list_init_free_list(list);
@@ -69,6 +113,12 @@ list_handle_t list_create_from_buf(void *node_pool_buf, uint16_t capacity, uint1
 	list->tail = NULL;
 	list->free_list = NULL;
 	list->is_static = true;
+	list->is_ring = false;
+	list->pool_owner = NULL;
+	list->pool_users = 0;
+	list->observers = NULL;
+	list->live_map = NULL;
+	list->live_map_static = false;
 
 	// 初始化空闲链表
 	list_init_free_list(list);
@@ -79,6 +129,50 @@ list_handle_t list_create_from_buf(void *node_pool_buf, uint16_t capacity, uint1
 	return list;
 }
 
+/**
+ *@brief    创建与 owner 共享节点池的列表
+ *@param    owner 节点池所有者（也可以是另一个共享列表，此时共享其所有者的节点池）
+ *@return   新列表句柄，失败返回NULL
+ *@note     共享同一节点池的列表之间 list_splice/list_merge 只重链接指针，时间复杂度为O(1)
+ *@note     所有共享列表从同一个 free_list 分配节点，capacity 为整个节点池的容量
+ *@note     必须先释放共享列表，再释放节点池所有者；共享节点池的列表不能反序列化
+ */
+list_handle_t list_create_shared(list_handle_t owner)
+{
+	if (owner == NULL)
+		return NULL;
+
+	list_handle_t pool = LIST_POOL(owner);
+
+	list_handle_t list = (list_handle_t)malloc(sizeof(list_t));
+	if (list == NULL)
+		return NULL;
+
+	list->node_pool = pool->node_pool;
+	list->capacity = pool->capacity;
+	list->element_size = pool->element_size;
+	list->size = 0;
+	list->head = NULL;
+	list->tail = NULL;
+	list->free_list = NULL;
+	list->is_static = true;  // 节点池不由本列表释放
+	list->is_ring = false;
+	list->pool_owner = pool;
+	list->pool_users = 0;
+	list->observers = NULL;
+	list->live_map = NULL;  // 位图属于节点池所有者
+	list->live_map_static = false;
+
+	LIST_LOCK(pool);
+	pool->pool_users++;
+	LIST_UNLOCK(pool);
+
+	// 初始化互斥锁
+	LIST_MUTEX_INIT(list->mutex);
+
+	return list;
+}
+
 static void list_init_free_list(list_handle_t list)
 {
 	if (list->node_pool == NULL)
@@ -101,21 +195,56 @@ void list_free(list_handle_t list)
 	{
 		LIST_MUTEX_DESTROY(list->mutex);
 
+		if (list->pool_owner != NULL)
+		{
+			LIST_LOCK(list->pool_owner);
+			list->pool_owner->pool_users--;
+			LIST_UNLOCK(list->pool_owner);
+		}
+
 		if (!list->is_static)
 		{
 			free(list->node_pool);
 		}
+		if (list->live_map != NULL && !list->live_map_static)
+		{
+			free(list->live_map);
+		}
 		free(list);
 	}
 }
 
+/**
+ *@brief    设置环形缓冲模式
+ *@param    list 列表指针
+ *@param    enable 是否启用
+ *@note     启用后 list_push_back 在列表已满时覆盖最旧的元素（头节点），而不是返回失败
+ */
+void list_set_ring_mode(list_handle_t list, bool enable)
+{
+	if (list == NULL)
+		return;
+
+	LIST_LOCK(list);
+	list->is_ring = enable;
+	LIST_UNLOCK(list);
+}
+
 static list_node_t *list_alloc_node(list_handle_t list)
 {
-	if (list->free_list == NULL)
-		return NULL;
+	list_handle_t pool = LIST_POOL(list);
 
-	list_node_t *node = list->free_list;
-	list->free_list = node->next;
+	LIST_LOCK(pool);
+	list_node_t *node = pool->free_list;
+	if (node == NULL)
+	{
+		LIST_UNLOCK(pool);
+		return NULL;
+	}
+	pool->free_list = node->next;
+	if (pool->live_map != NULL)
+		LIST_LIVE_SET(pool, list_pool_slot(pool, node));
+	LIST_UNLOCK(pool);
 
 	// 重置节点状态
 	node->next = NULL;
@@ -131,8 +260,126 @@ static void list_free_node(list_handle_t list, list_node_t *node)
 	if (node == NULL)
 		return;
 
-	node->next = list->free_list;
-	list->free_list = node;
+	list_handle_t pool = LIST_POOL(list);
+
+	LIST_LOCK(pool);
+	node->next = pool->free_list;
+	pool->free_list = node;
+	if (pool->live_map != NULL)
+		LIST_LIVE_CLEAR(pool, list_pool_slot(pool, node));
+	LIST_UNLOCK(pool);
+}
+
+// 将已解链的节点段 [first, last]（通过 next 相连）整体归还到 free_list，只需一次重链接
+static void list_free_segment(list_handle_t list, list_node_t *first, list_node_t *last)
+{
+	if (first == NULL || last == NULL)
+		return;
+
+	list_handle_t pool = LIST_POOL(list);
+
+	LIST_LOCK(pool);
+	if (pool->live_map != NULL)
+	{
+		// 启用位图时需要逐个清除，时间复杂度变为O(段长度)
+		for (list_node_t *node = first; node != last->next; node = node->next)
+			LIST_LIVE_CLEAR(pool, list_pool_slot(pool, node));
+	}
+	last->next = pool->free_list;
+	pool->free_list = first;
+	LIST_UNLOCK(pool);
+}
+
+// 将节点段 [first, last] 从链表中摘除，段内部的 next 链接保持不变
+static void list_unlink_segment(list_handle_t list, list_node_t *first, list_node_t *last)
+{
+	if (first->prev != NULL)
+	{
+		first->prev->next = last->next;
+	}
+	else
+	{
+		list->head = last->next;
+	}
+
+	if (last->next != NULL)
+	{
+		last->next->prev = first->prev;
+	}
+	else
+	{
+		list->tail = first->prev;
+	}
+
+	first->prev = NULL;
+	last->next = NULL;
+}
+
+// 对节点段 [first, last] 中的每个节点通知事件
+static void list_notify_segment(list_handle_t list, list_event_t event, list_node_t *first, list_node_t *last)
+{
+	if (list->observers == NULL)
+		return;
+
+	list_node_t *current = first;
+	while (current != NULL)
+	{
+		list_node_t *next = current->next;
+		list_notify(list, event, current);
+		if (current == last)
+			break;
+		current = next;
+	}
+}
+
+// 空闲节点的 prev 不参与分配，标记时存放 free_list 中前一个空闲节点的地址并置最低位，
+// 活动节点的 prev 为NULL或对齐的节点地址，最低位总是0
+#define LIST_FREE_TAG(prev) ((list_node_t *)((uintptr_t)(prev) | 1u))
+#define LIST_FREE_UNTAG(prev) ((list_node_t *)((uintptr_t)(prev) & ~(uintptr_t)1u))
+#define LIST_NODE_IS_MARKED_FREE(node) (((uintptr_t)(node)->prev & 1u) != 0)
+
+// 沿 free_list 标记所有空闲节点；标记只在下一次分配或释放节点前有效
+static void list_mark_free_nodes(list_handle_t list)
+{
+	list_node_t *prev = NULL;
+	for (list_node_t *node = list->free_list; node != NULL; node = node->next)
+	{
+		node->prev = LIST_FREE_TAG(prev);
+		prev = node;
+	}
+}
+
+// 预取游标：从 node 开始预取后续 LIST_PREFETCH_DISTANCE 个节点，返回最远的已预取节点
+// 遍历每前进一步调用一次 list_prefetch_advance，游标始终领先当前节点固定跳数，
+// 节点数据的缓存缺失与谓词/回调的执行重叠，而不是每一步都等待一次内存访问
+static inline list_node_t *list_prefetch_start(list_node_t *node)
+{
+#if LIST_PREFETCH_DISTANCE > 0
+	if (node == NULL)
+		return NULL;
+
+	LIST_PREFETCH(node);
+	for (int i = 1; i < LIST_PREFETCH_DISTANCE && node->next != NULL; i++)
+	{
+		node = node->next;
+		LIST_PREFETCH(node);
+	}
+	return node;
+#else
+	(void)node;
+	return NULL;
+#endif
+}
+
+static inline list_node_t *list_prefetch_advance(list_node_t *ahead)
+{
+	if (ahead == NULL)
+		return NULL;
+
+	ahead = ahead->next;
+	if (ahead != NULL)
+		LIST_PREFETCH(ahead);
+	return ahead;
 }
 
 // ========================= 容量查询 =========================
@@ -261,6 +508,45 @@ int16_t list_index(list_handle_t list, list_iterator_t it)
 	return index;
 }
 
+/**
+ *@brief    获取节点在节点池中的槽位索引
+ *@param    list 列表指针
+ *@param    it 节点迭代器
+ *@return   槽位索引，节点不属于该列表的节点池时返回 LIST_INVALID_SLOT
+ *@note     槽位索引在节点的生命周期内保持不变，可用作节点的紧凑引用
+ */
+uint16_t list_node_slot(list_handle_t list, list_iterator_t it)
+{
+	if (list == NULL || it == NULL || list->node_pool == NULL)
+		return LIST_INVALID_SLOT;
+
+	size_t node_size = LIST_NODE_SIZE(list->element_size);
+	uint8_t *base = (uint8_t *)list->node_pool;
+	if ((uint8_t *)it < base)
+		return LIST_INVALID_SLOT;
+
+	size_t byte_diff = (size_t)((uint8_t *)it - base);
+	if ((byte_diff % node_size) != 0 || byte_diff / node_size >= list->capacity)
+		return LIST_INVALID_SLOT;
+
+	return (uint16_t)(byte_diff / node_size);
+}
+
+/**
+ *@brief    根据槽位索引获取节点
+ *@param    list 列表指针
+ *@param    slot 槽位索引
+ *@return   节点迭代器，索引越界时返回NULL
+ *@note     不检查该槽位的节点是否正在使用
+ */
+list_iterator_t list_slot_node(list_handle_t list, uint16_t slot)
+{
+	if (list == NULL || list->node_pool == NULL || slot >= list->capacity)
+		return NULL;
+
+	return (list_iterator_t)((uint8_t *)list->node_pool + slot * LIST_NODE_SIZE(list->element_size));
+}
+
 // ========================= 修改操作 =========================
 void list_clear(list_handle_t list)
 {
@@ -269,18 +555,15 @@ void list_clear(list_handle_t list)
 
 	LIST_LOCK(list);
 
-	list_node_t *current = list->head;
-	while (current != NULL)
-	{
-		list_node_t *next = current->next;
-		list_free_node(list, current);
-		current = next;
-	}
+	// 整条链表一次性归还到 free_list
+	list_free_segment(list, list->head, list->tail);
 
 	list->head = NULL;
 	list->tail = NULL;
 	list->size = 0;
 
+	LIST_NOTIFY(list, LIST_EVENT_RESET, NULL);
+
 	LIST_UNLOCK(list);
 }
 
@@ -343,6 +626,8 @@ bool list_insert(list_handle_t list, list_iterator_t position, const void *eleme
 	}
 
 	list->size++;
+	LIST_NOTIFY(list, LIST_EVENT_LINK, new_node);
+
 	LIST_UNLOCK(list);
 	return true;
 }
@@ -354,6 +639,8 @@ bool list_erase(list_handle_t list, list_iterator_t position)
 
 	LIST_LOCK(list);
 
+	LIST_NOTIFY(list, LIST_EVENT_UNLINK, position);
+
 	if (position->prev != NULL)
 	{
 		position->prev->next = position->next;
@@ -379,13 +666,161 @@ bool list_erase(list_handle_t list, list_iterator_t position)
 	return true;
 }
 
+/**
+ *@brief    删除列表中 [first, last) 范围内的所有节点
+ *@param    list 列表指针
+ *@param    first 开始节点
+ *@param    last 结束节点（不包含），为NULL时删除到末尾
+ *@param    erased 可选，返回实际删除的元素数量，不需要时传NULL
+ *@return   是否删除成功
+ *@note     整段只解链一次，并通过一次重链接归还到 free_list，只加锁一次
+ *@note     删除整个链表（first 为头节点且 last 为NULL）时为O(1)，否则需要O(k)计数
+ */
+bool list_erase_range(list_handle_t list, list_iterator_t first, list_iterator_t last, uint16_t *erased)
+{
+	if (erased != NULL)
+		*erased = 0;
+
+	if (list == NULL || first == NULL || first == last)
+		return false;
+
+	LIST_LOCK(list);
+
+	uint16_t count = 0;
+	list_node_t *last_of_range = NULL;
+	if (first == list->head && last == NULL)
+	{
+		count = list->size;
+		last_of_range = list->tail;
+	}
+	else
+	{
+		list_node_t *current = first;
+		while (current != last && current != NULL)
+		{
+			last_of_range = current;
+			count++;
+			current = current->next;
+		}
+	}
+
+	list_notify_segment(list, LIST_EVENT_UNLINK, first, last_of_range);
+	list_unlink_segment(list, first, last_of_range);
+	list_free_segment(list, first, last_of_range);
+	list->size -= count;
+
+	LIST_UNLOCK(list);
+
+	if (erased != NULL)
+		*erased = count;
+	return true;
+}
+
+/**
+ *@brief    删除列表头部的 n 个元素
+ *@param    list 列表指针
+ *@param    n 要删除的元素数量，大于等于元素数量时清空列表
+ *@return   实际删除的元素数量
+ *@note     从距离分界点较近的一端查找分界节点，整段一次性归还到 free_list
+ */
+uint16_t list_truncate_front(list_handle_t list, uint16_t n)
+{
+	if (list == NULL || n == 0)
+		return 0;
+
+	LIST_LOCK(list);
+
+	if (n > list->size)
+		n = list->size;
+
+	if (n == 0)
+	{
+		LIST_UNLOCK(list);
+		return 0;
+	}
+
+	// 查找被删除段的最后一个节点（第 n-1 个节点）
+	list_node_t *last_of_range;
+	if (n <= list->size / 2)
+	{
+		last_of_range = list->head;
+		for (uint16_t i = 1; i < n; i++)
+			last_of_range = last_of_range->next;
+	}
+	else
+	{
+		last_of_range = list->tail;
+		for (uint16_t i = list->size; i > n; i--)
+			last_of_range = last_of_range->prev;
+	}
+
+	list_node_t *first = list->head;
+	list_notify_segment(list, LIST_EVENT_UNLINK, first, last_of_range);
+	list_unlink_segment(list, first, last_of_range);
+	list_free_segment(list, first, last_of_range);
+	list->size -= n;
+
+	LIST_UNLOCK(list);
+	return n;
+}
+
+/**
+ *@brief    删除列表尾部的 n 个元素
+ *@param    list 列表指针
+ *@param    n 要删除的元素数量，大于等于元素数量时清空列表
+ *@return   实际删除的元素数量
+ *@note     从距离分界点较近的一端查找分界节点，整段一次性归还到 free_list
+ */
+uint16_t list_truncate_back(list_handle_t list, uint16_t n)
+{
+	if (list == NULL || n == 0)
+		return 0;
+
+	LIST_LOCK(list);
+
+	if (n > list->size)
+		n = list->size;
+
+	if (n == 0)
+	{
+		LIST_UNLOCK(list);
+		return 0;
+	}
+
+	// 查找被删除段的第一个节点（倒数第 n 个节点）
+	list_node_t *first;
+	if (n <= list->size / 2)
+	{
+		first = list->tail;
+		for (uint16_t i = 1; i < n; i++)
+			first = first->prev;
+	}
+	else
+	{
+		first = list->head;
+		for (uint16_t i = list->size; i > n; i--)
+			first = first->next;
+	}
+
+	list_node_t *last_of_range = list->tail;
+	list_notify_segment(list, LIST_EVENT_UNLINK, first, last_of_range);
+	list_unlink_segment(list, first, last_of_range);
+	list_free_segment(list, first, last_of_range);
+	list->size -= n;
+
+	LIST_UNLOCK(list);
+	return n;
+}
+
 bool list_replace(list_handle_t list, list_iterator_t position, const void *element)
 {
 	if (list == NULL || position == NULL || element == NULL)
 		return false;
 
 	LIST_LOCK(list);
+	LIST_NOTIFY(list, LIST_EVENT_BEFORE_UPDATE, position);
 	memcpy(position->data, element, list->element_size);
+	LIST_NOTIFY(list, LIST_EVENT_UPDATE, position);
 	LIST_UNLOCK(list);
 	return true;
 }
@@ -397,9 +832,75 @@ bool list_push_front(list_handle_t list, const void *element)
 
 bool list_push_back(list_handle_t list, const void *element)
 {
+	if (list != NULL && list->is_ring)
+		return list_push_back_ring(list, element, NULL, NULL);
+
 	return list_insert(list, NULL, element);
 }
 
+/**
+ *@brief    以环形缓冲方式在尾部插入元素
+ *@param    list 列表指针
+ *@param    element 插入元素
+ *@param    evicted 可选，发生覆盖时保存被淘汰的最旧元素，不需要时传NULL
+ *@param    overwritten 可选，返回是否发生了覆盖，不需要时传NULL
+ *@return   是否插入成功
+ *@note     列表未满时等同于 list_push_back；已满时把头节点原地回收到尾部，
+ *          只加锁一次、复制一次数据，不经过 free_list
+ */
+bool list_push_back_ring(list_handle_t list, const void *element, void *evicted, bool *overwritten)
+{
+	if (overwritten != NULL)
+		*overwritten = false;
+
+	if (list == NULL || element == NULL)
+		return false;
+
+	LIST_LOCK(list);
+
+	list_node_t *node = (list->size < list->capacity) ? list_alloc_node(list) : NULL;
+	if (node == NULL)
+	{
+		// 已满（或共享节点池已耗尽），回收最旧的头节点
+		node = list->head;
+		if (node == NULL)
+		{
+			LIST_UNLOCK(list);
+			return false;
+		}
+
+		if (evicted != NULL)
+			memcpy(evicted, node->data, list->element_size);
+		if (overwritten != NULL)
+			*overwritten = true;
+
+		LIST_NOTIFY(list, LIST_EVENT_UNLINK, node);
+
+		list->head = node->next;
+		if (list->head != NULL)
+			list->head->prev = NULL;
+		else
+			list->tail = NULL;
+		list->size--;
+	}
+
+	memcpy(node->data, element, list->element_size);
+
+	node->next = NULL;
+	node->prev = list->tail;
+	if (list->tail != NULL)
+		list->tail->next = node;
+	else
+		list->head = node;
+	list->tail = node;
+	list->size++;
+
+	LIST_NOTIFY(list, LIST_EVENT_LINK, node);
+
+	LIST_UNLOCK(list);
+	return true;
+}
+
 bool list_pop_front(list_handle_t list, void *element)
 {
 	if (list == NULL || list->head == NULL)
@@ -426,45 +927,202 @@ bool list_pop_back(list_handle_t list, void *element)
 	return list_erase(list, list->tail);
 }
 
-void list_swap(list_handle_t list1, list_handle_t list2)
+/**
+ *@brief    交换两个列表的全部内容
+ *@param    list1 列表1
+ *@param    list2 列表2
+ *@note     节点池、容量和元素大小随节点一起交换，保证每个列表的节点始终属于自己的节点池
+ *@return   是否交换成功
+ *@note     共享同一节点池的两个列表只交换节点链；节点池被共享的列表不能与其他节点池的列表交换，
+ *          此时返回 false，两个列表都不修改，也不通知观察者
+ *@note     观察者留在原列表上，按原节点池容量分配的索引无法接管另一个节点池，所以任一列表注册了
+ *          观察者且两个节点池的容量或元素大小不同时同样返回 false
+ */
+bool list_swap(list_handle_t list1, list_handle_t list2)
 {
 	if (list1 == NULL || list2 == NULL)
-		return;
+		return false;
+
+	if (list1 == list2)
+		return true;
 
 	LIST_LOCK(list1);
 	LIST_LOCK(list2);
 
-	// 交换所有成员
-	list_node_t *temp_node = list1->head;
-	list1->head = list2->head;
-	list2->head = temp_node;
-
-	temp_node = list1->tail;
-	list1->tail = list2->tail;
-	list2->tail = temp_node;
-
-	temp_node = list1->free_list;
-	list1->free_list = list2->free_list;
-	list2->free_list = temp_node;
+	if (list1->node_pool == list2->node_pool)
+	{
+		// 共享节点池，free_list 属于所有者，只交换节点链
+		list_node_t *temp_node = list1->head;
+		list1->head = list2->head;
+		list2->head = temp_node;
+
+		temp_node = list1->tail;
+		list1->tail = list2->tail;
+		list2->tail = temp_node;
+
+		uint16_t temp_size = list1->size;
+		list1->size = list2->size;
+		list2->size = temp_size;
+	}
+	else if (list1->pool_owner == NULL && list1->pool_users == 0 &&
+	         list2->pool_owner == NULL && list2->pool_users == 0 &&
+	         ((list1->observers == NULL && list2->observers == NULL) ||
+	          (list1->capacity == list2->capacity && list1->element_size == list2->element_size)))
+	{
+		// 交换除互斥锁和观察者以外的所有成员
+		list_mutex_t mutex1 = list1->mutex;
+		list_mutex_t mutex2 = list2->mutex;
+		list_observer_t *observers1 = list1->observers;
+		list_observer_t *observers2 = list2->observers;
+
+		list_t temp = *list1;
+		*list1 = *list2;
+		*list2 = temp;
+
+		list1->mutex = mutex1;
+		list2->mutex = mutex2;
+		list1->observers = observers1;
+		list2->observers = observers2;
+	}
+	else
+	{
+		LIST_UNLOCK(list2);
+		LIST_UNLOCK(list1);
+		return false;
+	}
 
-	uint16_t temp_size = list1->size;
-	list1->size = list2->size;
-	list2->size = temp_size;
+	LIST_NOTIFY(list1, LIST_EVENT_RESET, NULL);
+	LIST_NOTIFY(list2, LIST_EVENT_RESET, NULL);
 
 	LIST_UNLOCK(list2);
 	LIST_UNLOCK(list1);
+	return true;
 }
 
 // ========================= 列表专有操作 =========================
+// 将已解链的节点段 [first, last] 链接到 position 之前，position 为NULL时链接到末尾
+static void list_link_segment(list_handle_t list, list_node_t *position, list_node_t *first, list_node_t *last)
+{
+	if (position == NULL)
+	{
+		first->prev = list->tail;
+		last->next = NULL;
+		if (list->tail == NULL)
+		{
+			list->head = first;
+		}
+		else
+		{
+			list->tail->next = first;
+		}
+		list->tail = last;
+	}
+	else
+	{
+		first->prev = position->prev;
+		last->next = position;
+		if (position->prev == NULL)
+		{
+			list->head = first;
+		}
+		else
+		{
+			position->prev->next = first;
+		}
+		position->prev = last;
+	}
+}
+
+// 从 list 的 free_list 一次取出 count 个节点，依次复制节点段 src 的数据并按顺序双向链接
+// 成功时通过 first/last 返回迁移段的首尾节点；空闲节点不足时不做任何修改并返回 false
+static bool list_migrate_segment(list_handle_t list, list_node_t *src, uint16_t count,
+                                 list_node_t **first, list_node_t **last)
+{
+	list_handle_t pool = LIST_POOL(list);
+
+	LIST_LOCK(pool);
+
+	// 共享节点池时空闲节点数量不一定等于 capacity - size，先确认数量足够
+	list_node_t *end = pool->free_list;
+	for (uint16_t i = 0; i < count; i++)
+	{
+		if (end == NULL)
+		{
+			LIST_UNLOCK(pool);
+			return false;
+		}
+		end = end->next;
+	}
+
+	list_node_t *dst = pool->free_list;
+	list_node_t *prev = NULL;
+	*first = dst;
+
+	for (uint16_t i = 0; i < count; i++)
+	{
+		memcpy(dst->data, src->data, list->element_size);
+		if (pool->live_map != NULL)
+			LIST_LIVE_SET(pool, list_pool_slot(pool, dst));
+		dst->prev = prev;
+		prev = dst;
+		dst = dst->next;
+		src = src->next;
+	}
+
+	pool->free_list = end;
+	*last = prev;
+
+	LIST_UNLOCK(pool);
+	return true;
+}
+
+// list_splice_n 的实现：调用者已按 list1、list2 的顺序加锁，count 为 [first, last) 中的节点数量（大于0）
+static bool list_splice_locked(list_handle_t list1, list_iterator_t position, list_handle_t list2,
+                               list_iterator_t first, list_iterator_t last, uint16_t count)
+{
+	// 检查容量
+	if (list1 != list2 && list1->size + count > list1->capacity)
+		return false;
+
+	// 移动段的最后一个节点直接由 last 或 list2 的尾节点得到，无需遍历
+	list_node_t *last_of_segment = (last != NULL) ? last->prev : list2->tail;
+
+	if (list1->node_pool == list2->node_pool)
+	{
+		list_notify_segment(list2, LIST_EVENT_UNLINK, first, last_of_segment);
+		list_unlink_segment(list2, first, last_of_segment);
+		list_link_segment(list1, position, first, last_of_segment);
+		list_notify_segment(list1, LIST_EVENT_LINK, first, last_of_segment);
+	}
+	else
+	{
+		list_node_t *migrated_first = NULL;
+		list_node_t *migrated_last = NULL;
+		if (!list_migrate_segment(list1, first, count, &migrated_first, &migrated_last))
+			return false;
+
+		list_notify_segment(list2, LIST_EVENT_UNLINK, first, last_of_segment);
+		list_unlink_segment(list2, first, last_of_segment);
+		list_free_segment(list2, first, last_of_segment);
+		list_link_segment(list1, position, migrated_first, migrated_last);
+		list_notify_segment(list1, LIST_EVENT_LINK, migrated_first, migrated_last);
+	}
+
+	list2->size -= count;
+	list1->size += count;
+	return true;
+}
+
 /**
  *
  * @brief    list_splice 将 list2 的 [first, last) 节点移动到 list1 的 position 之前。
  * @note     如果 position 为 NULL，则移动到 list1 的末尾。
- * @note     如果 first 或 last 为 NULL，则移动 list2 的所有节点。
+ * @note     如果 last 为 NULL，则移动 first 到 list2 末尾的所有节点。
  * @note     如果 list1 和 list2 的元素大小不一致，则返回 false。
- * @note     如果移动的节点数量大于 list1 的容量，则返回 false。
- * @note     如果移动的节点数量大于 list2 的容量，则返回 false。
- * @note     如果移动的节点数量大于 list1 的容量，则返回 false。·
+ * @note     如果移动的节点数量大于 list1 的剩余容量，则返回 false。
+ * @note     移动 list2 的全部节点（first 为头节点且 last 为NULL）时为O(1)，否则需要O(k)计数；
+ *           已知数量时请使用 list_splice_n
+ * @note     两个列表使用不同的节点池时，数据会迁移到 list1 的节点池，见 list_splice_n
  * @param    list1 目标列表
  * @param    position 插入位置
  * @param    list2 源列表
@@ -481,120 +1139,201 @@ bool list_splice(list_handle_t list1, list_iterator_t position, list_handle_t li
 	if (list1->element_size != list2->element_size)
 		return false;
 
+	// 与 list_splice_n、list_merge 相同，先锁 list1 再锁 list2
 	LIST_LOCK(list1);
 	LIST_LOCK(list2);
 
 	// 计算要移动的节点数量
 	uint16_t move_count = 0;
-	list_iterator_t it = first;
-	while (it != last && it != NULL)
+	if (first == list2->head && last == NULL)
 	{
-		move_count++;
-		it = it->next;
+		move_count = list2->size;
 	}
-
-	// 检查容量
-	if (list1->size + move_count > list1->capacity)
+	else
 	{
-		LIST_UNLOCK(list2);
-		LIST_UNLOCK(list1);
-		return false;
+		list_iterator_t it = first;
+		while (it != last && it != NULL)
+		{
+			move_count++;
+			it = it->next;
+		}
 	}
 
-	// 从list2中移除节点段
-	list_iterator_t before_first = first->prev;
-	list_iterator_t after_last = (last != NULL) ? last : list2->tail;
+	bool res = (move_count == 0) || list_splice_locked(list1, position, list2, first, last, move_count);
 
-	list_iterator_t last_of_segment = NULL;
-	if (last != NULL)
-	{
-		last_of_segment = last->prev;  // 保存移动段的最后一个节点
-	}
-	else
-	{
-		// 如果 last == NULL，移动段一直到末尾
-		list_iterator_t temp = first;
-		while (temp != NULL && temp->next != NULL)
-			temp = temp->next;
-		last_of_segment = temp;  // 移动段的最后一个节点
-	}
+	LIST_UNLOCK(list2);
+	LIST_UNLOCK(list1);
+	return res;
+}
 
-	if (before_first != NULL)
-	{
-		before_first->next = after_last;
-	}
-	else
+/**
+ * @brief    将 list2 的 [first, last) 共 count 个节点移动到 list1 的 position 之前
+ * @param    list1 目标列表
+ * @param    position 插入位置，为NULL时移动到 list1 的末尾
+ * @param    list2 源列表
+ * @param    first 开始节点
+ * @param    last 结束节点（不包含），为NULL时移动到 list2 末尾
+ * @param    count [first, last) 中的节点数量，由调用者保证正确
+ * @return   是否移动成功
+ * @note     两个列表共享节点池时只重链接指针，不遍历移动段，时间复杂度为O(1)
+ * @note     两个列表使用不同的节点池时（例如分别通过 list_create 创建），节点不能直接移动，
+ *           否则节点会脱离所属的节点池，破坏 free_list 和序列化。此时从 list1 的 free_list
+ *           一次取出 count 个节点，单次遍历复制数据，再把源节点段整体归还到 list2 的 free_list，
+ *           时间复杂度为O(k)；迁移后指向被移动节点的迭代器失效
+ * @note     count 与实际节点数量不一致会导致两个列表的 size 错误
+ */
+bool list_splice_n(list_handle_t list1, list_iterator_t position, list_handle_t list2,
+                   list_iterator_t first, list_iterator_t last, uint16_t count)
+{
+	if (list1 == NULL || list2 == NULL || first == NULL)
+		return false;
+
+	if (list1->element_size != list2->element_size)
+		return false;
+
+	if (first == last || count == 0)
+		return true;
+
+	LIST_LOCK(list1);
+	LIST_LOCK(list2);
+	bool res = list_splice_locked(list1, position, list2, first, last, count);
+	LIST_UNLOCK(list2);
+	LIST_UNLOCK(list1);
+	return res;
+}
+
+/**
+ * @brief    将 list2 的全部节点移动到 list1 的末尾
+ * @param    list1 目标列表
+ * @param    list2 源列表，成功后为空
+ * @return   是否合并成功；元素大小不一致时返回 false，list2 为空时不移动节点
+ * @note     移动数量在两个列表都加锁后读取 list2->size，不需要遍历计数；
+ *           两个列表共享节点池时为O(1)，使用不同节点池时需要迁移数据，时间复杂度为O(k)，见 list_splice_n
+ */
+bool list_merge(list_handle_t list1, list_handle_t list2)
+{
+	if (list1 == NULL || list2 == NULL)
+		return false;
+
+	if (list1->element_size != list2->element_size)
+		return false;
+
+	LIST_LOCK(list1);
+	LIST_LOCK(list2);
+	bool res = (list2->head == NULL) || list_splice_locked(list1, NULL, list2, list2->head, NULL, list2->size);
+	LIST_UNLOCK(list2);
+	LIST_UNLOCK(list1);
+	return res;
+}
+
+// 将节点移动到 position 之前，position 为NULL时移动到末尾；调用者已加锁
+static void list_relink_node(list_handle_t list, list_node_t *node, list_node_t *position)
+{
+	if (node == position || node->next == position)
+		return;
+
+	list_unlink_segment(list, node, node);
+	list_link_segment(list, position, node, node);
+}
+
+// 交换两个不同节点在列表中的位置；调用者已加锁
+static void list_swap_links(list_handle_t list, list_node_t *a, list_node_t *b)
+{
+	if (a->next == b)
 	{
-		list2->head = after_last;
+		list_relink_node(list, b, a);
 	}
-
-	if (after_last != NULL)
+	else if (b->next == a)
 	{
-		after_last->prev = before_first;
+		list_relink_node(list, a, b);
 	}
 	else
 	{
-		list2->tail = before_first;
+		list_node_t *a_next = a->next;
+		list_relink_node(list, a, b);
+		list_relink_node(list, b, a_next);
 	}
+}
 
-	// 调整要移动的节点段
-	first->prev = NULL;
-	if (last != NULL)
-	{
-		if (last_of_segment != NULL)
-		{
-			last_of_segment->next = NULL;  // 断开移动段的尾部
-		}
-	}
+/**
+ * @brief    将节点移动到 position 之前
+ * @param    list 列表指针
+ * @param    node 要移动的节点，必须属于 list
+ * @param    position 目标位置，必须属于 list，为NULL时移动到末尾
+ * @return   是否移动成功
+ * @note     只修改 next/prev 链接，不释放、不分配节点，也不复制数据，迭代器保持有效；时间复杂度O(1)
+ */
+bool list_move_before(list_handle_t list, list_iterator_t node, list_iterator_t position)
+{
+	if (list == NULL || node == NULL)
+		return false;
 
-	// 插入到list1
-	if (position == NULL)
+	LIST_LOCK(list);
+
+	if (node != position && node->next != position)
 	{
-		// 插入到末尾
-		if (list1->tail == NULL)
-		{
-			list1->head = first;
-		}
-		else
-		{
-			list1->tail->next = first;
-			first->prev = list1->tail;
-		}
-		list1->tail = last_of_segment;
+		list_relink_node(list, node, position);
+		LIST_NOTIFY(list, LIST_EVENT_REORDER, NULL);
 	}
-	else
-	{
-		// 插入到position之前
-		list_iterator_t before_position = position->prev;
 
-		if (before_position != NULL)
-		{
-			before_position->next = first;
-			first->prev = before_position;
-		}
-		else
-		{
-			list1->head = first;
-		}
+	LIST_UNLOCK(list);
+	return true;
+}
 
-		position->prev = last_of_segment;
-		if (last_of_segment != NULL)
-		{
-			last_of_segment->next = position;
-		}
-	}
+/**
+ * @brief    将节点移动到列表头部
+ * @note     同 list_move_before(list, node, list_begin(list))
+ */
+bool list_move_to_front(list_handle_t list, list_iterator_t node)
+{
+	if (list == NULL)
+		return false;
 
-	list1->size += move_count;
-	list2->size -= move_count;
+	return list_move_before(list, node, list->head);
+}
 
-	LIST_UNLOCK(list2);
-	LIST_UNLOCK(list1);
+/**
+ * @brief    将节点移动到列表尾部
+ * @note     同 list_move_before(list, node, NULL)
+ */
+bool list_move_to_back(list_handle_t list, list_iterator_t node)
+{
+	return list_move_before(list, node, NULL);
+}
+
+/**
+ * @brief    交换两个节点在列表中的位置
+ * @param    list 列表指针
+ * @param    a 节点a，必须属于 list
+ * @param    b 节点b，必须属于 list
+ * @return   是否交换成功
+ * @note     只修改链接，不复制数据，迭代器跟随节点；相邻节点同样适用
+ */
+bool list_swap_nodes(list_handle_t list, list_iterator_t a, list_iterator_t b)
+{
+	if (list == NULL || a == NULL || b == NULL)
+		return false;
+
+	if (a == b)
+		return true;
+
+	LIST_LOCK(list);
+	list_swap_links(list, a, b);
+	LIST_NOTIFY(list, LIST_EVENT_REORDER, NULL);
+
+	LIST_UNLOCK(list);
 	return true;
 }
 
-bool list_merge(list_handle_t list1, list_handle_t list2)
+// 返回第一个提供查找加速的观察者
+static list_observer_t *list_find_accelerator(list_handle_t list)
 {
-	return list_splice(list1, NULL, list2, list2->head, list2->tail);
+	for (list_observer_t *observer = list->observers; observer != NULL; observer = observer->next)
+	{
+		if (observer->lookup != NULL)
+			return observer;
+	}
+	return NULL;
 }
 
 /**
@@ -602,13 +1341,33 @@ bool list_merge(list_handle_t list1, list_handle_t list2)
  *@param    list 列表指针
  *@param    value 要删除的元素
  *@return   删除的元素数量
+ *@note     注册了查找加速的观察者时，每个匹配元素的查找为O(1)期望时间
  */
 uint16_t list_remove(list_handle_t list, const void *value)
 {
 	if (list == NULL || value == NULL)
 		return 0;
 
-	return list_remove_if(list, NULL, value);
+	LIST_LOCK(list);
+
+	list_observer_t *accel = list_find_accelerator(list);
+	if (accel == NULL)
+	{
+		LIST_UNLOCK(list);
+		return list_remove_if(list, NULL, value);
+	}
+
+	// 通过索引逐个查找并删除，不需要遍历整个列表
+	uint16_t remove_count = 0;
+	list_iterator_t it;
+	while ((it = accel->lookup(list, value, accel->ctx)) != NULL)
+	{
+		list_erase(list, it);
+		remove_count++;
+	}
+
+	LIST_UNLOCK(list);
+	return remove_count;
 }
 
 /**
@@ -628,10 +1387,12 @@ uint16_t list_remove_if(list_handle_t list, list_predicate_func_t predicate, con
 	uint16_t remove_count = 0;
 	list_node_t *current = list->head;
 	list_node_t *next;
+	list_node_t *ahead = list_prefetch_start(current);
 
 	while (current != NULL)
 	{
 		next = current->next;
+		ahead = list_prefetch_advance(ahead);
 
 		uint8_t res = predicate ? predicate(current->data, predicate_data) : memcmp(current->data, predicate_data, list->element_size) == 0;
 		if (res)
@@ -672,6 +1433,8 @@ void list_reverse(list_handle_t list)
 	list->head = list->tail;
 	list->tail = temp;
 
+	LIST_NOTIFY(list, LIST_EVENT_REORDER, NULL);
+
 	LIST_UNLOCK(list);
 }
 
@@ -717,79 +1480,844 @@ uint16_t list_unique(list_handle_t list)
 	return remove_count;
 }
 
-// ========================= 工具函数 =========================
+// 把 node 追加到 (head, tail) 表示的临时链的尾部
+static inline void list_chain_append(list_node_t **head, list_node_t **tail, list_node_t *node)
+{
+	node->prev = *tail;
+	node->next = NULL;
+	if (*tail != NULL)
+		(*tail)->next = node;
+	else
+		*head = node;
+	*tail = node;
+}
 
-list_iterator_t list_find(list_handle_t list, const void *value)
+// 把临时链 (head, tail) 接在 tail_out 之后，返回新的尾部；链为空时原样返回 tail_out
+static inline list_node_t *list_chain_join(list_node_t **first, list_node_t *tail_out, list_node_t *head, list_node_t *tail)
 {
-	if (list == NULL || value == NULL)
-		return NULL;
+	if (head == NULL)
+		return tail_out;
 
-	return list_find_if(list, NULL, NULL, value);
+	head->prev = tail_out;
+	if (tail_out != NULL)
+		tail_out->next = head;
+	else
+		*first = head;
+	return tail;
 }
 
 /**
- *@brief    从指定位置开始查找下一个符合条件的节点
+ *@brief    稳定划分：把满足谓词的元素移动到列表前部
  *@param    list 列表指针
- *@param    start 开始查找的位置（不包含此节点），如果为NULL则从头开始
- *@param    predicate 谓词函数指针，如果为NULL则使用memcmp比较
- *@param    value 要查找的值或谓词函数参数
- *@return   找到的节点迭代器，如果未找到则返回NULL
+ *@param    predicate 谓词函数指针，为NULL时与 predicate_data 逐字节比较
+ *@param    predicate_data 谓词函数参数
+ *@return   第一个不满足谓词的元素（分界点），所有元素都满足时返回NULL
+ *@note     两部分内部都保持原来的相对顺序；只修改链接，不复制元素数据，迭代器保持有效
+ *@note     O(n)，加锁后一次遍历完成
  */
-list_iterator_t list_find_if(list_handle_t list, list_iterator_t start, list_predicate_func_t predicate, const void *value)
+list_iterator_t list_partition(list_handle_t list, list_predicate_func_t predicate, const void *predicate_data)
 {
-	if (list == NULL)
-		return NULL;
-
-	// 如果使用 memcmp 比较（predicate 为 NULL），则 value 不能为 NULL
-	if (predicate == NULL && value == NULL)
+	if (list == NULL || (predicate == NULL && predicate_data == NULL))
 		return NULL;
 
 	LIST_LOCK(list);
 
-	list_node_t *current = (start != NULL) ? start->next : list->head;
+	list_node_t *pass_head = NULL, *pass_tail = NULL;
+	list_node_t *fail_head = NULL, *fail_tail = NULL;
+	bool reordered = false;
+
+	list_node_t *current = list->head;
+	list_node_t *ahead = list_prefetch_start(current);
 	while (current != NULL)
 	{
-		uint8_t res = predicate ? predicate(current->data, value) : memcmp(current->data, value, list->element_size) == 0;
+		list_node_t *next = current->next;
+		ahead = list_prefetch_advance(ahead);
+
+		bool res = predicate ? predicate(current->data, predicate_data) : memcmp(current->data, predicate_data, list->element_size) == 0;
 		if (res)
 		{
-			LIST_UNLOCK(list);
-			return current;
+			// 前面已有不满足的元素，说明顺序发生了变化
+			reordered |= (fail_head != NULL);
+			list_chain_append(&pass_head, &pass_tail, current);
 		}
-		current = current->next;
+		else
+		{
+			list_chain_append(&fail_head, &fail_tail, current);
+		}
+
+		current = next;
 	}
 
+	list_node_t *head = NULL;
+	list_node_t *tail = list_chain_join(&head, NULL, pass_head, pass_tail);
+	tail = list_chain_join(&head, tail, fail_head, fail_tail);
+	list->head = head;
+	list->tail = tail;
+
+	if (reordered)
+		LIST_NOTIFY(list, LIST_EVENT_REORDER, NULL);
+
 	LIST_UNLOCK(list);
-	return NULL;
+	return fail_head;
+}
+
+// 三数取中：返回 a、b、c 中值居中的节点
+static list_node_t *list_median_of_three(list_compare_func_t compare, list_node_t *a, list_node_t *b, list_node_t *c)
+{
+	if (compare(a->data, b->data) < 0)
+	{
+		if (compare(b->data, c->data) < 0)
+			return b;
+		return (compare(a->data, c->data) < 0) ? c : a;
+	}
+	if (compare(a->data, c->data) < 0)
+		return a;
+	return (compare(b->data, c->data) < 0) ? c : b;
 }
 
 /**
- *@brief    对列表中所有符合条件的节点执行回调函数
+ *@brief    部分排序：使第 n 个位置（从0开始）上的元素恰好是完全排序后该位置的元素
  *@param    list 列表指针
- *@param    predicate 谓词函数指针，如果为NULL则匹配所有节点
- *@param    predicate_data 谓词函数参数
- *@param    callback 回调函数指针
- *@param    user_data 传递给回调函数的用户数据
- *@return   处理的节点数量
+ *@param    n 目标位置
+ *@param    compare 三路比较函数
+ *@return   第 n 个位置的元素，n 超出范围时返回NULL
+ *@note     调用后它之前的元素都不大于它，之后的元素都不小于它，两侧内部的顺序不确定
+ *@note     在链表上做快速选择（三数取中、三路划分），只修改链接，不复制元素数据，期望O(n)
  */
-void list_for_each_if(list_handle_t list, list_foreach_func_t callback, void *user_data)
+list_iterator_t list_nth_element(list_handle_t list, uint16_t n, list_compare_func_t compare)
 {
-	if (list == NULL || callback == NULL)
-		return;
+	if (list == NULL || compare == NULL)
+		return NULL;
 
 	LIST_LOCK(list);
-	list_node_t *current = list->head;
-	while (current != NULL)
-	{
-
-		callback(current, user_data);
 
-		current = current->next;
+	if (n >= list->size)
+	{
+		LIST_UNLOCK(list);
+		return NULL;
 	}
 
-	LIST_UNLOCK(list);
-}
+	// 当前处理的区间：before 之后的 count 个节点（before 为NULL表示从头开始）
+	list_node_t *before = NULL;
+	list_node_t *first = list->head;
+	uint16_t count = list->size;
+	list_node_t *result = NULL;
+
+	while (result == NULL)
+	{
+		if (count == 1)
+		{
+			result = first;
+			break;
+		}
+
+		list_node_t *last = first;
+		list_node_t *middle = first;
+		for (uint16_t i = 1; i < count; i++)
+		{
+			last = last->next;
+			if (i == count / 2)
+				middle = last;
+		}
+		list_node_t *after = last->next;
+		list_node_t *pivot = list_median_of_three(compare, first, middle, last);
+
+		// 三路划分：小于、等于、大于基准值
+		list_node_t *less_head = NULL, *less_tail = NULL;
+		list_node_t *equal_head = NULL, *equal_tail = NULL;
+		list_node_t *greater_head = NULL, *greater_tail = NULL;
+		uint16_t less_count = 0, equal_count = 0;
+
+		list_node_t *current = first;
+		for (uint16_t i = 0; i < count; i++)
+		{
+			list_node_t *next = current->next;
+			int res = (current == pivot) ? 0 : compare(current->data, pivot->data);
+			if (res < 0)
+			{
+				list_chain_append(&less_head, &less_tail, current);
+				less_count++;
+			}
+			else if (res == 0)
+			{
+				list_chain_append(&equal_head, &equal_tail, current);
+				equal_count++;
+			}
+			else
+			{
+				list_chain_append(&greater_head, &greater_tail, current);
+			}
+			current = next;
+		}
+
+		// 按 小于、等于、大于 的顺序接回 before 和 after 之间
+		list_node_t *head = list->head;
+		list_node_t *tail = list_chain_join(&head, before, less_head, less_tail);
+		tail = list_chain_join(&head, tail, equal_head, equal_tail);
+		tail = list_chain_join(&head, tail, greater_head, greater_tail);
+		tail->next = after;
+		if (after != NULL)
+			after->prev = tail;
+		else
+			list->tail = tail;
+		list->head = head;
+
+		if (n < less_count)
+		{
+			first = less_head;
+			count = less_count;
+		}
+		else if (n < less_count + equal_count)
+		{
+			result = equal_head;
+			for (uint16_t i = less_count; i < n; i++)
+				result = result->next;
+		}
+		else
+		{
+			n -= less_count + equal_count;
+			before = equal_tail;
+			first = greater_head;
+			count = (uint16_t)(count - less_count - equal_count);
+		}
+	}
+
+	LIST_NOTIFY(list, LIST_EVENT_REORDER, NULL);
+
+	LIST_UNLOCK(list);
+	return result;
+}
+
+// ========================= 工具函数 =========================
+
+/**
+ *@brief    查找与 value 完全相同的元素
+ *@param    list 列表指针
+ *@param    value 要查找的值
+ *@return   找到的节点迭代器，如果未找到则返回NULL
+ *@note     注册了查找加速的观察者（如哈希索引）时为O(1)期望时间，
+ *          此时存在多个相同元素时返回其中任意一个，不一定是第一个
+ */
+list_iterator_t list_find(list_handle_t list, const void *value)
+{
+	if (list == NULL || value == NULL)
+		return NULL;
+
+	LIST_LOCK(list);
+	list_observer_t *accel = list_find_accelerator(list);
+	if (accel != NULL)
+	{
+		list_iterator_t it = accel->lookup(list, value, accel->ctx);
+		LIST_UNLOCK(list);
+		return it;
+	}
+	LIST_UNLOCK(list);
+
+	return list_find_if(list, NULL, NULL, value);
+}
+
+/**
+ *@brief    从指定位置开始查找下一个符合条件的节点
+ *@param    list 列表指针
+ *@param    start 开始查找的位置（不包含此节点），如果为NULL则从头开始
+ *@param    predicate 谓词函数指针，如果为NULL则使用memcmp比较
+ *@param    value 要查找的值或谓词函数参数
+ *@return   找到的节点迭代器，如果未找到则返回NULL
+ */
+list_iterator_t list_find_if(list_handle_t list, list_iterator_t start, list_predicate_func_t predicate, const void *value)
+{
+	if (list == NULL)
+		return NULL;
+
+	// 如果使用 memcmp 比较（predicate 为 NULL），则 value 不能为 NULL
+	if (predicate == NULL && value == NULL)
+		return NULL;
+
+	LIST_LOCK(list);
+
+	list_node_t *current = (start != NULL) ? start->next : list->head;
+	list_node_t *ahead = list_prefetch_start(current);
+	while (current != NULL)
+	{
+		ahead = list_prefetch_advance(ahead);
+		uint8_t res = predicate ? predicate(current->data, value) : memcmp(current->data, value, list->element_size) == 0;
+		if (res)
+		{
+			LIST_UNLOCK(list);
+			return current;
+		}
+		current = current->next;
+	}
+
+	LIST_UNLOCK(list);
+	return NULL;
+}
+
+/**
+ *@brief    对列表中所有符合条件的节点执行回调函数
+ *@param    list 列表指针
+ *@param    predicate 谓词函数指针，如果为NULL则匹配所有节点
+ *@param    predicate_data 谓词函数参数
+ *@param    callback 回调函数指针
+ *@param    user_data 传递给回调函数的用户数据
+ *@return   处理的节点数量
+ */
+void list_for_each_if(list_handle_t list, list_foreach_func_t callback, void *user_data)
+{
+	if (list == NULL || callback == NULL)
+		return;
+
+	LIST_LOCK(list);
+	list_node_t *current = list->head;
+	list_node_t *ahead = list_prefetch_start(current);
+	while (current != NULL)
+	{
+		ahead = list_prefetch_advance(ahead);
+
+		callback(current, user_data);
+
+		current = current->next;
+	}
+
+	LIST_UNLOCK(list);
+}
+
+/**
+ *@brief    按节点池中的槽位顺序对所有元素执行回调函数（不保证列表顺序）
+ *@param    list 列表指针
+ *@param    callback 回调函数指针
+ *@param    user_data 传递给回调函数的用户数据
+ *@note     顺序访问节点池内存，不追踪 next 指针，适合计数、统计等不关心顺序的遍历；
+ *          遍历前先沿 free_list 标记空闲节点，遍历到 size 个元素后提前结束
+ *@note     启用了活动槽位位图时等同于 list_scan_pool，不需要标记空闲节点
+ *@note     共享节点池的列表无法区分节点属于哪个列表，退化为 list_for_each_if
+ *@note     回调中不能修改列表
+ */
+void list_for_each_unordered(list_handle_t list, list_foreach_func_t callback, void *user_data)
+{
+	if (list == NULL || callback == NULL)
+		return;
+
+	if (list->pool_owner != NULL || list->pool_users > 0 || list->node_pool == NULL)
+	{
+		list_for_each_if(list, callback, user_data);
+		return;
+	}
+
+	if (list->live_map != NULL)
+	{
+		list_scan_pool(list, callback, user_data);
+		return;
+	}
+
+	LIST_LOCK(list);
+
+	list_mark_free_nodes(list);
+
+	size_t node_size = LIST_NODE_SIZE(list->element_size);
+	uint8_t *slot = (uint8_t *)list->node_pool;
+	for (uint16_t remaining = list->size; remaining > 0; slot += node_size)
+	{
+		list_node_t *node = (list_node_t *)slot;
+		if (LIST_NODE_IS_MARKED_FREE(node))
+			continue;
+
+		callback(node, user_data);
+		remaining--;
+	}
+
+	LIST_UNLOCK(list);
+}
+
+/**
+ *@brief    检查列表是否包含指定元素
+ *@note     注册了查找加速的观察者时使用它；否则启用了活动槽位位图时顺序扫描节点池，不追踪 next 指针
+ */
+bool list_contains(list_handle_t list, const void *value)
+{
+	if (list == NULL || value == NULL)
+		return false;
+
+	LIST_LOCK(list);
+	if (list->live_map != NULL && list->pool_users == 0 && list_find_accelerator(list) == NULL)
+	{
+		bool found = false;
+		size_t node_size = LIST_NODE_SIZE(list->element_size);
+		uint16_t words = (uint16_t)LIST_LIVE_MAP_WORDS(list->capacity);
+		for (uint16_t w = 0; w < words && !found; w++)
+		{
+			for (uint32_t bits = list->live_map[w]; bits != 0; bits &= bits - 1)
+			{
+				const list_node_t *node = (const list_node_t *)((const uint8_t *)list->node_pool +
+				                                                ((uint32_t)w * 32 + LIST_CTZ32(bits)) * node_size);
+				if (memcmp(node->data, value, list->element_size) == 0)
+				{
+					found = true;
+					break;
+				}
+			}
+		}
+		LIST_UNLOCK(list);
+		return found;
+	}
+	LIST_UNLOCK(list);
 
-bool list_contains(list_handle_t list, const void *value)
-{
 	return list_find(list, value) != NULL;
-}
\ No newline at end of file
+}
+
+// ========================= 活动槽位位图 =========================
+/**
+ *@brief    为节点池启用活动槽位位图
+ *@param    list 列表指针，必须是节点池所有者
+ *@param    map_buf 位图缓冲区，至少 LIST_LIVE_MAP_WORDS(capacity) 个 uint32_t；为NULL时动态分配
+ *@return   是否启用成功
+ *@note     启用后节点分配和释放时维护位图，成段释放（清空、范围删除等）变为O(段长度)；
+ *          list_scan_pool、list_for_each_unordered、list_contains 可以顺序扫描节点池
+ *@note     已启用时根据当前节点池重建位图
+ */
+bool list_enable_live_map(list_handle_t list, uint32_t *map_buf)
+{
+	if (list == NULL || list->pool_owner != NULL || list->node_pool == NULL)
+		return false;
+
+	LIST_LOCK(list);
+
+	if (list->live_map == NULL)
+	{
+		if (map_buf == NULL)
+		{
+			map_buf = (uint32_t *)malloc(LIST_LIVE_MAP_WORDS(list->capacity) * sizeof(uint32_t));
+			if (map_buf == NULL)
+			{
+				LIST_UNLOCK(list);
+				return false;
+			}
+			list->live_map_static = false;
+		}
+		else
+		{
+			list->live_map_static = true;
+		}
+		list->live_map = map_buf;
+	}
+
+	list_rebuild_live_map(list);
+
+	LIST_UNLOCK(list);
+	return true;
+}
+
+void list_disable_live_map(list_handle_t list)
+{
+	if (list == NULL || list->live_map == NULL)
+		return;
+
+	LIST_LOCK(list);
+	if (!list->live_map_static)
+		free(list->live_map);
+	list->live_map = NULL;
+	LIST_UNLOCK(list);
+}
+
+/**
+ *@brief    根据 free_list 重建活动槽位位图
+ *@note     直接改写了节点池和 free_list 之后调用（例如反序列化）；未启用位图时不做任何操作
+ */
+void list_rebuild_live_map(list_handle_t list)
+{
+	if (list == NULL || list->live_map == NULL)
+		return;
+
+	LIST_LOCK(list);
+
+	uint16_t words = (uint16_t)LIST_LIVE_MAP_WORDS(list->capacity);
+	memset(list->live_map, 0xFF, words * sizeof(uint32_t));
+	if ((list->capacity & 31) != 0)
+		list->live_map[words - 1] = ((uint32_t)1 << (list->capacity & 31)) - 1;
+
+	for (list_node_t *node = list->free_list; node != NULL; node = node->next)
+		LIST_LIVE_CLEAR(list, list_pool_slot(list, node));
+
+	LIST_UNLOCK(list);
+}
+
+/**
+ *@brief    按槽位顺序扫描节点池中的所有元素（不保证列表顺序）
+ *@param    list 列表指针
+ *@param    callback 回调函数指针
+ *@param    user_data 传递给回调函数的用户数据
+ *@note     使用活动槽位位图逐字跳过空闲槽位，顺序访问内存；未启用位图时等同于 list_for_each_unordered
+ *@note     共享节点池的列表退化为 list_for_each_if；回调中不能修改列表
+ */
+void list_scan_pool(list_handle_t list, list_foreach_func_t callback, void *user_data)
+{
+	if (list == NULL || callback == NULL)
+		return;
+
+	if (list->live_map == NULL)
+	{
+		list_for_each_unordered(list, callback, user_data);
+		return;
+	}
+
+	if (list->pool_users > 0)
+	{
+		list_for_each_if(list, callback, user_data);
+		return;
+	}
+
+	LIST_LOCK(list);
+
+	size_t node_size = LIST_NODE_SIZE(list->element_size);
+	uint16_t words = (uint16_t)LIST_LIVE_MAP_WORDS(list->capacity);
+	for (uint16_t w = 0; w < words; w++)
+	{
+		for (uint32_t bits = list->live_map[w]; bits != 0; bits &= bits - 1)
+		{
+			list_node_t *node = (list_node_t *)((uint8_t *)list->node_pool + ((uint32_t)w * 32 + LIST_CTZ32(bits)) * node_size);
+			callback(node, user_data);
+		}
+	}
+
+	LIST_UNLOCK(list);
+}
+
+// ========================= 节点池整理 =========================
+// 交换两段内存
+static void list_swap_bytes(uint8_t *a, uint8_t *b, uint16_t length)
+{
+	uint8_t temp[32];
+	while (length > 0)
+	{
+		uint16_t chunk = length < sizeof(temp) ? length : (uint16_t)sizeof(temp);
+		memcpy(temp, a, chunk);
+		memcpy(a, b, chunk);
+		memcpy(b, temp, chunk);
+		a += chunk;
+		b += chunk;
+		length -= chunk;
+	}
+}
+
+static void list_compact_restart(list_compact_t *state)
+{
+	list_mark_free_nodes(state->list);
+	state->cursor = state->list->head;
+	state->slot = 0;
+	state->started = true;
+}
+
+// 把活动节点 node 的元素和列表位置搬到已标记的空闲节点 dst，node 原来的内存接替 dst 在 free_list 中的位置
+static void list_compact_relocate(list_handle_t list, list_node_t *node, list_node_t *dst)
+{
+	list_node_t *free_prev = dst->prev;
+	list_node_t *free_next = dst->next;
+
+	memcpy(dst->data, node->data, list->element_size);
+	dst->prev = node->prev;
+	dst->next = node->next;
+	if (node->prev != NULL)
+		node->prev->next = dst;
+	else
+		list->head = dst;
+	if (node->next != NULL)
+		node->next->prev = dst;
+	else
+		list->tail = dst;
+
+	if (list->live_map != NULL)
+	{
+		LIST_LIVE_SET(list, list_pool_slot(list, dst));
+		LIST_LIVE_CLEAR(list, list_pool_slot(list, node));
+	}
+
+	node->prev = free_prev;
+	node->next = free_next;
+	if (LIST_FREE_UNTAG(free_prev) != NULL)
+		LIST_FREE_UNTAG(free_prev)->next = node;
+	else
+		list->free_list = node;
+	if (free_next != NULL)
+		free_next->prev = LIST_FREE_TAG(node);
+}
+
+// 按列表顺序把节点放到槽位 0, 1, 2...，最多处理 budget 个位置，返回是否全部完成
+static bool list_compact_run(list_compact_t *state, uint32_t budget, bool notify)
+{
+	list_handle_t list = state->list;
+	size_t node_size = LIST_NODE_SIZE(list->element_size);
+
+	state->moving = true;
+	for (; state->cursor != NULL && budget > 0; budget--)
+	{
+		list_node_t *node = state->cursor;
+		list_node_t *dst = (list_node_t *)((uint8_t *)list->node_pool + state->slot * node_size);
+
+		if (node != dst)
+		{
+			if (LIST_NODE_IS_MARKED_FREE(dst))
+			{
+				if (notify)
+					LIST_NOTIFY(list, LIST_EVENT_UNLINK, node);
+				list_compact_relocate(list, node, dst);
+				if (notify)
+					LIST_NOTIFY(list, LIST_EVENT_LINK, dst);
+			}
+			else
+			{
+				// dst 是列表中更靠后的节点，交换两者的元素和位置
+				if (notify)
+				{
+					LIST_NOTIFY(list, LIST_EVENT_UNLINK, node);
+					LIST_NOTIFY(list, LIST_EVENT_UNLINK, dst);
+				}
+				list_swap_bytes(node->data, dst->data, list->element_size);
+				list_swap_links(list, node, dst);
+				if (notify)
+				{
+					LIST_NOTIFY(list, LIST_EVENT_LINK, node);
+					LIST_NOTIFY(list, LIST_EVENT_LINK, dst);
+				}
+			}
+		}
+
+		state->cursor = dst->next;
+		state->slot++;
+	}
+	state->moving = false;
+
+	if (state->cursor != NULL)
+		return false;
+
+	// 活动节点已占据槽位 [0, size)，按槽位顺序重建 free_list 为连续的尾部
+	list->free_list = NULL;
+	for (uint16_t slot = list->capacity; slot > list->size; slot--)
+	{
+		list_node_t *node = (list_node_t *)((uint8_t *)list->node_pool + (slot - 1) * node_size);
+		node->next = list->free_list;
+		node->prev = NULL;
+		list->free_list = node;
+	}
+	list_rebuild_live_map(list);
+	state->started = false;
+	return true;
+}
+
+// 列表在两次增量整理之间被修改时，从头开始新一轮整理
+static void list_compact_on_event(list_handle_t list, list_event_t event, list_iterator_t node, void *ctx)
+{
+	list_compact_t *state = (list_compact_t *)ctx;
+	(void)list;
+	(void)node;
+
+	if (state->moving || event == LIST_EVENT_BEFORE_UPDATE || event == LIST_EVENT_UPDATE)
+		return;
+
+	state->started = false;
+}
+
+static bool list_compact_supported(list_handle_t list)
+{
+	return list->node_pool != NULL && list->pool_owner == NULL && list->pool_users == 0;
+}
+
+/**
+ *@brief    整理节点池：移动节点使列表顺序与槽位顺序一致，free_list 重建为连续的尾部
+ *@param    list 列表指针
+ *@return   是否整理成功，共享节点池的列表返回 false
+ *@note     时间复杂度O(capacity)，不分配内存
+ *@note     整理后指向该列表的所有迭代器失效（节点内存中存放的已是其他元素）；
+ *          完成后通知观察者 LIST_EVENT_RESET，索引会自动重建
+ *@note     不能用于 list_pq 内部的列表（堆中保存的槽位不会更新）
+ */
+bool list_compact(list_handle_t list)
+{
+	if (list == NULL)
+		return false;
+
+	LIST_LOCK(list);
+
+	if (!list_compact_supported(list))
+	{
+		LIST_UNLOCK(list);
+		return false;
+	}
+
+	list_compact_t state;
+	memset(&state, 0, sizeof(state));
+	state.list = list;
+	list_compact_restart(&state);
+	list_compact_run(&state, UINT32_MAX, false);
+
+	LIST_NOTIFY(list, LIST_EVENT_RESET, NULL);
+
+	LIST_UNLOCK(list);
+	return true;
+}
+
+/**
+ *@brief    开始增量整理
+ *@param    list 列表指针
+ *@param    state 整理状态，存储空间由调用者提供，整理完成或 list_compact_end 前必须保持有效
+ *@return   是否成功，共享节点池的列表返回 false
+ *@note     状态作为观察者注册在列表上，两次 list_compact_step 之间修改列表会使下一次调用从头开始
+ */
+bool list_compact_begin(list_handle_t list, list_compact_t *state)
+{
+	if (list == NULL || state == NULL)
+		return false;
+
+	LIST_LOCK(list);
+
+	if (!list_compact_supported(list))
+	{
+		LIST_UNLOCK(list);
+		return false;
+	}
+
+	memset(state, 0, sizeof(*state));
+	state->list = list;
+	state->observer.callback = list_compact_on_event;
+	state->observer.ctx = state;
+	list_add_observer(list, &state->observer);
+
+	LIST_UNLOCK(list);
+	return true;
+}
+
+/**
+ *@brief    执行一步增量整理
+ *@param    state list_compact_begin 初始化的整理状态
+ *@param    budget 本次最多处理的列表位置数
+ *@return   整理是否已完成，完成后自动注销观察者，不需要再调用 list_compact_end
+ *@note     每个被移动的节点通知 LIST_EVENT_UNLINK / LIST_EVENT_LINK，索引随之更新
+ *@note     调用后被移动的节点上的迭代器失效，迭代器只在两次调用之间有效
+ *@note     每轮开始（或列表被修改后重新开始）时额外沿 free_list 标记一次空闲节点，
+ *          完成时额外重建一次 free_list
+ */
+bool list_compact_step(list_compact_t *state, uint16_t budget)
+{
+	if (state == NULL || state->list == NULL)
+		return true;
+
+	list_handle_t list = state->list;
+	LIST_LOCK(list);
+
+	if (!state->started)
+		list_compact_restart(state);
+
+	bool done = list_compact_run(state, budget, true);
+	if (done)
+	{
+		list_remove_observer(list, &state->observer);
+		state->list = NULL;
+	}
+
+	LIST_UNLOCK(list);
+	return done;
+}
+
+/**
+ *@brief    放弃增量整理，注销观察者
+ *@note     已经完成的移动保持有效，列表始终处于一致状态
+ */
+void list_compact_end(list_compact_t *state)
+{
+	if (state == NULL || state->list == NULL)
+		return;
+
+	list_remove_observer(state->list, &state->observer);
+	state->list = NULL;
+}
+
+/**
+ *@brief    计算列表的碎片程度
+ *@param    list 列表指针
+ *@return   列表中相邻的元素在节点池中不相邻的比例（0~100），0 表示列表顺序与槽位顺序完全一致
+ *@note     时间复杂度O(n)
+ */
+uint8_t list_fragmentation(list_handle_t list)
+{
+	if (list == NULL)
+		return 0;
+
+	LIST_LOCK(list);
+
+	if (list->size < 2)
+	{
+		LIST_UNLOCK(list);
+		return 0;
+	}
+
+	size_t node_size = LIST_NODE_SIZE(list->element_size);
+	uint32_t breaks = 0;
+	for (list_node_t *node = list->head; node->next != NULL; node = node->next)
+	{
+		if ((uint8_t *)node->next != (uint8_t *)node + node_size)
+			breaks++;
+	}
+	uint8_t percent = (uint8_t)(breaks * 100 / (list->size - 1));
+
+	LIST_UNLOCK(list);
+	return percent;
+}
+
+// ========================= 变更观察者 =========================
+/**
+ *@brief    注册变更观察者
+ *@param    list 列表指针
+ *@param    observer 观察者，存储空间由调用者提供，注销前必须保持有效
+ *@return   是否注册成功
+ *@note     观察者在列表锁内被调用，回调中不能再修改该列表
+ */
+bool list_add_observer(list_handle_t list, list_observer_t *observer)
+{
+	if (list == NULL || observer == NULL || observer->callback == NULL)
+		return false;
+
+	LIST_LOCK(list);
+	observer->next = list->observers;
+	list->observers = observer;
+	LIST_UNLOCK(list);
+	return true;
+}
+
+bool list_remove_observer(list_handle_t list, list_observer_t *observer)
+{
+	if (list == NULL || observer == NULL)
+		return false;
+
+	LIST_LOCK(list);
+
+	list_observer_t **link = &list->observers;
+	while (*link != NULL && *link != observer)
+		link = &(*link)->next;
+
+	bool found = (*link != NULL);
+	if (found)
+	{
+		*link = observer->next;
+		observer->next = NULL;
+	}
+
+	LIST_UNLOCK(list);
+	return found;
+}
+
+/**
+ *@brief    向所有观察者通知变更事件
+ *@param    list 列表指针
+ *@param    event 事件类型
+ *@param    node 相关节点，整体事件时为NULL
+ *@note     库内部在每次变更时调用；直接修改列表结构的扩展模块（如 list_save）也需要调用
+ */
+void list_notify(list_handle_t list, list_event_t event, list_iterator_t node)
+{
+	if (list == NULL)
+		return;
+
+	for (list_observer_t *observer = list->observers; observer != NULL; observer = observer->next)
+	{
+		observer->callback(list, event, node, observer->ctx);
+	}
+}
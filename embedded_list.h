@@ -84,7 +84,18 @@ typedef void *list_mutex_t;
 #define LIST_MUTEX_DESTROY(mutex) (0)
 #endif
 
+// 无效的节点池槽位索引
+#define LIST_INVALID_SLOT 0xFFFF
+
+// 遍历（查找、条件删除、for_each）时提前预取的节点跳数，为0时不预取
+#ifndef LIST_PREFETCH_DISTANCE
+#define LIST_PREFETCH_DISTANCE 4
+#endif
+
 // ========================= 链表结构定义 =========================
+struct list_t;
+struct list_observer_t;
+
 typedef struct list_node_t
 {
 	struct list_node_t *next;  // 指向下一个节点
@@ -92,7 +103,7 @@ typedef struct list_node_t
 	uint8_t data[];            // 嵌入的数据（灵活数组成员）
 } list_node_t;
 
-typedef struct
+typedef struct list_t
 {
 	list_node_t *head;       // 头节点指针
 	list_node_t *tail;       // 尾节点指针
@@ -102,20 +113,79 @@ typedef struct
 	list_node_t *free_list;  // 空闲节点链表
 	list_node_t *node_pool;  // 节点池
 	bool is_static;          // 是否为静态分配
+	bool is_ring;            // 环形缓冲模式：满时 list_push_back 覆盖最旧的元素
 	list_mutex_t mutex;      // 线程安全互斥锁
+	struct list_t *pool_owner;  // 共享节点池的所有者，NULL表示节点池属于自己
+	uint16_t pool_users;        // 共享本列表节点池的其他列表数量
+	struct list_observer_t *observers;  // 变更观察者链表（索引等扩展模块使用）
+	uint32_t *live_map;         // 活动槽位位图（可选），NULL表示未启用，只属于节点池所有者
+	bool live_map_static;       // 位图是否由外部提供
 } list_t;
 
+// 活动槽位位图需要的 uint32_t 个数
+#define LIST_LIVE_MAP_WORDS(capacity) (((uint32_t)(capacity) + 31) / 32)
+
+// 静态分配时节点池缓冲区需要的字节数（与库内部的节点大小和4字节对齐规则一致）
+#define LIST_POOL_BUF_SIZE(capacity, element_size) \
+	((size_t)(capacity) * ((sizeof(list_node_t) + ((element_size) > 0 ? (size_t)(element_size) : 1) + 3) & ~(size_t)3))
+
 typedef list_t *list_handle_t;         // 链表句柄
 typedef list_node_t *list_iterator_t;  // 迭代器
 
 // 比较函数类型
 typedef bool (*list_predicate_func_t)(const void *list_data, const void *predicate_data);
 typedef void (*list_foreach_func_t)(list_iterator_t it, void *user_data);
+// 三路比较函数类型：a < b 返回负数，a == b 返回0，a > b 返回正数
+typedef int (*list_compare_func_t)(const void *a, const void *b);
+
+// ========================= 变更观察者 =========================
+// 列表变更事件，观察者在列表锁内被调用
+typedef enum
+{
+	LIST_EVENT_LINK,           // 节点已链接到列表（新增元素）
+	LIST_EVENT_UNLINK,         // 节点即将从列表中移除，数据仍然有效
+	LIST_EVENT_BEFORE_UPDATE,  // 节点数据即将被覆盖
+	LIST_EVENT_UPDATE,         // 节点数据已被覆盖
+	LIST_EVENT_REORDER,        // 节点顺序整体改变，元素集合不变（node 为NULL）
+	LIST_EVENT_RESET,          // 列表内容整体改变（node 为NULL），观察者需要根据当前列表重建
+} list_event_t;
+
+typedef void (*list_observer_func_t)(list_handle_t list, list_event_t event, list_iterator_t node, void *ctx);
+// 可选的查找加速函数：返回与 value 完全相同的元素，不存在时返回NULL
+typedef list_iterator_t (*list_lookup_func_t)(list_handle_t list, const void *value, void *ctx);
+
+/**
+ * @brief 变更观察者，存储空间由调用者（扩展模块）提供
+ * @note  callback 接收变更事件；lookup 非NULL时 list_find/list_contains/list_remove 使用它代替线性扫描
+ */
+typedef struct list_observer_t
+{
+	list_observer_func_t callback;  // 变更回调
+	list_lookup_func_t lookup;      // 查找加速（可选）
+	void *ctx;                      // 回调上下文
+	struct list_observer_t *next;   // 下一个观察者（由库维护）
+} list_observer_t;
+
+/**
+ * @brief 增量整理节点池的状态，存储空间由调用者提供
+ * @note  由 list_compact_begin 初始化，成员由库维护
+ */
+typedef struct
+{
+	list_handle_t list;        // 正在整理的列表，整理完成后为NULL
+	list_node_t *cursor;       // 下一个要放置的节点
+	uint16_t slot;             // cursor 的目标槽位
+	bool started;              // 当前一轮整理是否有效（列表被修改后需要从头开始）
+	bool moving;               // 正在移动节点，忽略自身产生的变更事件
+	list_observer_t observer;  // 注册到列表上的观察者
+} list_compact_t;
 
 // ========================= 创建和销毁 =========================
 list_handle_t list_create(uint16_t capacity, uint16_t element_size);
 list_handle_t list_create_from_buf(void *data_buf, uint16_t capacity, uint16_t element_size);
+list_handle_t list_create_shared(list_handle_t owner);
 void list_free(list_handle_t list);
+void list_set_ring_mode(list_handle_t list, bool enable);
 
 // ========================= 容量查询 =========================
 bool list_empty(list_handle_t list);
@@ -133,30 +203,62 @@ list_iterator_t list_prev(list_iterator_t it);
 list_iterator_t list_at(list_handle_t list, int16_t index);
 void *list_get(list_handle_t list, int16_t index);
 int16_t list_index(list_handle_t list, list_iterator_t it);
+uint16_t list_node_slot(list_handle_t list, list_iterator_t it);
+list_iterator_t list_slot_node(list_handle_t list, uint16_t slot);
 
 // ========================= 修改操作 =========================
 void list_clear(list_handle_t list);
 bool list_insert(list_handle_t list, list_iterator_t position, const void *element);
 bool list_erase(list_handle_t list, list_iterator_t position);
+bool list_erase_range(list_handle_t list, list_iterator_t first, list_iterator_t last, uint16_t *erased);
+uint16_t list_truncate_front(list_handle_t list, uint16_t n);
+uint16_t list_truncate_back(list_handle_t list, uint16_t n);
 bool list_replace(list_handle_t list, list_iterator_t position, const void *element);
 bool list_push_front(list_handle_t list, const void *element);
 bool list_push_back(list_handle_t list, const void *element);
+bool list_push_back_ring(list_handle_t list, const void *element, void *evicted, bool *overwritten);
 bool list_pop_front(list_handle_t list, void *element);
 bool list_pop_back(list_handle_t list, void *element);
-void list_swap(list_handle_t list1, list_handle_t list2);
+bool list_swap(list_handle_t list1, list_handle_t list2);
 
 // ========================= 列表专有操作 =========================
 bool list_splice(list_handle_t list1, list_iterator_t position, list_handle_t list2, list_iterator_t first, list_iterator_t last);
+bool list_splice_n(list_handle_t list1, list_iterator_t position, list_handle_t list2, list_iterator_t first, list_iterator_t last, uint16_t count);
 bool list_merge(list_handle_t list1, list_handle_t list2);
+bool list_move_before(list_handle_t list, list_iterator_t node, list_iterator_t position);
+bool list_move_to_front(list_handle_t list, list_iterator_t node);
+bool list_move_to_back(list_handle_t list, list_iterator_t node);
+bool list_swap_nodes(list_handle_t list, list_iterator_t a, list_iterator_t b);
 uint16_t list_remove(list_handle_t list, const void *value);
 uint16_t list_remove_if(list_handle_t list, list_predicate_func_t predicate, const void *predicate_data);
 void list_reverse(list_handle_t list);
 uint16_t list_unique(list_handle_t list);
+list_iterator_t list_partition(list_handle_t list, list_predicate_func_t predicate, const void *predicate_data);
+list_iterator_t list_nth_element(list_handle_t list, uint16_t n, list_compare_func_t compare);
 
 // ========================= 工具函数 =========================
 list_iterator_t list_find(list_handle_t list, const void *value);
 list_iterator_t list_find_if(list_handle_t list, list_iterator_t start, list_predicate_func_t predicate, const void *value);
 void list_for_each_if(list_handle_t list, list_foreach_func_t callback, void *user_data);
+void list_for_each_unordered(list_handle_t list, list_foreach_func_t callback, void *user_data);
 bool list_contains(list_handle_t list, const void *value);
 
+// ========================= 活动槽位位图 =========================
+bool list_enable_live_map(list_handle_t list, uint32_t *map_buf);
+void list_disable_live_map(list_handle_t list);
+void list_rebuild_live_map(list_handle_t list);
+void list_scan_pool(list_handle_t list, list_foreach_func_t callback, void *user_data);
+
+// ========================= 节点池整理 =========================
+bool list_compact(list_handle_t list);
+bool list_compact_begin(list_handle_t list, list_compact_t *state);
+bool list_compact_step(list_compact_t *state, uint16_t budget);
+void list_compact_end(list_compact_t *state);
+uint8_t list_fragmentation(list_handle_t list);
+
+// ========================= 变更观察者 =========================
+bool list_add_observer(list_handle_t list, list_observer_t *observer);
+bool list_remove_observer(list_handle_t list, list_observer_t *observer);
+void list_notify(list_handle_t list, list_event_t event, list_iterator_t node);
+
 #endif
\ No newline at end of file
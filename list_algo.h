@@ -0,0 +1,165 @@
+/**
+ * @file list_algo.h
+ * @brief Embedded-List: 不经过回调函数的批量算法（宏）
+ *
+ * list_for_each_if 对每个节点调用一次函数指针，编译器无法内联回调，
+ * 也就无法把循环体和遍历放在一起优化。这里的宏把循环体直接展开在调用处，
+ * 元素按值（x 为 type 类型的局部变量）交给表达式，编译器可以看到完整的循环，
+ * 元素内部有数组字段时循环体还可以向量化。
+ *
+ * - 所有宏都在列表锁内按链表顺序遍历一次，list 为NULL时不做任何事
+ * - 表达式中可以使用元素变量和外部变量，但不能调用同一列表的修改接口
+ * - 表达式参数位于最后，可以包含逗号
+ * - 元素按值复制，适合较小的元素；几十字节以上的结构体复制开销可能超过省下的函数调用
+ *
+ * 示例：
+ * @code
+ *   int sum = 0;
+ *   LIST_ACCUMULATE(list, sample_t, s, sum, s.value);
+ *   uint16_t alarms = 0;
+ *   LIST_COUNT_IF(list, sample_t, s, alarms, s.value > limit);
+ * @endcode
+ *
+ * @author DAI
+ * @date 2025-12-30
+ * @license MIT
+ */
+
+#ifndef __LIST_ALGO_H__
+#define __LIST_ALGO_H__
+
+#include "embedded_list.h"
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIST_ALGO_PREFETCH(addr) __builtin_prefetch((addr), 0, 1)
+#else
+#define LIST_ALGO_PREFETCH(addr) ((void)(addr))
+#endif
+
+// 内部使用：按链表顺序把每个元素复制到 type 类型的局部变量 x 中，然后执行 body
+// 节点数据只保证4字节对齐，使用 memcpy 读取，编译器会把它优化为普通的加载指令
+// 与库内的遍历一样，预取游标领先当前节点 LIST_PREFETCH_DISTANCE 跳
+#define LIST_ALGO_LOOP_(list, type, x, body)                                                              \
+	do                                                                                                    \
+	{                                                                                                     \
+		list_handle_t list_algo_list_ = (list);                                                           \
+		if (list_algo_list_ == NULL)                                                                      \
+			break;                                                                                        \
+		(void)LIST_MUTEX_LOCK(list_algo_list_->mutex);                                                    \
+		list_iterator_t list_algo_ahead_ = list_algo_list_->head;                                         \
+		for (int list_algo_i_ = 0; list_algo_i_ < LIST_PREFETCH_DISTANCE && list_algo_ahead_ != NULL;     \
+		     list_algo_i_++)                                                                              \
+		{                                                                                                 \
+			LIST_ALGO_PREFETCH(list_algo_ahead_);                                                         \
+			list_algo_ahead_ = list_algo_ahead_->next;                                                    \
+		}                                                                                                 \
+		for (list_iterator_t list_algo_it_ = list_algo_list_->head; list_algo_it_ != NULL;                \
+		     list_algo_it_ = list_algo_it_->next)                                                         \
+		{                                                                                                 \
+			if (list_algo_ahead_ != NULL)                                                                 \
+			{                                                                                             \
+				LIST_ALGO_PREFETCH(list_algo_ahead_);                                                     \
+				list_algo_ahead_ = list_algo_ahead_->next;                                                \
+			}                                                                                             \
+			type x;                                                                                       \
+			memcpy(&x, list_algo_it_->data, sizeof(type));                                                \
+			body                                                                                          \
+		}                                                                                                 \
+		(void)LIST_MUTEX_UNLOCK(list_algo_list_->mutex);                                                  \
+	} while (0)
+
+/**
+ * @brief 归约：对每个元素 x 执行 acc = (expr)
+ * @param list 列表句柄
+ * @param type 元素类型
+ * @param x 元素变量名
+ * @param acc 累积变量（需要事先初始化）
+ * @note 例如 LIST_REDUCE(list, int, x, hash, hash * 31 + x)
+ */
+#define LIST_REDUCE(list, type, x, acc, ...) \
+	LIST_ALGO_LOOP_(list, type, x, { acc = (__VA_ARGS__); })
+
+/**
+ * @brief 累加：对每个元素 x 执行 acc += (expr)
+ * @note 例如 LIST_ACCUMULATE(list, sample_t, s, total, s.value)
+ */
+#define LIST_ACCUMULATE(list, type, x, acc, ...) \
+	LIST_ALGO_LOOP_(list, type, x, { acc += (__VA_ARGS__); })
+
+/**
+ * @brief 条件计数：对满足 (cond) 的每个元素 x 执行 count++
+ * @note count 需要事先初始化
+ */
+#define LIST_COUNT_IF(list, type, x, count, ...) \
+	LIST_ALGO_LOOP_(list, type, x, { if (__VA_ARGS__) (count)++; })
+
+/**
+ * @brief 原地变换：用 (expr) 的结果覆盖每个元素 x
+ * @note 列表上注册了观察者（索引等）时会为每个元素发出 BEFORE_UPDATE/UPDATE 事件，
+ *       没有观察者时循环中不包含任何函数调用
+ * @note 例如 LIST_TRANSFORM_INPLACE(list, int, x, x * 2)
+ */
+#define LIST_TRANSFORM_INPLACE(list, type, x, ...)                                   \
+	LIST_ALGO_LOOP_(list, type, x, {                                                 \
+		x = (__VA_ARGS__);                                                           \
+		if (list_algo_list_->observers != NULL)                                      \
+		{                                                                            \
+			list_notify(list_algo_list_, LIST_EVENT_BEFORE_UPDATE, list_algo_it_);   \
+			memcpy(list_algo_it_->data, &x, sizeof(type));                           \
+			list_notify(list_algo_list_, LIST_EVENT_UPDATE, list_algo_it_);          \
+		}                                                                            \
+		else                                                                         \
+		{                                                                            \
+			memcpy(list_algo_it_->data, &x, sizeof(type));                           \
+		}                                                                            \
+	})
+
+/**
+ * @brief 同时查找最小和最大元素
+ * @param list 列表句柄
+ * @param type 元素类型
+ * @param a 比较表达式中左侧元素的变量名
+ * @param b 比较表达式中右侧元素的变量名
+ * @param min_it 输出最小元素的迭代器（列表为空时为NULL）
+ * @param max_it 输出最大元素的迭代器（列表为空时为NULL）
+ * @note 最后的参数为 a < b 的表达式；有多个相同的最小（最大）元素时返回链表中第一个
+ * @note 例如 LIST_MIN_MAX(list, sample_t, a, b, lo, hi, a.value < b.value)
+ */
+#define LIST_MIN_MAX(list, type, a, b, min_it, max_it, ...)      \
+	do                                                           \
+	{                                                            \
+		type list_algo_min_, list_algo_max_;                     \
+		memset(&list_algo_min_, 0, sizeof(type));                \
+		memset(&list_algo_max_, 0, sizeof(type));                \
+		(min_it) = NULL;                                         \
+		(max_it) = NULL;                                         \
+		LIST_ALGO_LOOP_(list, type, list_algo_x_, {              \
+			if ((min_it) == NULL)                                \
+			{                                                    \
+				(min_it) = (max_it) = list_algo_it_;             \
+				list_algo_min_ = list_algo_max_ = list_algo_x_;  \
+				continue;                                        \
+			}                                                    \
+			{                                                    \
+				type a = list_algo_x_;                           \
+				type b = list_algo_min_;                         \
+				if (__VA_ARGS__)                                 \
+				{                                                \
+					(min_it) = list_algo_it_;                    \
+					list_algo_min_ = list_algo_x_;               \
+				}                                                \
+			}                                                    \
+			{                                                    \
+				type a = list_algo_max_;                         \
+				type b = list_algo_x_;                           \
+				if (__VA_ARGS__)                                 \
+				{                                                \
+					(max_it) = list_algo_it_;                    \
+					list_algo_max_ = list_algo_x_;               \
+				}                                                \
+			}                                                    \
+		});                                                      \
+	} while (0)
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file list_crc.h
+ * @brief Embedded-List: CRC32C（Castagnoli）校验
+ *
+ * 用于持久化数据的完整性检查。支持 SSE4.2 或 ARMv8 CRC 指令时使用硬件指令，
+ * 否则使用 slicing-by-8 查表（8KB 常量表，可以放在 Flash 中）。
+ * x86 上用 GCC/Clang 编译时即使没有 -msse4.2 也会在运行时检测 CPU 并选择硬件指令。
+ *
+ * @author DAI
+ * @date 2025-12-30
+ * @license MIT
+ */
+
+#ifndef __LIST_CRC_H__
+#define __LIST_CRC_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief 计算 CRC32C
+ * @param crc 上一段数据的结果，第一段为0（可以分段计算：crc = list_crc32c(crc, part, n)）
+ * @param data 数据
+ * @param size 字节数
+ * @return CRC32C，"123456789" 的结果为 0xE3069283
+ */
+uint32_t list_crc32c(uint32_t crc, const void *data, size_t size);
+
+/**
+ * @brief 只使用查表法计算 CRC32C，结果与 list_crc32c 相同
+ */
+uint32_t list_crc32c_table_only(uint32_t crc, const void *data, size_t size);
+
+/**
+ * @brief list_crc32c 是否使用了硬件指令
+ */
+bool list_crc32c_accelerated(void);
+
+#endif
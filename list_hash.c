@@ -0,0 +1,295 @@
+#include "list_hash.h"
+#include <string.h>
+
+#define LIST_LOCK(list) LIST_MUTEX_LOCK((list)->mutex)
+#define LIST_UNLOCK(list) LIST_MUTEX_UNLOCK((list)->mutex)
+
+// 从元素中取出键，返回指向键的指针（偏移模式下直接指向元素内部）
+static inline const uint8_t *list_hash_key(list_hash_handle_t index, const void *element, uint8_t *buf)
+{
+	if (index->key_func == NULL)
+		return (const uint8_t *)element + index->key_offset;
+
+	index->key_func(element, buf);
+	return buf;
+}
+
+// FNV-1a
+static inline uint32_t list_hash_bytes(const uint8_t *key, uint16_t length)
+{
+	uint32_t hash = 2166136261u;
+	for (uint16_t i = 0; i < length; i++)
+	{
+		hash ^= key[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static inline uint32_t list_hash_home(list_hash_handle_t index, const void *element)
+{
+	uint8_t buf[LIST_HASH_MAX_KEY_SIZE];
+	return list_hash_bytes(list_hash_key(index, element, buf), index->key_length) & index->mask;
+}
+
+static inline list_iterator_t list_hash_node(list_hash_handle_t index, uint32_t i)
+{
+	return list_slot_node(index->list, index->table[i]);
+}
+
+static void list_hash_insert(list_hash_handle_t index, list_iterator_t node)
+{
+	uint32_t i = list_hash_home(index, node->data);
+	while (index->table[i] != LIST_INVALID_SLOT)
+		i = (i + 1) & index->mask;
+
+	index->table[i] = list_node_slot(index->list, node);
+}
+
+// 删除表项，使用后移删除（backward shift）保持探测链连续，不需要墓碑标记
+static void list_hash_delete(list_hash_handle_t index, list_iterator_t node)
+{
+	uint16_t slot = list_node_slot(index->list, node);
+	uint32_t i = list_hash_home(index, node->data);
+	while (index->table[i] != slot)
+	{
+		if (index->table[i] == LIST_INVALID_SLOT)
+			return;
+		i = (i + 1) & index->mask;
+	}
+
+	uint32_t j = i;
+	while (true)
+	{
+		j = (j + 1) & index->mask;
+		if (index->table[j] == LIST_INVALID_SLOT)
+			break;
+
+		// 表项 j 的理想位置 k 不在 (i, j] 区间内时，可以前移到 i
+		uint32_t k = list_hash_home(index, list_hash_node(index, j)->data);
+		if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j)))
+		{
+			index->table[i] = index->table[j];
+			i = j;
+		}
+	}
+
+	index->table[i] = LIST_INVALID_SLOT;
+}
+
+static void list_hash_reset(list_hash_handle_t index)
+{
+	for (uint32_t i = 0; i <= index->mask; i++)
+		index->table[i] = LIST_INVALID_SLOT;
+
+	for (list_iterator_t it = index->list->head; it != NULL; it = it->next)
+		list_hash_insert(index, it);
+}
+
+// 按键查找，value_match 非NULL时还要求元素与其完全相同
+static list_iterator_t list_hash_lookup_key(list_hash_handle_t index, const uint8_t *key, const void *value_match)
+{
+	uint8_t buf[LIST_HASH_MAX_KEY_SIZE];
+	uint32_t i = list_hash_bytes(key, index->key_length) & index->mask;
+
+	while (index->table[i] != LIST_INVALID_SLOT)
+	{
+		list_iterator_t node = list_hash_node(index, i);
+		if (memcmp(list_hash_key(index, node->data, buf), key, index->key_length) == 0 &&
+		    (value_match == NULL || memcmp(node->data, value_match, index->list->element_size) == 0))
+			return node;
+		i = (i + 1) & index->mask;
+	}
+
+	return NULL;
+}
+
+static void list_hash_on_event(list_handle_t list, list_event_t event, list_iterator_t node, void *ctx)
+{
+	list_hash_handle_t index = (list_hash_handle_t)ctx;
+	(void)list;
+
+	switch (event)
+	{
+	case LIST_EVENT_LINK:
+	case LIST_EVENT_UPDATE:
+		list_hash_insert(index, node);
+		break;
+	case LIST_EVENT_UNLINK:
+	case LIST_EVENT_BEFORE_UPDATE:
+		list_hash_delete(index, node);
+		break;
+	case LIST_EVENT_RESET:
+		list_hash_reset(index);
+		break;
+	default:
+		// 顺序变化不影响索引
+		break;
+	}
+}
+
+// list_find 等接口的查找加速：value 为完整元素
+static list_iterator_t list_hash_on_lookup(list_handle_t list, const void *value, void *ctx)
+{
+	list_hash_handle_t index = (list_hash_handle_t)ctx;
+	uint8_t buf[LIST_HASH_MAX_KEY_SIZE];
+	(void)list;
+
+	return list_hash_lookup_key(index, list_hash_key(index, value, buf), value);
+}
+
+/**
+ * @brief 为链表创建哈希索引（动态分配哈希表）
+ * @param list 被索引的链表
+ * @param key_offset 键在元素中的偏移
+ * @param key_length 键长度
+ * @return 索引句柄，失败返回NULL
+ * @note 创建时会为已有元素建立索引
+ */
+list_hash_handle_t list_hash_create(list_handle_t list, uint16_t key_offset, uint16_t key_length)
+{
+	if (list == NULL)
+		return NULL;
+
+	uint32_t table_count = LIST_HASH_TABLE_COUNT(list->capacity);
+	uint16_t *table = (uint16_t *)malloc(table_count * sizeof(uint16_t));
+	if (table == NULL)
+		return NULL;
+
+	list_hash_handle_t index = list_hash_create_from_buf(list, key_offset, key_length, table, table_count);
+	if (index == NULL)
+	{
+		free(table);
+		return NULL;
+	}
+
+	index->is_static = false;
+	return index;
+}
+
+list_hash_handle_t list_hash_create_from_buf(list_handle_t list, uint16_t key_offset, uint16_t key_length,
+                                             uint16_t *table_buf, uint32_t table_count)
+{
+	if (list == NULL || table_buf == NULL || key_length == 0 || key_length > LIST_HASH_MAX_KEY_SIZE ||
+	    (uint32_t)key_offset + key_length > list->element_size)
+		return NULL;
+
+	// 取不超过 table_count 的最大2的幂
+	uint32_t table_size = 1;
+	while (table_size * 2 <= table_count)
+		table_size *= 2;
+	if (table_size <= list->capacity)
+		return NULL;
+
+	list_hash_handle_t index = (list_hash_handle_t)malloc(sizeof(list_hash_t));
+	if (index == NULL)
+		return NULL;
+
+	index->list = list;
+	index->table = table_buf;
+	index->mask = table_size - 1;
+	index->key_offset = key_offset;
+	index->key_length = key_length;
+	index->key_func = NULL;
+	index->is_static = true;
+	index->observer.callback = list_hash_on_event;
+	index->observer.lookup = list_hash_on_lookup;
+	index->observer.ctx = index;
+	index->observer.next = NULL;
+
+	LIST_LOCK(list);
+	list_hash_reset(index);
+	list_add_observer(list, &index->observer);
+	LIST_UNLOCK(list);
+
+	return index;
+}
+
+/**
+ * @brief 使用回调函数提取键
+ * @param index 索引句柄
+ * @param key_func 键提取函数，为NULL时恢复为偏移和长度方式
+ * @param key_length 提取出的键长度，不能超过 LIST_HASH_MAX_KEY_SIZE
+ * @return 是否设置成功
+ * @note 设置后会重建索引
+ */
+bool list_hash_set_key_func(list_hash_handle_t index, list_key_func_t key_func, uint16_t key_length)
+{
+	if (index == NULL || key_length == 0 || key_length > LIST_HASH_MAX_KEY_SIZE)
+		return false;
+
+	LIST_LOCK(index->list);
+	index->key_func = key_func;
+	index->key_length = key_length;
+	list_hash_reset(index);
+	LIST_UNLOCK(index->list);
+	return true;
+}
+
+void list_hash_free(list_hash_handle_t index)
+{
+	if (index == NULL)
+		return;
+
+	list_remove_observer(index->list, &index->observer);
+	if (!index->is_static)
+		free(index->table);
+	free(index);
+}
+
+/**
+ * @brief 按键查找元素
+ * @param index 索引句柄
+ * @param key 键（key_length 字节）
+ * @return 键相同的元素，不存在时返回NULL；有多个时返回其中任意一个
+ * @note O(1)期望时间
+ */
+list_iterator_t list_hash_find(list_hash_handle_t index, const void *key)
+{
+	if (index == NULL || key == NULL)
+		return NULL;
+
+	LIST_LOCK(index->list);
+	list_iterator_t it = list_hash_lookup_key(index, (const uint8_t *)key, NULL);
+	LIST_UNLOCK(index->list);
+	return it;
+}
+
+/**
+ * @brief 删除键相同的所有元素
+ * @param index 索引句柄
+ * @param key 键（key_length 字节）
+ * @return 删除的元素数量
+ */
+uint16_t list_hash_remove(list_hash_handle_t index, const void *key)
+{
+	if (index == NULL || key == NULL)
+		return 0;
+
+	LIST_LOCK(index->list);
+
+	uint16_t remove_count = 0;
+	list_iterator_t it;
+	while ((it = list_hash_lookup_key(index, (const uint8_t *)key, NULL)) != NULL)
+	{
+		list_erase(index->list, it);
+		remove_count++;
+	}
+
+	LIST_UNLOCK(index->list);
+	return remove_count;
+}
+
+/**
+ * @brief 重建索引
+ * @note 直接修改了节点数据（例如通过 it->data 写入键字段）后需要调用
+ */
+void list_hash_rebuild(list_hash_handle_t index)
+{
+	if (index == NULL)
+		return;
+
+	LIST_LOCK(index->list);
+	list_hash_reset(index);
+	LIST_UNLOCK(index->list);
+}
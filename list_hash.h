@@ -0,0 +1,73 @@
+/**
+ * @file list_hash.h
+ * @brief Embedded-List: 挂接在链表上的哈希索引
+ *
+ * 为链表元素建立按键查找的开放寻址哈希表（线性探测，表项为节点槽位索引）。
+ * 索引作为变更观察者注册到链表上，由插入、删除、替换、拼接、清空等操作自动维护，
+ * 链表的遍历顺序保持不变。
+ *
+ * - 键可以是元素中的一段字节（偏移 + 长度），也可以由回调函数从元素中提取
+ * - 挂接索引后 list_find / list_contains / list_remove 变为O(1)期望时间
+ * - 哈希表可以由外部缓冲区提供，适合无动态内存的系统
+ *
+ * @author DAI
+ * @date 2025-12-30
+ * @license MIT
+ */
+
+#ifndef __LIST_HASH_H__
+#define __LIST_HASH_H__
+
+#include "embedded_list.h"
+
+// 键的最大长度（字节），使用回调提取键时键值保存在栈上的缓冲区中
+#ifndef LIST_HASH_MAX_KEY_SIZE
+#define LIST_HASH_MAX_KEY_SIZE 32
+#endif
+
+/**
+ * @brief 推荐的哈希表表项数量（uint16_t 个数）
+ * @note 实际使用不超过缓冲区表项数量的最大2的幂，4倍容量保证负载因子低于0.5
+ */
+#define LIST_HASH_TABLE_COUNT(capacity) (4 * (uint32_t)(capacity))
+
+// 键提取函数：从元素中提取 key_length 字节的键写入 key
+typedef void (*list_key_func_t)(const void *element, void *key);
+
+typedef struct
+{
+	list_handle_t list;        // 被索引的链表
+	uint16_t *table;           // 哈希表，表项为槽位索引，LIST_INVALID_SLOT 表示空
+	uint32_t mask;             // 表大小 - 1（表大小为2的幂）
+	uint16_t key_offset;       // 键在元素中的偏移
+	uint16_t key_length;       // 键长度
+	list_key_func_t key_func;  // 键提取函数，为NULL时使用偏移和长度
+	list_observer_t observer;  // 注册到链表上的观察者
+	bool is_static;            // 哈希表是否由外部提供
+} list_hash_t;
+
+typedef list_hash_t *list_hash_handle_t;
+
+// ========================= 创建和销毁 =========================
+list_hash_handle_t list_hash_create(list_handle_t list, uint16_t key_offset, uint16_t key_length);
+
+/**
+ * @brief 使用外部缓冲区作为哈希表创建索引
+ * @param list 被索引的链表
+ * @param key_offset 键在元素中的偏移
+ * @param key_length 键长度
+ * @param table_buf 哈希表缓冲区
+ * @param table_count 缓冲区表项数量，推荐 LIST_HASH_TABLE_COUNT(capacity)，必须大于 capacity
+ * @return 索引句柄，失败返回NULL
+ */
+list_hash_handle_t list_hash_create_from_buf(list_handle_t list, uint16_t key_offset, uint16_t key_length,
+                                             uint16_t *table_buf, uint32_t table_count);
+bool list_hash_set_key_func(list_hash_handle_t index, list_key_func_t key_func, uint16_t key_length);
+void list_hash_free(list_hash_handle_t index);
+
+// ========================= 按键操作 =========================
+list_iterator_t list_hash_find(list_hash_handle_t index, const void *key);
+uint16_t list_hash_remove(list_hash_handle_t index, const void *key);
+void list_hash_rebuild(list_hash_handle_t index);
+
+#endif
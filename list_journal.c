@@ -0,0 +1,470 @@
+#include "list_journal.h"
+#include "list_save.h"
+#include <string.h>
+
+#define LIST_LOCK(list) LIST_MUTEX_LOCK((list)->mutex)
+#define LIST_UNLOCK(list) LIST_MUTEX_UNLOCK((list)->mutex)
+
+// 记录头部的线上布局检查，编译器插入填充时编译失败
+typedef char list_journal_layout_check[(sizeof(list_journal_record_t) == LIST_JOURNAL_RECORD_HEADER_SIZE) ? 1 : -1];
+
+// 把缓冲区中的记录交给写入回调，再调用同步回调
+static bool list_journal_flush(list_journal_handle_t journal)
+{
+	if (journal->config.write == NULL || journal->used == 0)
+		return true;
+
+	bool ok = journal->config.write(journal->buffer, journal->used, journal->config.ctx);
+	if (ok && journal->config.sync != NULL)
+		ok = journal->config.sync(journal->config.ctx);
+
+	journal->used = 0;
+	journal->pending = 0;
+	journal->commits++;
+	if (!ok)
+		journal->failed = true;
+	return ok;
+}
+
+// 为一条 size 字节的记录预留缓冲区空间，放不下时先提交；返回NULL表示记录丢失
+static uint8_t *list_journal_reserve(list_journal_handle_t journal, uint32_t size)
+{
+	if (journal->buffer_size - journal->used < size)
+		list_journal_flush(journal);
+
+	if (journal->buffer_size - journal->used < size)
+	{
+		journal->failed = true;
+		return NULL;
+	}
+
+	uint8_t *ptr = journal->buffer + journal->used;
+	journal->used += size;
+	return ptr;
+}
+
+static void list_journal_put_header(uint8_t *ptr, list_journal_op_t op, uint16_t slot, uint16_t aux, uint16_t next)
+{
+	list_journal_record_t record = {(uint8_t)op, 0, list_le16(slot), list_le16(aux), list_le16(next)};
+	memcpy(ptr, &record, LIST_JOURNAL_RECORD_HEADER_SIZE);
+}
+
+// 记录写入后按提交策略决定是否提交
+static void list_journal_finish_record(list_journal_handle_t journal)
+{
+	journal->records++;
+	journal->pending++;
+	if (journal->config.group_records != 0 && journal->pending >= journal->config.group_records)
+		list_journal_flush(journal);
+}
+
+static void list_journal_append(list_journal_handle_t journal, list_journal_op_t op, list_iterator_t node, bool with_data)
+{
+	list_handle_t list = journal->list;
+	uint32_t size = LIST_JOURNAL_RECORD_HEADER_SIZE + (with_data ? list->element_size : 0);
+	uint8_t *ptr = list_journal_reserve(journal, size);
+	if (ptr == NULL)
+		return;
+
+	uint16_t prev = (op == LIST_JOURNAL_INSERT) ? list_node_slot(list, node->prev) : LIST_INVALID_SLOT;
+	uint16_t next = (op == LIST_JOURNAL_INSERT) ? list_node_slot(list, node->next) : LIST_INVALID_SLOT;
+	list_journal_put_header(ptr, op, list_node_slot(list, node), prev, next);
+	if (with_data)
+		memcpy(ptr + LIST_JOURNAL_RECORD_HEADER_SIZE, node->data, list->element_size);
+	list_journal_finish_record(journal);
+}
+
+// 记录当前的完整顺序（ORDER）或完整内容（RESET）
+static void list_journal_append_all(list_journal_handle_t journal, list_journal_op_t op)
+{
+	list_handle_t list = journal->list;
+	uint32_t entry_size = sizeof(uint16_t) + (op == LIST_JOURNAL_RESET ? list->element_size : 0);
+	uint8_t *ptr = list_journal_reserve(journal, LIST_JOURNAL_RECORD_HEADER_SIZE + entry_size * list->size);
+	if (ptr == NULL)
+		return;
+
+	list_journal_put_header(ptr, op, LIST_INVALID_SLOT, list->size, LIST_INVALID_SLOT);
+	ptr += LIST_JOURNAL_RECORD_HEADER_SIZE;
+	for (list_node_t *node = list->head; node != NULL; node = node->next)
+	{
+		list_store_le16(ptr, list_node_slot(list, node));
+		ptr += sizeof(uint16_t);
+		if (op == LIST_JOURNAL_RESET)
+		{
+			memcpy(ptr, node->data, list->element_size);
+			ptr += list->element_size;
+		}
+	}
+	list_journal_finish_record(journal);
+}
+
+static void list_journal_on_event(list_handle_t list, list_event_t event, list_iterator_t node, void *ctx)
+{
+	list_journal_handle_t journal = (list_journal_handle_t)ctx;
+	(void)list;
+
+	switch (event)
+	{
+	case LIST_EVENT_LINK:
+		list_journal_append(journal, LIST_JOURNAL_INSERT, node, true);
+		break;
+	case LIST_EVENT_UNLINK:
+		list_journal_append(journal, LIST_JOURNAL_ERASE, node, false);
+		break;
+	case LIST_EVENT_UPDATE:
+		list_journal_append(journal, LIST_JOURNAL_UPDATE, node, true);
+		break;
+	case LIST_EVENT_REORDER:
+		list_journal_append_all(journal, LIST_JOURNAL_ORDER);
+		break;
+	case LIST_EVENT_RESET:
+		list_journal_append_all(journal, LIST_JOURNAL_RESET);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief 为链表创建变更日志（动态分配日志缓冲区）
+ * @param list 被记录的链表
+ * @param buffer_size 日志缓冲区大小，至少能放下一条记录
+ * @param config 提交策略，为NULL时只记录到缓冲区
+ * @return 日志句柄，失败返回NULL
+ * @note 创建后应先保存一次完整快照，重放从该快照开始
+ */
+list_journal_handle_t list_journal_create(list_handle_t list, uint32_t buffer_size, const list_journal_config_t *config)
+{
+	if (list == NULL || buffer_size == 0)
+		return NULL;
+
+	void *buf = malloc(buffer_size);
+	if (buf == NULL)
+		return NULL;
+
+	list_journal_handle_t journal = list_journal_create_from_buf(list, buf, buffer_size, config);
+	if (journal == NULL)
+	{
+		free(buf);
+		return NULL;
+	}
+
+	journal->is_static = false;
+	return journal;
+}
+
+list_journal_handle_t list_journal_create_from_buf(list_handle_t list, void *buf, uint32_t buf_size,
+                                                   const list_journal_config_t *config)
+{
+	if (list == NULL || buf == NULL || buf_size < LIST_JOURNAL_RECORD_HEADER_SIZE + list->element_size)
+		return NULL;
+
+	list_journal_handle_t journal = (list_journal_handle_t)malloc(sizeof(list_journal_t));
+	if (journal == NULL)
+		return NULL;
+
+	memset(journal, 0, sizeof(list_journal_t));
+	journal->list = list;
+	journal->buffer = (uint8_t *)buf;
+	journal->buffer_size = buf_size;
+	if (config != NULL)
+		journal->config = *config;
+	journal->is_static = true;
+	journal->observer.callback = list_journal_on_event;
+	journal->observer.ctx = journal;
+
+	LIST_LOCK(list);
+	list_add_observer(list, &journal->observer);
+	LIST_UNLOCK(list);
+
+	return journal;
+}
+
+/**
+ * @brief 销毁日志
+ * @note 销毁前提交缓冲区中的记录
+ */
+void list_journal_free(list_journal_handle_t journal)
+{
+	if (journal == NULL)
+		return;
+
+	list_journal_commit(journal);
+	list_remove_observer(journal->list, &journal->observer);
+	if (!journal->is_static)
+		free(journal->buffer);
+	free(journal);
+}
+
+/**
+ * @brief 立即提交缓冲区中的记录（写入并同步）
+ * @return 写入和同步是否成功；没有写入回调时返回true，记录保留在缓冲区中
+ */
+bool list_journal_commit(list_journal_handle_t journal)
+{
+	if (journal == NULL)
+		return false;
+
+	LIST_LOCK(journal->list);
+	bool ok = list_journal_flush(journal);
+	LIST_UNLOCK(journal->list);
+	return ok;
+}
+
+/**
+ * @brief 获取缓冲区中尚未提交的记录
+ * @param journal 日志句柄
+ * @param size 输出记录字节数
+ * @return 记录起始地址
+ * @note 没有写入回调时用它读取日志，保存后调用 list_journal_clear
+ */
+const void *list_journal_data(list_journal_handle_t journal, uint32_t *size)
+{
+	if (journal == NULL)
+		return NULL;
+
+	if (size != NULL)
+		*size = journal->used;
+	return journal->buffer;
+}
+
+/**
+ * @brief 丢弃缓冲区中的记录并清除丢失标志
+ * @note 保存完整快照后调用，此后的日志从新快照开始重放
+ */
+void list_journal_clear(list_journal_handle_t journal)
+{
+	if (journal == NULL)
+		return;
+
+	LIST_LOCK(journal->list);
+	journal->used = 0;
+	journal->pending = 0;
+	journal->failed = false;
+	LIST_UNLOCK(journal->list);
+}
+
+/**
+ * @brief 是否有记录丢失
+ * @return 缓冲区放不下记录或写入/同步失败时返回true，此时需要重新保存完整快照
+ */
+bool list_journal_failed(list_journal_handle_t journal)
+{
+	return journal == NULL || journal->failed;
+}
+
+// ========================= 重放 =========================
+
+typedef struct
+{
+	list_handle_t list;
+	uint16_t *map;  // 日志中的槽位 -> 链表中的槽位，LIST_INVALID_SLOT 表示该槽位当前没有元素
+	bool *seen;     // 重放新顺序时检查重复槽位
+} list_journal_replay_t;
+
+static list_node_t *list_journal_replay_node(list_journal_replay_t *replay, uint16_t slot)
+{
+	if (slot >= replay->list->capacity || replay->map[slot] == LIST_INVALID_SLOT)
+		return NULL;
+	return list_slot_node(replay->list, replay->map[slot]);
+}
+
+// 重放一条记录，返回false表示记录与链表不匹配
+static bool list_journal_replay_record(list_journal_replay_t *replay, const list_journal_record_t *record,
+                                       const uint8_t *body)
+{
+	list_handle_t list = replay->list;
+	uint32_t element_size = list->element_size;
+	uint16_t slot = record->slot;
+	uint16_t aux = record->aux;
+
+	switch (record->op)
+	{
+	case LIST_JOURNAL_INSERT:
+	{
+		if (slot >= list->capacity || replay->map[slot] != LIST_INVALID_SLOT)
+			return false;
+
+		// 按前驱定位；整理节点池时相邻节点成对交换，前驱可能还没有重新插入，此时按后继定位
+		list_node_t *position;
+		list_node_t *prev = list_journal_replay_node(replay, aux);
+		list_node_t *next = list_journal_replay_node(replay, record->next);
+		if (aux == LIST_INVALID_SLOT)
+			position = list->head;
+		else if (prev != NULL)
+			position = prev->next;
+		else if (record->next == LIST_INVALID_SLOT || next != NULL)
+			position = next;
+		else
+			return false;
+		if (!list_insert(list, position, body))
+			return false;
+
+		list_node_t *node = (position != NULL) ? position->prev : list->tail;
+		replay->map[slot] = list_node_slot(list, node);
+		return true;
+	}
+	case LIST_JOURNAL_ERASE:
+	{
+		list_node_t *node = list_journal_replay_node(replay, slot);
+		if (node == NULL)
+			return false;
+		replay->map[slot] = LIST_INVALID_SLOT;
+		return list_erase(list, node);
+	}
+	case LIST_JOURNAL_UPDATE:
+	{
+		list_node_t *node = list_journal_replay_node(replay, slot);
+		return node != NULL && list_replace(list, node, body);
+	}
+	case LIST_JOURNAL_ORDER:
+	{
+		if (aux != list->size)
+			return false;
+
+		// 先检查所有槽位都有效且不重复，再修改链接
+		memset(replay->seen, 0, list->capacity * sizeof(bool));
+		for (uint16_t i = 0; i < aux; i++)
+		{
+			uint16_t entry = list_load_le16(body + (size_t)i * sizeof(uint16_t));
+			if (list_journal_replay_node(replay, entry) == NULL || replay->seen[entry])
+				return false;
+			replay->seen[entry] = true;
+		}
+
+		list_node_t *prev = NULL;
+		list_node_t *head = NULL;
+
+		for (uint16_t i = 0; i < aux; i++)
+		{
+			uint16_t entry = list_load_le16(body + (size_t)i * sizeof(uint16_t));
+			list_node_t *node = list_journal_replay_node(replay, entry);
+			node->prev = prev;
+			if (prev != NULL)
+				prev->next = node;
+			else
+				head = node;
+			prev = node;
+		}
+		if (prev != NULL)
+			prev->next = NULL;
+		list->head = head;
+		list->tail = prev;
+		list_notify(list, LIST_EVENT_REORDER, NULL);
+		return true;
+	}
+	case LIST_JOURNAL_RESET:
+	{
+		list_clear(list);
+		for (uint16_t i = 0; i < list->capacity; i++)
+			replay->map[i] = LIST_INVALID_SLOT;
+
+		const uint8_t *ptr = body;
+		for (uint16_t i = 0; i < aux; i++)
+		{
+			uint16_t entry = list_load_le16(ptr);
+			if (entry >= list->capacity || replay->map[entry] != LIST_INVALID_SLOT ||
+			    !list_push_back(list, ptr + sizeof(uint16_t)))
+				return false;
+			replay->map[entry] = list_node_slot(list, list->tail);
+			ptr += sizeof(uint16_t) + element_size;
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+/**
+ * @brief 在链表上重放日志
+ * @param list 由日志开始时的完整快照恢复（list_deserialize）的链表
+ * @param log 日志数据
+ * @param log_size 日志字节数
+ * @param replayed 输出重放的记录数（可选）
+ * @return 所有完整的记录都重放成功返回true；末尾写入不完整的记录被忽略
+ * @note 记录与链表不匹配时停止重放并返回false，此前的记录已经生效
+ * @note 共享节点池的链表不能重放日志
+ */
+bool list_journal_replay(list_handle_t list, const void *log, uint32_t log_size, uint32_t *replayed)
+{
+	if (replayed != NULL)
+		*replayed = 0;
+	if (list == NULL || (log == NULL && log_size != 0) || list->pool_owner != NULL || list->pool_users != 0)
+		return false;
+
+	list_journal_replay_t replay;
+	replay.list = list;
+	replay.map = (uint16_t *)malloc((size_t)list->capacity * sizeof(uint16_t));
+	replay.seen = (bool *)malloc((size_t)list->capacity * sizeof(bool));
+	if (replay.map == NULL || replay.seen == NULL)
+	{
+		free(replay.map);
+		free(replay.seen);
+		return false;
+	}
+
+	LIST_LOCK(list);
+
+	// 快照恢复后的槽位与日志中的槽位一致
+	for (uint16_t i = 0; i < list->capacity; i++)
+		replay.map[i] = LIST_INVALID_SLOT;
+	for (list_node_t *node = list->head; node != NULL; node = node->next)
+	{
+		uint16_t slot = list_node_slot(list, node);
+		replay.map[slot] = slot;
+	}
+
+	bool ok = true;
+	const uint8_t *ptr = (const uint8_t *)log;
+	const uint8_t *end = ptr + log_size;
+	while ((size_t)(end - ptr) >= LIST_JOURNAL_RECORD_HEADER_SIZE)
+	{
+		list_journal_record_t record;
+		memcpy(&record, ptr, LIST_JOURNAL_RECORD_HEADER_SIZE);
+		record.slot = list_le16(record.slot);
+		record.aux = list_le16(record.aux);
+		record.next = list_le16(record.next);
+
+		uint32_t body_size;
+		switch (record.op)
+		{
+		case LIST_JOURNAL_INSERT:
+		case LIST_JOURNAL_UPDATE:
+			body_size = list->element_size;
+			break;
+		case LIST_JOURNAL_ERASE:
+			body_size = 0;
+			break;
+		case LIST_JOURNAL_ORDER:
+			body_size = (uint32_t)record.aux * sizeof(uint16_t);
+			break;
+		case LIST_JOURNAL_RESET:
+			body_size = (uint32_t)record.aux * (sizeof(uint16_t) + list->element_size);
+			break;
+		default:
+			body_size = 0;
+			ok = false;
+			break;
+		}
+
+		// 末尾不完整的记录（写入时断电）不重放
+		if (!ok || (size_t)(end - ptr) - LIST_JOURNAL_RECORD_HEADER_SIZE < body_size)
+			break;
+
+		if (!list_journal_replay_record(&replay, &record, ptr + LIST_JOURNAL_RECORD_HEADER_SIZE))
+		{
+			ok = false;
+			break;
+		}
+
+		ptr += LIST_JOURNAL_RECORD_HEADER_SIZE + body_size;
+		if (replayed != NULL)
+			(*replayed)++;
+	}
+
+	LIST_UNLOCK(list);
+	free(replay.map);
+	free(replay.seen);
+	return ok;
+}
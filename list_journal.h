@@ -0,0 +1,95 @@
+/**
+ * @file list_journal.h
+ * @brief Embedded-List: 追加写入的变更日志（预写日志）
+ *
+ * 日志作为变更观察者注册到链表上，把每次插入、删除、替换等修改编码为一条紧凑的记录
+ * （操作、槽位索引、元素数据）追加到日志缓冲区，按设定的记录数成组提交给写入回调，
+ * 并可选地调用同步回调（如 fsync）。断电后用最近的完整快照（list_deserialize）加上
+ * 之后的日志重放（list_journal_replay）恢复链表。
+ *
+ * - 插入记录包含前驱和后继槽位，删除记录只有槽位，替换记录包含新数据
+ * - 顺序整体变化（反转、移动、划分等）记录为新的节点顺序，内容整体变化（清空、交换、
+ *   反序列化）记录为完整的元素列表，这两类记录较大但很少出现
+ * - 没有写入回调时日志只保存在缓冲区中，由调用者读取（list_journal_data）后清空
+ * - 重放时忽略末尾写入不完整的记录
+ *
+ * @note 提交（写入和同步回调）在触发它的修改操作中、列表锁内执行
+ *
+ * @author DAI
+ * @date 2025-12-30
+ * @license MIT
+ */
+
+#ifndef __LIST_JOURNAL_H__
+#define __LIST_JOURNAL_H__
+
+#include "embedded_list.h"
+
+// 日志记录操作
+typedef enum
+{
+	LIST_JOURNAL_INSERT = 1,  // 插入：slot 为新节点，aux/next 为前驱/后继槽位，后跟元素数据
+	LIST_JOURNAL_ERASE,       // 删除：slot 为被删除的节点
+	LIST_JOURNAL_UPDATE,      // 替换：slot 为被替换的节点，后跟新数据
+	LIST_JOURNAL_ORDER,       // 新顺序：aux 为元素数量，后跟按顺序排列的槽位
+	LIST_JOURNAL_RESET,       // 新内容：aux 为元素数量，后跟按顺序排列的（槽位、元素数据）
+} list_journal_op_t;
+
+// 日志记录头部（8字节，小端字节序，记录在日志中不保证对齐）
+typedef struct
+{
+	uint8_t op;     // list_journal_op_t
+	uint8_t flags;  // 保留，为0
+	uint16_t slot;  // 槽位索引
+	uint16_t aux;   // 前驱槽位或元素数量
+	uint16_t next;  // 后继槽位（只用于插入）
+} list_journal_record_t;
+
+#define LIST_JOURNAL_RECORD_HEADER_SIZE 8u
+
+// 写入回调：把 size 字节追加到日志存储，成功返回true
+typedef bool (*list_journal_write_func_t)(const void *data, uint32_t size, void *ctx);
+// 同步回调：把已写入的日志持久化（如 fsync），成功返回true
+typedef bool (*list_journal_sync_func_t)(void *ctx);
+
+typedef struct
+{
+	list_journal_write_func_t write;  // 写入回调，为NULL时日志只保存在缓冲区中
+	list_journal_sync_func_t sync;    // 同步回调（可选），每次提交后调用
+	void *ctx;                        // 回调上下文
+	uint16_t group_records;           // 每积累多少条记录提交一次，1 为每条记录都提交，0 为只在缓冲区满或手动提交时提交
+} list_journal_config_t;
+
+typedef struct
+{
+	list_handle_t list;             // 被记录的链表
+	uint8_t *buffer;                // 日志缓冲区
+	uint32_t buffer_size;           // 缓冲区大小
+	uint32_t used;                  // 缓冲区中未提交的字节数
+	uint16_t pending;               // 缓冲区中未提交的记录数
+	list_journal_config_t config;   // 提交策略
+	uint32_t records;               // 已记录的记录总数
+	uint32_t commits;               // 提交次数
+	bool failed;                    // 有记录丢失（缓冲区放不下或写入失败），需要重新保存完整快照
+	bool is_static;                 // 缓冲区是否由外部提供
+	list_observer_t observer;       // 注册到链表上的观察者
+} list_journal_t;
+
+typedef list_journal_t *list_journal_handle_t;
+
+// ========================= 创建和销毁 =========================
+list_journal_handle_t list_journal_create(list_handle_t list, uint32_t buffer_size, const list_journal_config_t *config);
+list_journal_handle_t list_journal_create_from_buf(list_handle_t list, void *buf, uint32_t buf_size,
+                                                   const list_journal_config_t *config);
+void list_journal_free(list_journal_handle_t journal);
+
+// ========================= 提交和读取 =========================
+bool list_journal_commit(list_journal_handle_t journal);
+const void *list_journal_data(list_journal_handle_t journal, uint32_t *size);
+void list_journal_clear(list_journal_handle_t journal);
+bool list_journal_failed(list_journal_handle_t journal);
+
+// ========================= 恢复 =========================
+bool list_journal_replay(list_handle_t list, const void *log, uint32_t log_size, uint32_t *replayed);
+
+#endif
@@ -0,0 +1,226 @@
+#include "list_lru.h"
+#include <string.h>
+
+#define LIST_LOCK(list) LIST_MUTEX_LOCK((list)->mutex)
+#define LIST_UNLOCK(list) LIST_MUTEX_UNLOCK((list)->mutex)
+
+static list_lru_handle_t list_lru_init(list_handle_t list, uint16_t *table_buf, uint32_t table_count,
+                                       uint16_t key_offset, uint16_t key_length)
+{
+	list_lru_handle_t lru = (list_lru_handle_t)malloc(sizeof(list_lru_t));
+	if (lru == NULL)
+		return NULL;
+
+	if (table_buf != NULL)
+		lru->index = list_hash_create_from_buf(list, key_offset, key_length, table_buf, table_count);
+	else
+		lru->index = list_hash_create(list, key_offset, key_length);
+
+	if (lru->index == NULL)
+	{
+		free(lru);
+		return NULL;
+	}
+
+	lru->list = list;
+	lru->on_evict = NULL;
+	lru->evict_ctx = NULL;
+	lru->hits = 0;
+	lru->misses = 0;
+	return lru;
+}
+
+list_lru_handle_t list_lru_create(uint16_t capacity, uint16_t element_size, uint16_t key_offset, uint16_t key_length)
+{
+	list_handle_t list = list_create(capacity, element_size);
+	if (list == NULL)
+		return NULL;
+
+	list_lru_handle_t lru = list_lru_init(list, NULL, 0, key_offset, key_length);
+	if (lru == NULL)
+		list_free(list);
+	return lru;
+}
+
+list_lru_handle_t list_lru_create_from_buf(void *node_pool_buf, uint16_t *table_buf, uint32_t table_count,
+                                           uint16_t capacity, uint16_t element_size,
+                                           uint16_t key_offset, uint16_t key_length)
+{
+	if (table_buf == NULL)
+		return NULL;
+
+	list_handle_t list = list_create_from_buf(node_pool_buf, capacity, element_size);
+	if (list == NULL)
+		return NULL;
+
+	list_lru_handle_t lru = list_lru_init(list, table_buf, table_count, key_offset, key_length);
+	if (lru == NULL)
+		list_free(list);
+	return lru;
+}
+
+void list_lru_free(list_lru_handle_t lru)
+{
+	if (lru == NULL)
+		return;
+
+	list_hash_free(lru->index);
+	list_free(lru->list);
+	free(lru);
+}
+
+/**
+ * @brief 设置淘汰回调
+ * @param lru LRU缓存
+ * @param on_evict 淘汰回调，为NULL时取消
+ * @param ctx 回调上下文
+ * @note 回调在列表锁内调用，回调中不能再修改同一个缓存
+ */
+void list_lru_set_evict_callback(list_lru_handle_t lru, list_lru_evict_func_t on_evict, void *ctx)
+{
+	if (lru == NULL)
+		return;
+
+	LIST_LOCK(lru->list);
+	lru->on_evict = on_evict;
+	lru->evict_ctx = ctx;
+	LIST_UNLOCK(lru->list);
+}
+
+uint16_t list_lru_size(list_lru_handle_t lru)
+{
+	return lru ? list_size(lru->list) : 0;
+}
+
+uint16_t list_lru_capacity(list_lru_handle_t lru)
+{
+	return lru ? list_capacity(lru->list) : 0;
+}
+
+/**
+ * @brief 获取命中统计
+ * @param lru LRU缓存
+ * @param hits 命中次数，不需要时传NULL
+ * @param misses 未命中次数，不需要时传NULL
+ * @note 统计 list_lru_get 的结果，list_lru_peek 不计入
+ */
+void list_lru_stats(list_lru_handle_t lru, uint32_t *hits, uint32_t *misses)
+{
+	if (hits != NULL)
+		*hits = lru ? lru->hits : 0;
+	if (misses != NULL)
+		*misses = lru ? lru->misses : 0;
+}
+
+/**
+ * @brief 按键查找元素，命中时移动到最近使用位置
+ * @param lru LRU缓存
+ * @param key 键（key_length 字节）
+ * @return 元素迭代器，未命中时返回NULL
+ * @note 命中时只修改节点链接，不复制数据；时间复杂度O(1)期望时间
+ */
+list_iterator_t list_lru_get(list_lru_handle_t lru, const void *key)
+{
+	if (lru == NULL || key == NULL)
+		return NULL;
+
+	LIST_LOCK(lru->list);
+
+	list_iterator_t it = list_hash_find(lru->index, key);
+	if (it != NULL)
+	{
+		list_move_to_front(lru->list, it);
+		lru->hits++;
+	}
+	else
+	{
+		lru->misses++;
+	}
+
+	LIST_UNLOCK(lru->list);
+	return it;
+}
+
+/**
+ * @brief 按键查找元素，不改变使用顺序，也不计入命中统计
+ */
+list_iterator_t list_lru_peek(list_lru_handle_t lru, const void *key)
+{
+	if (lru == NULL || key == NULL)
+		return NULL;
+
+	return list_hash_find(lru->index, key);
+}
+
+/**
+ * @brief 插入或更新元素，并移动到最近使用位置
+ * @param lru LRU缓存
+ * @param element 元素，键从元素的 key_offset 处读取
+ * @return 元素迭代器，失败返回NULL
+ * @note 键已存在时原地覆盖数据；缓存已满时先对最旧的元素调用淘汰回调，
+ *       再直接复用它的节点存放新元素
+ */
+list_iterator_t list_lru_put(list_lru_handle_t lru, const void *element)
+{
+	if (lru == NULL || element == NULL)
+		return NULL;
+
+	list_handle_t list = lru->list;
+	LIST_LOCK(list);
+
+	list_iterator_t it = list_hash_find(lru->index, (const uint8_t *)element + lru->index->key_offset);
+	if (it == NULL && list->size >= list->capacity)
+	{
+		// 复用最旧的节点
+		it = list->tail;
+		if (lru->on_evict != NULL)
+			lru->on_evict(it->data, lru->evict_ctx);
+	}
+
+	if (it != NULL)
+	{
+		list_replace(list, it, element);
+		list_move_to_front(list, it);
+	}
+	else if (list_push_front(list, element))
+	{
+		it = list->head;
+	}
+
+	LIST_UNLOCK(list);
+	return it;
+}
+
+/**
+ * @brief 将已知元素移动到最近使用位置
+ * @param lru LRU缓存
+ * @param it 元素迭代器
+ * @return 是否成功
+ */
+bool list_lru_touch(list_lru_handle_t lru, list_iterator_t it)
+{
+	if (lru == NULL)
+		return false;
+
+	return list_move_to_front(lru->list, it);
+}
+
+/**
+ * @brief 按键删除元素，不调用淘汰回调
+ * @return 是否删除成功
+ */
+bool list_lru_remove(list_lru_handle_t lru, const void *key)
+{
+	if (lru == NULL || key == NULL)
+		return false;
+
+	return list_hash_remove(lru->index, key) > 0;
+}
+
+void list_lru_clear(list_lru_handle_t lru)
+{
+	if (lru == NULL)
+		return;
+
+	list_clear(lru->list);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file list_lru.h
+ * @brief Embedded-List: 基于节点池的LRU缓存
+ *
+ * 元素存放在 list_t 的节点池中，按最近使用顺序链接（头部最新、尾部最旧），
+ * 内置按键查找的哈希索引（list_hash.h）。命中时只修改节点链接把元素移到头部，
+ * 不复制数据；缓存满时原地复用最旧的尾部节点存放新元素，不经过 free_list。
+ *
+ * - 容量即节点池容量，查找、命中、插入和淘汰都是O(1)期望时间
+ * - 淘汰回调在元素被覆盖前调用，可以用于写回脏数据
+ * - 节点池和哈希表都可以由外部缓冲区提供，适合无动态内存的系统
+ *
+ * @author DAI
+ * @date 2025-12-30
+ * @license MIT
+ */
+
+#ifndef __LIST_LRU_H__
+#define __LIST_LRU_H__
+
+#include "list_hash.h"
+
+// 淘汰回调：element 为即将被淘汰的元素，回调返回后其存储会被新元素覆盖
+typedef void (*list_lru_evict_func_t)(const void *element, void *ctx);
+
+typedef struct
+{
+	list_handle_t list;                // 存储元素的链表，头部为最近使用
+	list_hash_handle_t index;          // 按键查找的哈希索引
+	list_lru_evict_func_t on_evict;    // 淘汰回调（可选）
+	void *evict_ctx;                   // 淘汰回调上下文
+	uint32_t hits;                     // 命中次数
+	uint32_t misses;                   // 未命中次数
+} list_lru_t;
+
+typedef list_lru_t *list_lru_handle_t;
+
+// ========================= 创建和销毁 =========================
+list_lru_handle_t list_lru_create(uint16_t capacity, uint16_t element_size, uint16_t key_offset, uint16_t key_length);
+
+/**
+ * @brief 从外部缓冲区创建LRU缓存
+ * @param node_pool_buf 节点池缓冲区，至少 LIST_POOL_BUF_SIZE(capacity, element_size) 字节
+ * @param table_buf 哈希表缓冲区，推荐 LIST_HASH_TABLE_COUNT(capacity) 个 uint16_t
+ * @param table_count 哈希表缓冲区表项数量，必须大于 capacity
+ * @param capacity 容量
+ * @param element_size 元素大小
+ * @param key_offset 键在元素中的偏移
+ * @param key_length 键长度
+ * @return LRU缓存句柄，失败返回NULL
+ */
+list_lru_handle_t list_lru_create_from_buf(void *node_pool_buf, uint16_t *table_buf, uint32_t table_count,
+                                           uint16_t capacity, uint16_t element_size,
+                                           uint16_t key_offset, uint16_t key_length);
+void list_lru_free(list_lru_handle_t lru);
+void list_lru_set_evict_callback(list_lru_handle_t lru, list_lru_evict_func_t on_evict, void *ctx);
+
+// ========================= 容量查询 =========================
+uint16_t list_lru_size(list_lru_handle_t lru);
+uint16_t list_lru_capacity(list_lru_handle_t lru);
+void list_lru_stats(list_lru_handle_t lru, uint32_t *hits, uint32_t *misses);
+
+// ========================= 缓存操作 =========================
+list_iterator_t list_lru_get(list_lru_handle_t lru, const void *key);
+list_iterator_t list_lru_peek(list_lru_handle_t lru, const void *key);
+list_iterator_t list_lru_put(list_lru_handle_t lru, const void *element);
+bool list_lru_touch(list_lru_handle_t lru, list_iterator_t it);
+bool list_lru_remove(list_lru_handle_t lru, const void *key);
+void list_lru_clear(list_lru_handle_t lru);
+
+#endif
@@ -0,0 +1,351 @@
+#include "list_order.h"
+#include <string.h>
+
+#define LIST_LOCK(list) LIST_MUTEX_LOCK((list)->mutex)
+#define LIST_UNLOCK(list) LIST_MUTEX_UNLOCK((list)->mutex)
+
+// 槽位 slot 的各层后继数组，slot 为 LIST_INVALID_SLOT 时表示头节点
+static inline uint16_t *list_order_forward(list_order_handle_t index, uint16_t slot)
+{
+	return (slot == LIST_INVALID_SLOT) ? index->head : &index->forward[(size_t)slot * LIST_ORDER_MAX_LEVEL];
+}
+
+static inline const void *list_order_data(list_order_handle_t index, uint16_t slot)
+{
+	return list_slot_node(index->list, slot)->data;
+}
+
+// 按 (元素值, 槽位) 比较，保证相同值的元素也有确定的顺序
+static inline bool list_order_less(list_order_handle_t index, uint16_t a, const void *b_data, uint16_t b)
+{
+	int res = index->compare(list_order_data(index, a), b_data);
+	return res < 0 || (res == 0 && a < b);
+}
+
+static uint8_t list_order_random_level(list_order_handle_t index)
+{
+	// xorshift32，每层晋升概率1/4
+	uint32_t x = index->rand_state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	index->rand_state = x;
+
+	uint8_t level = 1;
+	while (level < LIST_ORDER_MAX_LEVEL && (x & 3) == 0)
+	{
+		level++;
+		x >>= 2;
+	}
+	return level;
+}
+
+// 查找每层中位于 (data, slot) 之前的最后一个节点
+static void list_order_find_update(list_order_handle_t index, const void *data, uint16_t slot,
+                                   uint16_t update[LIST_ORDER_MAX_LEVEL])
+{
+	uint16_t current = LIST_INVALID_SLOT;
+	for (int l = index->level - 1; l >= 0; l--)
+	{
+		uint16_t next;
+		while ((next = list_order_forward(index, current)[l]) != LIST_INVALID_SLOT &&
+		       list_order_less(index, next, data, slot))
+			current = next;
+		update[l] = current;
+	}
+}
+
+static void list_order_insert(list_order_handle_t index, list_iterator_t node)
+{
+	uint16_t slot = list_node_slot(index->list, node);
+	uint16_t update[LIST_ORDER_MAX_LEVEL];
+	list_order_find_update(index, node->data, slot, update);
+
+	uint8_t level = list_order_random_level(index);
+	for (uint8_t l = index->level; l < level; l++)
+		update[l] = LIST_INVALID_SLOT;
+	if (level > index->level)
+		index->level = level;
+
+	uint16_t *forward = list_order_forward(index, slot);
+	for (uint8_t l = 0; l < level; l++)
+	{
+		uint16_t *prev_forward = list_order_forward(index, update[l]);
+		forward[l] = prev_forward[l];
+		prev_forward[l] = slot;
+	}
+	index->levels[slot] = level;
+}
+
+static void list_order_delete(list_order_handle_t index, list_iterator_t node)
+{
+	uint16_t slot = list_node_slot(index->list, node);
+	uint16_t update[LIST_ORDER_MAX_LEVEL];
+	list_order_find_update(index, node->data, slot, update);
+
+	if (list_order_forward(index, update[0])[0] != slot)
+		return;
+
+	uint16_t *forward = list_order_forward(index, slot);
+	for (uint8_t l = 0; l < index->levels[slot]; l++)
+		list_order_forward(index, update[l])[l] = forward[l];
+
+	while (index->level > 1 && index->head[index->level - 1] == LIST_INVALID_SLOT)
+		index->level--;
+}
+
+static void list_order_reset(list_order_handle_t index)
+{
+	for (uint8_t l = 0; l < LIST_ORDER_MAX_LEVEL; l++)
+		index->head[l] = LIST_INVALID_SLOT;
+	index->level = 1;
+
+	for (list_iterator_t it = index->list->head; it != NULL; it = it->next)
+		list_order_insert(index, it);
+}
+
+// 第一个不满足 “值 < value”（strict 时为 “值 <= value”）的节点
+static uint16_t list_order_bound(list_order_handle_t index, const void *value, bool strict)
+{
+	uint16_t current = LIST_INVALID_SLOT;
+	for (int l = index->level - 1; l >= 0; l--)
+	{
+		uint16_t next;
+		while ((next = list_order_forward(index, current)[l]) != LIST_INVALID_SLOT)
+		{
+			int res = index->compare(list_order_data(index, next), value);
+			if (res > 0 || (res == 0 && !strict))
+				break;
+			current = next;
+		}
+	}
+	return list_order_forward(index, current)[0];
+}
+
+static void list_order_on_event(list_handle_t list, list_event_t event, list_iterator_t node, void *ctx)
+{
+	list_order_handle_t index = (list_order_handle_t)ctx;
+	(void)list;
+
+	switch (event)
+	{
+	case LIST_EVENT_LINK:
+	case LIST_EVENT_UPDATE:
+		list_order_insert(index, node);
+		break;
+	case LIST_EVENT_UNLINK:
+	case LIST_EVENT_BEFORE_UPDATE:
+		list_order_delete(index, node);
+		break;
+	case LIST_EVENT_RESET:
+		list_order_reset(index);
+		break;
+	default:
+		// 链表顺序变化不影响索引
+		break;
+	}
+}
+
+/**
+ * @brief 为链表创建有序索引（动态分配索引存储）
+ * @param list 被索引的链表
+ * @param compare 比较函数
+ * @return 索引句柄，失败返回NULL
+ * @note 创建时会为已有元素建立索引
+ */
+list_order_handle_t list_order_create(list_handle_t list, list_compare_func_t compare)
+{
+	if (list == NULL)
+		return NULL;
+
+	size_t buf_size = LIST_ORDER_BUF_SIZE(list->capacity);
+	void *buf = malloc(buf_size);
+	if (buf == NULL)
+		return NULL;
+
+	list_order_handle_t index = list_order_create_from_buf(list, compare, buf, buf_size);
+	if (index == NULL)
+	{
+		free(buf);
+		return NULL;
+	}
+
+	index->is_static = false;
+	return index;
+}
+
+/**
+ * @brief 使用外部缓冲区创建有序索引
+ * @param list 被索引的链表
+ * @param compare 比较函数
+ * @param buf 索引存储缓冲区，2字节对齐
+ * @param buf_size 缓冲区大小，至少 LIST_ORDER_BUF_SIZE(capacity)
+ * @return 索引句柄，失败返回NULL
+ */
+list_order_handle_t list_order_create_from_buf(list_handle_t list, list_compare_func_t compare, void *buf, size_t buf_size)
+{
+	if (list == NULL || compare == NULL || buf == NULL || ((uintptr_t)buf & 1) != 0 ||
+	    buf_size < LIST_ORDER_BUF_SIZE(list->capacity))
+		return NULL;
+
+	list_order_handle_t index = (list_order_handle_t)malloc(sizeof(list_order_t));
+	if (index == NULL)
+		return NULL;
+
+	index->list = list;
+	index->compare = compare;
+	index->forward = (uint16_t *)buf;
+	index->levels = (uint8_t *)buf + (size_t)list->capacity * LIST_ORDER_MAX_LEVEL * sizeof(uint16_t);
+	index->rand_state = 2463534242u;
+	index->is_static = true;
+	index->observer.callback = list_order_on_event;
+	index->observer.lookup = NULL;
+	index->observer.ctx = index;
+	index->observer.next = NULL;
+
+	LIST_LOCK(list);
+	list_order_reset(index);
+	list_add_observer(list, &index->observer);
+	LIST_UNLOCK(list);
+
+	return index;
+}
+
+void list_order_free(list_order_handle_t index)
+{
+	if (index == NULL)
+		return;
+
+	list_remove_observer(index->list, &index->observer);
+	if (!index->is_static)
+		free(index->forward);
+	free(index);
+}
+
+/**
+ * @brief 重建索引
+ * @note 直接修改了节点数据（例如通过 it->data 写入比较字段）后需要调用
+ */
+void list_order_rebuild(list_order_handle_t index)
+{
+	if (index == NULL)
+		return;
+
+	LIST_LOCK(index->list);
+	list_order_reset(index);
+	LIST_UNLOCK(index->list);
+}
+
+/**
+ * @brief 获取索引顺序中的第一个（最小）元素
+ */
+list_iterator_t list_order_first(list_order_handle_t index)
+{
+	if (index == NULL)
+		return NULL;
+
+	LIST_LOCK(index->list);
+	list_iterator_t it = list_slot_node(index->list, index->head[0]);
+	LIST_UNLOCK(index->list);
+	return it;
+}
+
+/**
+ * @brief 获取索引顺序中 it 的下一个元素
+ * @note O(1)
+ */
+list_iterator_t list_order_next(list_order_handle_t index, list_iterator_t it)
+{
+	if (index == NULL || it == NULL)
+		return NULL;
+
+	uint16_t slot = list_node_slot(index->list, it);
+	if (slot == LIST_INVALID_SLOT)
+		return NULL;
+
+	LIST_LOCK(index->list);
+	list_iterator_t next = list_slot_node(index->list, list_order_forward(index, slot)[0]);
+	LIST_UNLOCK(index->list);
+	return next;
+}
+
+/**
+ * @brief 查找第一个不小于 value 的元素
+ * @param index 索引句柄
+ * @param value 比较值（传给比较函数的第二个参数）
+ * @return 迭代器，不存在时返回NULL
+ * @note O(log n)期望时间
+ */
+list_iterator_t list_lower_bound(list_order_handle_t index, const void *value)
+{
+	if (index == NULL || value == NULL)
+		return NULL;
+
+	LIST_LOCK(index->list);
+	list_iterator_t it = list_slot_node(index->list, list_order_bound(index, value, false));
+	LIST_UNLOCK(index->list);
+	return it;
+}
+
+/**
+ * @brief 查找第一个大于 value 的元素
+ * @param index 索引句柄
+ * @param value 比较值（传给比较函数的第二个参数）
+ * @return 迭代器，不存在时返回NULL
+ * @note O(log n)期望时间
+ */
+list_iterator_t list_upper_bound(list_order_handle_t index, const void *value)
+{
+	if (index == NULL || value == NULL)
+		return NULL;
+
+	LIST_LOCK(index->list);
+	list_iterator_t it = list_slot_node(index->list, list_order_bound(index, value, true));
+	LIST_UNLOCK(index->list);
+	return it;
+}
+
+/**
+ * @brief 初始化区间迭代器，遍历 [low, high) 内的元素
+ * @param index 索引句柄
+ * @param low 下界（包含），为NULL时从最小元素开始
+ * @param high 上界（不包含），为NULL时遍历到最大元素
+ * @param range 区间迭代器
+ * @note 迭代过程中不能修改链表；low/high 指向的数据在迭代结束前必须保持有效
+ */
+void list_order_range(list_order_handle_t index, const void *low, const void *high, list_order_range_t *range)
+{
+	if (range == NULL)
+		return;
+
+	range->index = index;
+	range->high = high;
+	range->next_slot = LIST_INVALID_SLOT;
+	if (index == NULL)
+		return;
+
+	LIST_LOCK(index->list);
+	range->next_slot = (low != NULL) ? list_order_bound(index, low, false) : index->head[0];
+	LIST_UNLOCK(index->list);
+}
+
+/**
+ * @brief 返回区间内的下一个元素
+ * @return 迭代器，区间遍历结束时返回NULL
+ */
+list_iterator_t list_order_range_next(list_order_range_t *range)
+{
+	if (range == NULL || range->index == NULL || range->next_slot == LIST_INVALID_SLOT)
+		return NULL;
+
+	list_order_handle_t index = range->index;
+	list_iterator_t it = list_slot_node(index->list, range->next_slot);
+	if (range->high != NULL && index->compare(it->data, range->high) >= 0)
+	{
+		range->next_slot = LIST_INVALID_SLOT;
+		return NULL;
+	}
+
+	range->next_slot = list_order_forward(index, range->next_slot)[0];
+	return it;
+}
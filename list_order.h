@@ -0,0 +1,69 @@
+/**
+ * @file list_order.h
+ * @brief Embedded-List: 挂接在链表上的有序索引
+ *
+ * 以用户比较函数为序，为链表元素建立跳表索引（节点为槽位索引，数组存储），
+ * 提供 lower_bound / upper_bound 和区间迭代，用于“时间戳在 [a, b) 内的所有元素”
+ * 这类范围查询。索引作为变更观察者注册到链表上，由所有修改操作自动维护，
+ * 链表本身的遍历顺序保持不变。
+ *
+ * - 查找、插入、删除为O(log n)期望时间
+ * - 比较值相同的元素按槽位索引排序，区间迭代可以遍历所有相同元素
+ * - 索引存储可以由外部缓冲区提供，适合无动态内存的系统
+ *
+ * @author DAI
+ * @date 2025-12-30
+ * @license MIT
+ */
+
+#ifndef __LIST_ORDER_H__
+#define __LIST_ORDER_H__
+
+#include "embedded_list.h"
+
+// 跳表最大层数，每层晋升概率为1/4，8层可以很好地支持 65535 个元素
+#ifndef LIST_ORDER_MAX_LEVEL
+#define LIST_ORDER_MAX_LEVEL 8
+#endif
+
+// 静态分配时索引缓冲区需要的字节数（缓冲区需要2字节对齐）
+#define LIST_ORDER_BUF_SIZE(capacity) ((size_t)(capacity) * (LIST_ORDER_MAX_LEVEL * sizeof(uint16_t) + 1))
+
+typedef struct
+{
+	list_handle_t list;                      // 被索引的链表
+	list_compare_func_t compare;             // 比较函数
+	uint16_t *forward;                       // 每个槽位的各层后继槽位（capacity * LIST_ORDER_MAX_LEVEL）
+	uint8_t *levels;                         // 每个槽位的层数
+	uint16_t head[LIST_ORDER_MAX_LEVEL];     // 头节点的各层后继
+	uint8_t level;                           // 当前使用的最高层数
+	uint32_t rand_state;                     // 层数随机数状态
+	list_observer_t observer;                // 注册到链表上的观察者
+	bool is_static;                          // 索引存储是否由外部提供
+} list_order_t;
+
+typedef list_order_t *list_order_handle_t;
+
+// 区间迭代器：依次返回 [low, high) 内的元素
+typedef struct
+{
+	list_order_handle_t index;
+	uint16_t next_slot;
+	const void *high;
+} list_order_range_t;
+
+// ========================= 创建和销毁 =========================
+list_order_handle_t list_order_create(list_handle_t list, list_compare_func_t compare);
+list_order_handle_t list_order_create_from_buf(list_handle_t list, list_compare_func_t compare, void *buf, size_t buf_size);
+void list_order_free(list_order_handle_t index);
+void list_order_rebuild(list_order_handle_t index);
+
+// ========================= 有序查询 =========================
+list_iterator_t list_order_first(list_order_handle_t index);
+list_iterator_t list_order_next(list_order_handle_t index, list_iterator_t it);
+list_iterator_t list_lower_bound(list_order_handle_t index, const void *value);
+list_iterator_t list_upper_bound(list_order_handle_t index, const void *value);
+void list_order_range(list_order_handle_t index, const void *low, const void *high, list_order_range_t *range);
+list_iterator_t list_order_range_next(list_order_range_t *range);
+
+#endif
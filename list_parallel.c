@@ -0,0 +1,619 @@
+#include "list_parallel.h"
+#include "list_save.h"
+#include <stddef.h>
+#include <string.h>
+
+#if !defined(LIST_PARALLEL_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+#define LIST_PARALLEL_THREADS
+#include <pthread.h>
+#endif
+
+#define ALIGN_UP(size, align) (((size) + (align) - 1) & ~((size_t)(align) - 1))
+#define LIST_LOCK(list) LIST_MUTEX_LOCK((list)->mutex)
+#define LIST_UNLOCK(list) LIST_MUTEX_UNLOCK((list)->mutex)
+#define LIST_NODE_SIZE(element_size) ALIGN_UP(sizeof(list_node_t) + ((element_size) > 0 ? (element_size) : 1), 4)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIST_CTZ32(x) ((uint32_t)__builtin_ctz(x))
+#else
+static inline uint32_t LIST_CTZ32(uint32_t x)
+{
+	uint32_t n = 0;
+	while ((x & 1u) == 0)
+	{
+		x >>= 1;
+		n++;
+	}
+	return n;
+}
+#endif
+
+typedef void (*list_parallel_task_t)(void *job, uint8_t part);
+
+struct list_workers_t
+{
+	uint8_t thread_count;  // 线程总数（包括调用线程）
+#ifdef LIST_PARALLEL_THREADS
+	pthread_t threads[LIST_PARALLEL_MAX_THREADS];
+	pthread_mutex_t mutex;
+	pthread_cond_t start_cond;  // 发布新任务
+	pthread_cond_t done_cond;   // 所有工作线程完成
+	uint32_t generation;        // 任务编号，每发布一次加1
+	uint8_t pending;            // 尚未完成的工作线程数
+	bool stop;
+	list_parallel_task_t task;
+	void *job;
+#endif
+};
+
+typedef enum
+{
+	LIST_PARALLEL_FOR_EACH,
+	LIST_PARALLEL_COUNT_IF,
+	LIST_PARALLEL_MARK_IF,
+} list_parallel_kind_t;
+
+// 一次并行操作的分区和参数
+typedef struct
+{
+	list_handle_t list;
+	list_parallel_kind_t kind;
+	bool by_slot;                                          // 按槽位范围（活动槽位位图）切分
+	list_node_t *starts[LIST_PARALLEL_MAX_THREADS];        // 链表分区的起点
+	uint16_t lengths[LIST_PARALLEL_MAX_THREADS];           // 链表分区的长度
+	uint16_t word_begin[LIST_PARALLEL_MAX_THREADS + 1];    // 位图分区的字范围
+	list_foreach_func_t callback;
+	void *user_data;
+	list_predicate_func_t predicate;
+	const void *predicate_data;
+	uint16_t counts[LIST_PARALLEL_MAX_THREADS];            // 每个分区的匹配数量
+	uint8_t *marks;                                        // 按槽位记录的匹配标记
+} list_parallel_job_t;
+
+#ifdef LIST_PARALLEL_THREADS
+typedef struct
+{
+	list_workers_handle_t workers;
+	uint8_t part;
+} list_worker_arg_t;
+
+static void *list_worker_main(void *arg)
+{
+	list_worker_arg_t *worker = (list_worker_arg_t *)arg;
+	list_workers_handle_t workers = worker->workers;
+	uint8_t part = worker->part;
+	free(worker);
+
+	uint32_t seen = 0;
+	pthread_mutex_lock(&workers->mutex);
+	while (true)
+	{
+		while (!workers->stop && workers->generation == seen)
+			pthread_cond_wait(&workers->start_cond, &workers->mutex);
+		if (workers->stop)
+			break;
+
+		seen = workers->generation;
+		list_parallel_task_t task = workers->task;
+		void *job = workers->job;
+		pthread_mutex_unlock(&workers->mutex);
+
+		task(job, part);
+
+		pthread_mutex_lock(&workers->mutex);
+		if (--workers->pending == 0)
+			pthread_cond_signal(&workers->done_cond);
+	}
+	pthread_mutex_unlock(&workers->mutex);
+	return NULL;
+}
+#endif
+
+/**
+ * @brief 创建工作线程池
+ * @param thread_count 线程总数（包括调用线程），1 ~ LIST_PARALLEL_MAX_THREADS
+ * @return 线程池句柄，失败返回NULL
+ * @note 不支持线程的平台上线程总数固定为1
+ */
+list_workers_handle_t list_workers_create(uint8_t thread_count)
+{
+	if (thread_count == 0 || thread_count > LIST_PARALLEL_MAX_THREADS)
+		return NULL;
+
+	list_workers_handle_t workers = (list_workers_handle_t)malloc(sizeof(list_workers_t));
+	if (workers == NULL)
+		return NULL;
+
+#ifdef LIST_PARALLEL_THREADS
+	workers->thread_count = 1;
+	workers->generation = 0;
+	workers->pending = 0;
+	workers->stop = false;
+	workers->task = NULL;
+	workers->job = NULL;
+	pthread_mutex_init(&workers->mutex, NULL);
+	pthread_cond_init(&workers->start_cond, NULL);
+	pthread_cond_init(&workers->done_cond, NULL);
+
+	for (uint8_t i = 1; i < thread_count; i++)
+	{
+		list_worker_arg_t *arg = (list_worker_arg_t *)malloc(sizeof(list_worker_arg_t));
+		if (arg == NULL)
+			break;
+		arg->workers = workers;
+		arg->part = i;
+		if (pthread_create(&workers->threads[i], NULL, list_worker_main, arg) != 0)
+		{
+			free(arg);
+			break;
+		}
+		workers->thread_count++;
+	}
+
+	if (workers->thread_count != thread_count)
+	{
+		list_workers_free(workers);
+		return NULL;
+	}
+#else
+	workers->thread_count = 1;
+#endif
+
+	return workers;
+}
+
+void list_workers_free(list_workers_handle_t workers)
+{
+	if (workers == NULL)
+		return;
+
+#ifdef LIST_PARALLEL_THREADS
+	pthread_mutex_lock(&workers->mutex);
+	workers->stop = true;
+	pthread_cond_broadcast(&workers->start_cond);
+	pthread_mutex_unlock(&workers->mutex);
+
+	for (uint8_t i = 1; i < workers->thread_count; i++)
+		pthread_join(workers->threads[i], NULL);
+
+	pthread_cond_destroy(&workers->done_cond);
+	pthread_cond_destroy(&workers->start_cond);
+	pthread_mutex_destroy(&workers->mutex);
+#endif
+
+	free(workers);
+}
+
+uint8_t list_workers_count(list_workers_handle_t workers)
+{
+	return workers ? workers->thread_count : 0;
+}
+
+// 在所有线程上执行 task，调用线程处理第0个分区，返回时所有分区都已完成
+static void list_workers_run(list_workers_handle_t workers, list_parallel_task_t task, void *job)
+{
+#ifdef LIST_PARALLEL_THREADS
+	if (workers->thread_count > 1)
+	{
+		pthread_mutex_lock(&workers->mutex);
+		workers->task = task;
+		workers->job = job;
+		workers->pending = (uint8_t)(workers->thread_count - 1);
+		workers->generation++;
+		pthread_cond_broadcast(&workers->start_cond);
+		pthread_mutex_unlock(&workers->mutex);
+
+		task(job, 0);
+
+		pthread_mutex_lock(&workers->mutex);
+		while (workers->pending > 0)
+			pthread_cond_wait(&workers->done_cond, &workers->mutex);
+		pthread_mutex_unlock(&workers->mutex);
+		return;
+	}
+#endif
+	task(job, 0);
+}
+
+static inline bool list_parallel_match(const list_parallel_job_t *job, const list_node_t *node)
+{
+	return job->predicate ? job->predicate(node->data, job->predicate_data)
+	                      : memcmp(node->data, job->predicate_data, job->list->element_size) == 0;
+}
+
+static inline void list_parallel_visit(list_parallel_job_t *job, uint8_t part, list_node_t *node)
+{
+	switch (job->kind)
+	{
+	case LIST_PARALLEL_FOR_EACH:
+		job->callback(node, job->user_data);
+		break;
+	case LIST_PARALLEL_COUNT_IF:
+		if (list_parallel_match(job, node))
+			job->counts[part]++;
+		break;
+	case LIST_PARALLEL_MARK_IF:
+		if (list_parallel_match(job, node))
+		{
+			job->marks[list_node_slot(job->list, node)] = 1;
+			job->counts[part]++;
+		}
+		break;
+	}
+}
+
+static void list_parallel_task(void *arg, uint8_t part)
+{
+	list_parallel_job_t *job = (list_parallel_job_t *)arg;
+	list_handle_t list = job->list;
+
+	if (job->by_slot)
+	{
+		size_t node_size = LIST_NODE_SIZE(list->element_size);
+		for (uint16_t w = job->word_begin[part]; w < job->word_begin[part + 1]; w++)
+		{
+			for (uint32_t bits = list->live_map[w]; bits != 0; bits &= bits - 1)
+			{
+				uint32_t slot = (uint32_t)w * 32 + LIST_CTZ32(bits);
+				list_parallel_visit(job, part, (list_node_t *)((uint8_t *)list->node_pool + slot * node_size));
+			}
+		}
+		return;
+	}
+
+	list_node_t *node = job->starts[part];
+	for (uint16_t i = 0; i < job->lengths[part]; i++)
+	{
+		list_node_t *next = node->next;
+		list_parallel_visit(job, part, node);
+		node = next;
+	}
+}
+
+// 切分列表并在线程池上执行，调用者已加锁
+static void list_parallel_execute(list_workers_handle_t workers, list_parallel_job_t *job)
+{
+	list_handle_t list = job->list;
+	uint8_t parts = workers->thread_count;
+	memset(job->counts, 0, sizeof(job->counts));
+
+	// 活动槽位位图属于本列表时按字范围切分，否则沿链表记录分区起点
+	job->by_slot = list->live_map != NULL && list->pool_users == 0;
+	if (job->by_slot)
+	{
+		uint16_t words = (uint16_t)LIST_LIVE_MAP_WORDS(list->capacity);
+		for (uint8_t p = 0; p <= parts; p++)
+			job->word_begin[p] = (uint16_t)((uint32_t)words * p / parts);
+	}
+	else
+	{
+		list_node_t *node = list->head;
+		for (uint8_t p = 0; p < parts; p++)
+		{
+			uint16_t begin = (uint16_t)((uint32_t)list->size * p / parts);
+			uint16_t end = (uint16_t)((uint32_t)list->size * (p + 1) / parts);
+			job->starts[p] = node;
+			job->lengths[p] = (uint16_t)(end - begin);
+			for (uint16_t i = begin; i < end; i++)
+				node = node->next;
+		}
+	}
+
+	list_workers_run(workers, list_parallel_task, job);
+}
+
+static void list_parallel_job_init(list_parallel_job_t *job, list_handle_t list, list_parallel_kind_t kind)
+{
+	memset(job, 0, sizeof(*job));
+	job->list = list;
+	job->kind = kind;
+}
+
+/**
+ * @brief 在多个线程上对所有元素执行回调函数
+ * @param workers 线程池
+ * @param list 列表指针
+ * @param callback 回调函数，会在多个线程中同时执行
+ * @param user_data 传递给回调函数的用户数据
+ * @note 回调的执行顺序不确定；回调中可以修改元素数据，但不能修改列表结构
+ */
+void list_parallel_for_each(list_workers_handle_t workers, list_handle_t list, list_foreach_func_t callback, void *user_data)
+{
+	if (workers == NULL || list == NULL || callback == NULL)
+		return;
+
+	list_parallel_job_t job;
+	list_parallel_job_init(&job, list, LIST_PARALLEL_FOR_EACH);
+	job.callback = callback;
+	job.user_data = user_data;
+
+	LIST_LOCK(list);
+	list_parallel_execute(workers, &job);
+	LIST_UNLOCK(list);
+}
+
+/**
+ * @brief 在多个线程上统计满足条件的元素数量
+ * @param predicate 谓词函数，为NULL时与 predicate_data 逐字节比较
+ * @return 满足条件的元素数量
+ */
+uint16_t list_parallel_count_if(list_workers_handle_t workers, list_handle_t list, list_predicate_func_t predicate,
+                                const void *predicate_data)
+{
+	if (workers == NULL || list == NULL || (predicate == NULL && predicate_data == NULL))
+		return 0;
+
+	list_parallel_job_t job;
+	list_parallel_job_init(&job, list, LIST_PARALLEL_COUNT_IF);
+	job.predicate = predicate;
+	job.predicate_data = predicate_data;
+
+	LIST_LOCK(list);
+	list_parallel_execute(workers, &job);
+	LIST_UNLOCK(list);
+
+	uint16_t count = 0;
+	for (uint8_t p = 0; p < workers->thread_count; p++)
+		count += job.counts[p];
+	return count;
+}
+
+/**
+ * @brief 在多个线程上判断条件，然后删除所有满足条件的元素
+ * @param predicate 谓词函数，为NULL时与 predicate_data 逐字节比较
+ * @return 删除的元素数量，内存不足时返回0且不删除任何元素
+ * @note 各线程按槽位记录匹配标记，全部完成后在调用线程中按槽位顺序统一删除，
+ *       删除时照常通知观察者
+ */
+uint16_t list_parallel_remove_if(list_workers_handle_t workers, list_handle_t list, list_predicate_func_t predicate,
+                                 const void *predicate_data)
+{
+	if (workers == NULL || list == NULL || (predicate == NULL && predicate_data == NULL))
+		return 0;
+
+	list_parallel_job_t job;
+	list_parallel_job_init(&job, list, LIST_PARALLEL_MARK_IF);
+	job.predicate = predicate;
+	job.predicate_data = predicate_data;
+	job.marks = (uint8_t *)calloc(list->capacity, sizeof(uint8_t));
+	if (job.marks == NULL)
+		return 0;
+
+	LIST_LOCK(list);
+
+	list_parallel_execute(workers, &job);
+
+	// 合并各线程的删除集合
+	uint16_t remove_count = 0;
+	for (uint16_t slot = 0; slot < list->capacity; slot++)
+	{
+		if (job.marks[slot])
+		{
+			list_erase(list, list_slot_node(list, slot));
+			remove_count++;
+		}
+	}
+
+	LIST_UNLOCK(list);
+
+	free(job.marks);
+	return remove_count;
+}
+
+// ========================= 并行恢复 =========================
+
+// 并行反序列化的分区和中间结果：记录按下标范围切分，槽位按位图的字范围切分
+typedef struct
+{
+	list_handle_t list;
+	const uint8_t *records;                             // 第一条节点记录（list_persist_node_t）
+	uint32_t record_size;                               // 每条节点记录的字节数
+	uint16_t count;                                     // 节点记录数量
+	uint16_t words;                                     // 槽位位图的字数
+	uint8_t parts;                                      // 分区数量
+	uint32_t *part_used;                                // 每个分区各自标记的槽位（parts * words）
+	uint32_t *used;                                     // 合并后的已使用槽位
+	bool failed[LIST_PARALLEL_MAX_THREADS];             // 分区中发现无效或重复的槽位
+	list_node_t *free_head[LIST_PARALLEL_MAX_THREADS];  // 每个槽位范围的空闲节点子链
+	list_node_t *free_tail[LIST_PARALLEL_MAX_THREADS];
+} list_parallel_restore_t;
+
+static inline uint16_t list_restore_slot(const list_parallel_restore_t *job, uint32_t i)
+{
+	return list_load_le16(job->records + (size_t)i * job->record_size + offsetof(list_persist_node_t, index));
+}
+
+static inline list_node_t *list_restore_node(const list_parallel_restore_t *job, uint16_t slot)
+{
+	return (list_node_t *)((uint8_t *)job->list->node_pool + (size_t)slot * LIST_NODE_SIZE(job->list->element_size));
+}
+
+// 第一遍：每个分区在自己的位图中标记本分区记录的槽位，发现越界或分区内重复的槽位
+static void list_restore_mark_task(void *arg, uint8_t part)
+{
+	list_parallel_restore_t *job = (list_parallel_restore_t *)arg;
+	uint32_t *used = job->part_used + (size_t)part * job->words;
+	uint16_t capacity = job->list->capacity;
+	uint32_t end = (uint32_t)job->count * (part + 1) / job->parts;
+
+	for (uint32_t i = (uint32_t)job->count * part / job->parts; i < end; i++)
+	{
+		uint16_t slot = list_restore_slot(job, i);
+		if (slot >= capacity || (used[slot >> 5] & (1u << (slot & 31))) != 0)
+		{
+			job->failed[part] = true;
+			return;
+		}
+		used[slot >> 5] |= 1u << (slot & 31);
+	}
+}
+
+// 第二遍：按字范围合并各分区的位图，发现跨分区重复的槽位
+static void list_restore_merge_task(void *arg, uint8_t part)
+{
+	list_parallel_restore_t *job = (list_parallel_restore_t *)arg;
+	uint32_t end = (uint32_t)job->words * (part + 1) / job->parts;
+
+	for (uint32_t w = (uint32_t)job->words * part / job->parts; w < end; w++)
+	{
+		uint32_t merged = 0;
+		for (uint8_t p = 0; p < job->parts; p++)
+		{
+			uint32_t bits = job->part_used[(size_t)p * job->words + w];
+			if ((merged & bits) != 0)
+				job->failed[part] = true;
+			merged |= bits;
+		}
+		job->used[w] = merged;
+	}
+}
+
+// 第三遍：复制本分区记录的数据并按记录顺序链接节点，再用本分区槽位范围中未使用的槽位组成空闲子链
+static void list_restore_link_task(void *arg, uint8_t part)
+{
+	list_parallel_restore_t *job = (list_parallel_restore_t *)arg;
+	list_handle_t list = job->list;
+	uint32_t begin = (uint32_t)job->count * part / job->parts;
+	uint32_t end = (uint32_t)job->count * (part + 1) / job->parts;
+
+	if (begin < end)
+	{
+		list_node_t *prev = begin > 0 ? list_restore_node(job, list_restore_slot(job, begin - 1)) : NULL;
+		list_node_t *node = list_restore_node(job, list_restore_slot(job, begin));
+		const uint8_t *record = job->records + (size_t)begin * job->record_size;
+		for (uint32_t i = begin; i < end; i++, record += job->record_size)
+		{
+			list_node_t *next = i + 1 < job->count ? list_restore_node(job, list_restore_slot(job, i + 1)) : NULL;
+			memcpy(node->data, record + offsetof(list_persist_node_t, data), list->element_size);
+			node->prev = prev;
+			node->next = next;
+			prev = node;
+			node = next;
+		}
+	}
+
+	// 槽位从小到大压入子链，与 list_deserialize 相同，空闲链表从最大的槽位开始分配
+	list_node_t *head = NULL;
+	list_node_t *tail = NULL;
+	uint32_t word_end = (uint32_t)job->words * (part + 1) / job->parts;
+	for (uint32_t w = (uint32_t)job->words * part / job->parts; w < word_end; w++)
+	{
+		uint32_t free_bits = ~job->used[w];
+		if (w == job->words - 1u && (list->capacity & 31) != 0)
+			free_bits &= ((uint32_t)1 << (list->capacity & 31)) - 1;
+		for (; free_bits != 0; free_bits &= free_bits - 1)
+		{
+			list_node_t *free_node = list_restore_node(job, (uint16_t)(w * 32 + LIST_CTZ32(free_bits)));
+			free_node->next = head;
+			free_node->prev = NULL;
+			if (head == NULL)
+				tail = free_node;
+			head = free_node;
+		}
+		if (list->live_map != NULL)
+			list->live_map[w] = job->used[w];
+	}
+	job->free_head[part] = head;
+	job->free_tail[part] = tail;
+}
+
+static bool list_restore_failed(const list_parallel_restore_t *job)
+{
+	for (uint8_t p = 0; p < job->parts; p++)
+	{
+		if (job->failed[p])
+			return true;
+	}
+	return false;
+}
+
+/**
+ * @brief 在多个线程上从 list_serialize 的数据恢复链表，结果与 list_deserialize 相同
+ * @param workers 线程池
+ * @param list 目标链表，容量不能小于保存时的容量，不能共享节点池
+ * @param buffer 序列化数据
+ * @param buffer_size 数据大小
+ * @return 是否恢复成功
+ * @note 与 list_deserialize 相同，先检查校验头部的版本、长度和 CRC32C，不一致时不启动工作线程，返回false且不修改链表；
+ *       没有校验头部的旧数据直接读取
+ * @note 先在锁外并行检查所有槽位，数据无效（槽位越界或重复）时返回false且不修改链表；
+ *       之后在列表锁内并行复制数据、链接节点和重建空闲链表，完成后发出 LIST_EVENT_RESET
+ * @note 需要 (线程数 + 1) * capacity / 8 字节的临时内存
+ */
+bool list_parallel_deserialize(list_workers_handle_t workers, list_handle_t list, const void *buffer, uint32_t buffer_size)
+{
+	if (workers == NULL || list == NULL || buffer == NULL)
+		return false;
+
+	// 校验头部在启动工作线程之前检查，之后只使用校验头部后面的数据
+	if (!list_check_serialized(buffer, buffer_size, &buffer, &buffer_size) ||
+	    buffer_size < sizeof(list_persist_header_t))
+		return false;
+
+	const uint8_t *bytes = (const uint8_t *)buffer;
+	uint16_t size = list_load_le16(bytes + offsetof(list_persist_header_t, size));
+	uint16_t capacity = list_load_le16(bytes + offsetof(list_persist_header_t, capacity));
+	uint16_t element_size = list_load_le16(bytes + offsetof(list_persist_header_t, element_size));
+	if (size > capacity || element_size != list->element_size || list->capacity < capacity)
+		return false;
+
+	// 反序列化会重建整个节点池的 free_list，不能用于共享节点池的列表
+	if (list->pool_owner != NULL || list->pool_users != 0)
+		return false;
+
+	uint32_t record_size = (uint32_t)(offsetof(list_persist_node_t, data) + element_size);
+	if (buffer_size < sizeof(list_persist_header_t) + (uint32_t)size * record_size)
+		return false;
+
+	list_parallel_restore_t job;
+	memset(&job, 0, sizeof(job));
+	job.list = list;
+	job.records = bytes + sizeof(list_persist_header_t);
+	job.record_size = record_size;
+	job.count = size;
+	job.words = (uint16_t)LIST_LIVE_MAP_WORDS(list->capacity);
+	job.parts = workers->thread_count;
+	job.part_used = (uint32_t *)calloc((size_t)job.parts * job.words, sizeof(uint32_t));
+	job.used = (uint32_t *)malloc((size_t)job.words * sizeof(uint32_t));
+	if (job.part_used == NULL || job.used == NULL)
+	{
+		free(job.part_used);
+		free(job.used);
+		return false;
+	}
+
+	list_workers_run(workers, list_restore_mark_task, &job);
+	if (!list_restore_failed(&job))
+		list_workers_run(workers, list_restore_merge_task, &job);
+	free(job.part_used);
+	if (list_restore_failed(&job))
+	{
+		free(job.used);
+		return false;
+	}
+
+	LIST_LOCK(list);
+
+	list_workers_run(workers, list_restore_link_task, &job);
+
+	// 按槽位范围从高到低连接各个空闲子链
+	list->free_list = NULL;
+	for (uint8_t p = 0; p < job.parts; p++)
+	{
+		if (job.free_head[p] != NULL)
+		{
+			job.free_tail[p]->next = list->free_list;
+			list->free_list = job.free_head[p];
+		}
+	}
+	list->head = size > 0 ? list_restore_node(&job, list_restore_slot(&job, 0)) : NULL;
+	list->tail = size > 0 ? list_restore_node(&job, list_restore_slot(&job, size - 1u)) : NULL;
+	list->size = size;
+
+	list_notify(list, LIST_EVENT_RESET, NULL);
+
+	LIST_UNLOCK(list);
+
+	free(job.used);
+	return true;
+}
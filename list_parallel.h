@@ -0,0 +1,49 @@
+/**
+ * @file list_parallel.h
+ * @brief Embedded-List: 多线程并行遍历
+ *
+ * 内置一个小型工作线程池，把列表切分成若干分区交给工作线程并行处理，
+ * 适合校验、过滤、变换等每个元素计算量较大的遍历。
+ *
+ * - 启用了活动槽位位图的列表按槽位范围切分，不需要遍历链表
+ * - 其他列表先沿链表走一遍记录分区起点，再并行处理各分区
+ * - 调用线程负责第0个分区，处理期间一直持有列表锁
+ * - list_parallel_deserialize 按记录范围并行复制元素数据和链接节点，按槽位范围并行重建空闲链表
+ * - 没有 pthread 的平台（或定义了 LIST_PARALLEL_NO_THREADS）退化为在调用线程中串行执行
+ *
+ * @note 回调和谓词会在多个线程中同时执行，必须是线程安全的，并且不能调用同一列表的接口
+ *
+ * @author DAI
+ * @date 2025-12-30
+ * @license MIT
+ */
+
+#ifndef __LIST_PARALLEL_H__
+#define __LIST_PARALLEL_H__
+
+#include "embedded_list.h"
+
+// 线程池最多的线程数（包括调用线程）
+#ifndef LIST_PARALLEL_MAX_THREADS
+#define LIST_PARALLEL_MAX_THREADS 16
+#endif
+
+typedef struct list_workers_t list_workers_t;
+typedef list_workers_t *list_workers_handle_t;
+
+// ========================= 线程池 =========================
+list_workers_handle_t list_workers_create(uint8_t thread_count);
+void list_workers_free(list_workers_handle_t workers);
+uint8_t list_workers_count(list_workers_handle_t workers);
+
+// ========================= 并行算法 =========================
+void list_parallel_for_each(list_workers_handle_t workers, list_handle_t list, list_foreach_func_t callback, void *user_data);
+uint16_t list_parallel_count_if(list_workers_handle_t workers, list_handle_t list, list_predicate_func_t predicate,
+                                const void *predicate_data);
+uint16_t list_parallel_remove_if(list_workers_handle_t workers, list_handle_t list, list_predicate_func_t predicate,
+                                 const void *predicate_data);
+
+// ========================= 并行恢复 =========================
+bool list_parallel_deserialize(list_workers_handle_t workers, list_handle_t list, const void *buffer, uint32_t buffer_size);
+
+#endif
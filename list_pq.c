@@ -0,0 +1,307 @@
+#include "list_pq.h"
+#include <string.h>
+
+#define LIST_LOCK(list) LIST_MUTEX_LOCK((list)->mutex)
+#define LIST_UNLOCK(list) LIST_MUTEX_UNLOCK((list)->mutex)
+
+static inline const void *list_pq_data(list_pq_handle_t pq, uint16_t heap_index)
+{
+	return list_slot_node(pq->list, pq->heap[heap_index])->data;
+}
+
+static inline void list_pq_set(list_pq_handle_t pq, uint16_t heap_index, uint16_t slot)
+{
+	pq->heap[heap_index] = slot;
+	pq->heap_pos[slot] = heap_index;
+}
+
+static void list_pq_sift_up(list_pq_handle_t pq, uint16_t i)
+{
+	uint16_t slot = pq->heap[i];
+	const void *data = list_slot_node(pq->list, slot)->data;
+
+	while (i > 0)
+	{
+		uint16_t parent = (uint16_t)((i - 1) / 2);
+		if (pq->compare(data, list_pq_data(pq, parent)) >= 0)
+			break;
+
+		list_pq_set(pq, i, pq->heap[parent]);
+		i = parent;
+	}
+
+	list_pq_set(pq, i, slot);
+}
+
+static void list_pq_sift_down(list_pq_handle_t pq, uint16_t i, uint16_t count)
+{
+	uint16_t slot = pq->heap[i];
+	const void *data = list_slot_node(pq->list, slot)->data;
+
+	while (true)
+	{
+		uint32_t child = 2 * (uint32_t)i + 1;
+		if (child >= count)
+			break;
+
+		if (child + 1 < count && pq->compare(list_pq_data(pq, (uint16_t)(child + 1)), list_pq_data(pq, (uint16_t)child)) < 0)
+			child++;
+
+		if (pq->compare(list_pq_data(pq, (uint16_t)child), data) >= 0)
+			break;
+
+		list_pq_set(pq, i, pq->heap[child]);
+		i = (uint16_t)child;
+	}
+
+	list_pq_set(pq, i, slot);
+}
+
+// 检查迭代器是否指向队列中的元素，返回其槽位索引
+static uint16_t list_pq_slot(list_pq_handle_t pq, list_iterator_t it)
+{
+	uint16_t slot = list_node_slot(pq->list, it);
+	if (slot == LIST_INVALID_SLOT)
+		return LIST_INVALID_SLOT;
+
+	uint16_t pos = pq->heap_pos[slot];
+	if (pos >= pq->list->size || pq->heap[pos] != slot)
+		return LIST_INVALID_SLOT;
+
+	return slot;
+}
+
+// 从堆中删除位置 i 的元素并释放对应节点
+static void list_pq_remove_at(list_pq_handle_t pq, uint16_t i)
+{
+	uint16_t count = pq->list->size;
+	list_iterator_t node = list_slot_node(pq->list, pq->heap[i]);
+
+	count--;
+	if (i < count)
+	{
+		// 用最后一个元素填补空位，再向上或向下调整
+		uint16_t moved = pq->heap[count];
+		list_pq_set(pq, i, moved);
+		list_pq_sift_up(pq, i);
+		list_pq_sift_down(pq, pq->heap_pos[moved], count);
+	}
+
+	list_erase(pq->list, node);
+}
+
+static list_pq_handle_t list_pq_init(list_handle_t list, uint16_t *heap_buf, list_compare_func_t compare, bool is_static)
+{
+	list_pq_handle_t pq = (list_pq_handle_t)malloc(sizeof(list_pq_t));
+	if (pq == NULL)
+		return NULL;
+
+	pq->list = list;
+	pq->heap = heap_buf;
+	pq->heap_pos = heap_buf + list->capacity;
+	pq->compare = compare;
+	pq->is_static = is_static;
+	return pq;
+}
+
+list_pq_handle_t list_pq_create(uint16_t capacity, uint16_t element_size, list_compare_func_t compare)
+{
+	if (compare == NULL)
+		return NULL;
+
+	list_handle_t list = list_create(capacity, element_size);
+	if (list == NULL)
+		return NULL;
+
+	uint16_t *heap_buf = (uint16_t *)malloc(LIST_PQ_HEAP_BUF_COUNT(capacity) * sizeof(uint16_t));
+	if (heap_buf == NULL)
+	{
+		list_free(list);
+		return NULL;
+	}
+
+	list_pq_handle_t pq = list_pq_init(list, heap_buf, compare, false);
+	if (pq == NULL)
+	{
+		free(heap_buf);
+		list_free(list);
+	}
+	return pq;
+}
+
+list_pq_handle_t list_pq_create_from_buf(void *node_pool_buf, uint16_t *heap_buf, uint16_t capacity,
+                                         uint16_t element_size, list_compare_func_t compare)
+{
+	if (heap_buf == NULL || compare == NULL)
+		return NULL;
+
+	list_handle_t list = list_create_from_buf(node_pool_buf, capacity, element_size);
+	if (list == NULL)
+		return NULL;
+
+	list_pq_handle_t pq = list_pq_init(list, heap_buf, compare, true);
+	if (pq == NULL)
+		list_free(list);
+	return pq;
+}
+
+void list_pq_free(list_pq_handle_t pq)
+{
+	if (pq == NULL)
+		return;
+
+	if (!pq->is_static)
+		free(pq->heap);
+	list_free(pq->list);
+	free(pq);
+}
+
+bool list_pq_empty(list_pq_handle_t pq)
+{
+	return pq ? list_empty(pq->list) : true;
+}
+
+uint16_t list_pq_size(list_pq_handle_t pq)
+{
+	return pq ? list_size(pq->list) : 0;
+}
+
+/**
+ * @brief 插入元素
+ * @param pq 优先队列
+ * @param element 元素
+ * @return 指向新元素的迭代器，队列已满时返回NULL
+ * @note 时间复杂度O(log n)
+ */
+list_iterator_t list_pq_push(list_pq_handle_t pq, const void *element)
+{
+	if (pq == NULL || element == NULL)
+		return NULL;
+
+	LIST_LOCK(pq->list);
+
+	if (!list_push_back(pq->list, element))
+	{
+		LIST_UNLOCK(pq->list);
+		return NULL;
+	}
+
+	list_iterator_t node = pq->list->tail;
+	uint16_t i = (uint16_t)(pq->list->size - 1);
+	list_pq_set(pq, i, list_node_slot(pq->list, node));
+	list_pq_sift_up(pq, i);
+
+	LIST_UNLOCK(pq->list);
+	return node;
+}
+
+/**
+ * @brief 获取优先级最高（最小）的元素
+ * @param pq 优先队列
+ * @return 迭代器，队列为空时返回NULL
+ */
+list_iterator_t list_pq_top(list_pq_handle_t pq)
+{
+	if (pq == NULL)
+		return NULL;
+
+	LIST_LOCK(pq->list);
+	list_iterator_t node = (pq->list->size > 0) ? list_slot_node(pq->list, pq->heap[0]) : NULL;
+	LIST_UNLOCK(pq->list);
+	return node;
+}
+
+/**
+ * @brief 弹出优先级最高（最小）的元素
+ * @param pq 优先队列
+ * @param element 保存弹出的元素，不需要时传NULL
+ * @return 是否成功，队列为空时返回 false
+ * @note 时间复杂度O(log n)
+ */
+bool list_pq_pop_min(list_pq_handle_t pq, void *element)
+{
+	if (pq == NULL)
+		return false;
+
+	LIST_LOCK(pq->list);
+
+	if (pq->list->size == 0)
+	{
+		LIST_UNLOCK(pq->list);
+		return false;
+	}
+
+	if (element != NULL)
+		memcpy(element, list_pq_data(pq, 0), pq->list->element_size);
+
+	list_pq_remove_at(pq, 0);
+
+	LIST_UNLOCK(pq->list);
+	return true;
+}
+
+/**
+ * @brief 修改元素的键值
+ * @param pq 优先队列
+ * @param it list_pq_push 返回的迭代器
+ * @param element 新的元素值
+ * @return 是否成功，迭代器不在队列中时返回 false
+ * @note 通常用于提前定时器（减小键值），键值增大时同样会调整到正确位置
+ * @note 时间复杂度O(log n)，迭代器保持有效
+ */
+bool list_pq_decrease_key(list_pq_handle_t pq, list_iterator_t it, const void *element)
+{
+	if (pq == NULL || element == NULL)
+		return false;
+
+	LIST_LOCK(pq->list);
+
+	uint16_t slot = list_pq_slot(pq, it);
+	if (slot == LIST_INVALID_SLOT)
+	{
+		LIST_UNLOCK(pq->list);
+		return false;
+	}
+
+	list_replace(pq->list, it, element);
+	list_pq_sift_up(pq, pq->heap_pos[slot]);
+	list_pq_sift_down(pq, pq->heap_pos[slot], pq->list->size);
+
+	LIST_UNLOCK(pq->list);
+	return true;
+}
+
+/**
+ * @brief 删除指定元素（例如取消定时器）
+ * @param pq 优先队列
+ * @param it list_pq_push 返回的迭代器
+ * @return 是否成功，迭代器不在队列中时返回 false
+ * @note 时间复杂度O(log n)
+ */
+bool list_pq_remove(list_pq_handle_t pq, list_iterator_t it)
+{
+	if (pq == NULL)
+		return false;
+
+	LIST_LOCK(pq->list);
+
+	uint16_t slot = list_pq_slot(pq, it);
+	if (slot == LIST_INVALID_SLOT)
+	{
+		LIST_UNLOCK(pq->list);
+		return false;
+	}
+
+	list_pq_remove_at(pq, pq->heap_pos[slot]);
+
+	LIST_UNLOCK(pq->list);
+	return true;
+}
+
+void list_pq_clear(list_pq_handle_t pq)
+{
+	if (pq == NULL)
+		return;
+
+	list_clear(pq->list);
+}
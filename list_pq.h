@@ -0,0 +1,68 @@
+/**
+ * @file list_pq.h
+ * @brief Embedded-List: 基于节点池的优先队列
+ *
+ * 元素仍然存放在 list_t 的节点池中（按插入顺序链接，可以用普通迭代器遍历），
+ * 另外维护一个以节点槽位索引为元素的二叉堆，提供 O(log n) 的插入、弹出最小值、
+ * 修改键值和删除操作，适合定时器、事件队列等场景。
+ *
+ * - 支持动态分配和静态分配（节点池和堆数组都可以由外部缓冲区提供）
+ * - 比较函数决定优先级，compare(a, b) < 0 表示 a 先出队
+ * - 通过 list_pq_push 返回的迭代器在元素出队或删除前一直有效
+ *
+ * @author DAI
+ * @date 2025-12-30
+ * @license MIT
+ */
+
+#ifndef __LIST_PQ_H__
+#define __LIST_PQ_H__
+
+#include "embedded_list.h"
+
+/**
+ * @brief 静态分配时堆数组需要的 uint16_t 元素个数
+ * @note 前 capacity 个元素为堆，后 capacity 个元素为槽位到堆位置的映射
+ */
+#define LIST_PQ_HEAP_BUF_COUNT(capacity) (2 * (uint32_t)(capacity))
+
+typedef struct
+{
+	list_handle_t list;           // 存储元素的链表（节点池）
+	uint16_t *heap;               // 二叉堆，元素为节点槽位索引
+	uint16_t *heap_pos;           // 槽位索引 -> 在堆中的位置
+	list_compare_func_t compare;  // 比较函数
+	bool is_static;               // 堆数组是否由外部提供
+} list_pq_t;
+
+typedef list_pq_t *list_pq_handle_t;
+
+// ========================= 创建和销毁 =========================
+list_pq_handle_t list_pq_create(uint16_t capacity, uint16_t element_size, list_compare_func_t compare);
+
+/**
+ * @brief 从外部缓冲区创建优先队列
+ * @param node_pool_buf 节点池缓冲区，要求同 list_create_from_buf
+ * @param heap_buf 堆数组缓冲区，至少 LIST_PQ_HEAP_BUF_COUNT(capacity) 个 uint16_t
+ * @param capacity 容量
+ * @param element_size 元素大小
+ * @param compare 比较函数
+ * @return 优先队列句柄，失败返回NULL
+ */
+list_pq_handle_t list_pq_create_from_buf(void *node_pool_buf, uint16_t *heap_buf, uint16_t capacity,
+                                         uint16_t element_size, list_compare_func_t compare);
+void list_pq_free(list_pq_handle_t pq);
+
+// ========================= 容量查询 =========================
+bool list_pq_empty(list_pq_handle_t pq);
+uint16_t list_pq_size(list_pq_handle_t pq);
+
+// ========================= 队列操作 =========================
+list_iterator_t list_pq_push(list_pq_handle_t pq, const void *element);
+list_iterator_t list_pq_top(list_pq_handle_t pq);
+bool list_pq_pop_min(list_pq_handle_t pq, void *element);
+bool list_pq_decrease_key(list_pq_handle_t pq, list_iterator_t it, const void *element);
+bool list_pq_remove(list_pq_handle_t pq, list_iterator_t it);
+void list_pq_clear(list_pq_handle_t pq);
+
+#endif
@@ -1,4 +1,5 @@
 #include "list_save.h"
+#include "list_crc.h"
 #include <stddef.h>
 #include <string.h>
 
@@ -9,23 +10,18 @@
 // 节点大小：结构体大小 + 数据大小，然后对齐到4字节（ARM指针对齐要求）
 #define LIST_NODE_SIZE(element_size) ALIGN_UP(sizeof(list_node_t) + ((element_size) > 0 ? (element_size) : 1), 4)
 
-static uint16_t list_node_to_index(list_handle_t list, list_node_t *node)
-{
-	if (node == NULL || list == NULL || list->node_pool == NULL)
-		return 0xFFFF;  // 无效索引
-
-	size_t node_size = LIST_NODE_SIZE(list->element_size);
-	ptrdiff_t byte_diff = (uint8_t *)node - (uint8_t *)list->node_pool;
-
-	if (byte_diff < 0 || (byte_diff % node_size) != 0)
-		return 0xFFFF;
-
-	uint16_t index = (uint16_t)(byte_diff / node_size);
-	if (index >= list->capacity)
-		return 0xFFFF;
-
-	return index;
-}
+// 线上布局检查：持久化结构体的大小和字段偏移必须与格式定义一致，编译器插入填充时编译失败
+#define LIST_LAYOUT_ASSERT(name, cond) typedef char list_layout_##name[(cond) ? 1 : -1]
+LIST_LAYOUT_ASSERT(persist_header, sizeof(list_persist_header_t) == 6);
+LIST_LAYOUT_ASSERT(save_header, sizeof(list_save_header_t) == 16);
+LIST_LAYOUT_ASSERT(persist_node, offsetof(list_persist_node_t, data) == 2);
+LIST_LAYOUT_ASSERT(checked_header, sizeof(list_stream_checked_header_t) == 16);
+LIST_LAYOUT_ASSERT(pack_header, sizeof(list_pack_header_t) == 24);
+LIST_LAYOUT_ASSERT(pack_raw_size, offsetof(list_pack_header_t, raw_size) == 16);
+LIST_LAYOUT_ASSERT(image_header, sizeof(list_image_header_t) == 20);
+LIST_LAYOUT_ASSERT(image_record, offsetof(list_image_record_t, data) == 4);
+LIST_LAYOUT_ASSERT(delta_header, sizeof(list_delta_header_t) == 24);
+LIST_LAYOUT_ASSERT(delta_record, sizeof(list_delta_record_t) == 8);
 
 static list_node_t *list_index_to_node(list_handle_t list, uint16_t index)
 {
@@ -41,17 +37,85 @@ static inline size_t list_persist_node_size(uint16_t element_size)
 	return sizeof(uint16_t) + element_size;  // index + data
 }
 
-uint32_t list_get_serialize_size(list_handle_t list)
+// 按小端字节序写入/读取 list_persist_header_t
+static void list_persist_header_store(void *buffer, list_handle_t list)
 {
-	if (list == NULL)
-		return 0;
+	uint8_t *p = (uint8_t *)buffer;
+	list_store_le16(p + offsetof(list_persist_header_t, size), list->size);
+	list_store_le16(p + offsetof(list_persist_header_t, capacity), list->capacity);
+	list_store_le16(p + offsetof(list_persist_header_t, element_size), list->element_size);
+}
+
+static void list_persist_header_load(list_persist_header_t *header, const void *buffer)
+{
+	const uint8_t *p = (const uint8_t *)buffer;
+	header->size = list_load_le16(p + offsetof(list_persist_header_t, size));
+	header->capacity = list_load_le16(p + offsetof(list_persist_header_t, capacity));
+	header->element_size = list_load_le16(p + offsetof(list_persist_header_t, element_size));
+}
 
+// 校验头部之后 list_persist_header_t 格式数据的字节数
+static uint32_t list_persist_data_size(list_handle_t list)
+{
 	// 头部大小（不包含nodes[]）+ 节点数组大小
 	// sizeof(list_persist_header_t) 不包含灵活数组成员 nodes[]
 	size_t node_persist_size = list_persist_node_size(list->element_size);
 	return sizeof(list_persist_header_t) + list->size * node_persist_size;
 }
 
+uint32_t list_get_serialize_size(list_handle_t list)
+{
+	if (list == NULL)
+		return 0;
+
+	return sizeof(list_save_header_t) + list_persist_data_size(list);
+}
+
+// 填写校验头部，CRC32C 覆盖 crc 之前的字段和后面 length 字节数据
+static void list_save_header_store(void *buffer, uint32_t length)
+{
+	uint8_t *p = (uint8_t *)buffer;
+	list_store_le32(p + offsetof(list_save_header_t, magic), LIST_SAVE_MAGIC);
+	list_store_le16(p + offsetof(list_save_header_t, version), LIST_SAVE_VERSION);
+	list_store_le16(p + offsetof(list_save_header_t, reserved), 0);
+	list_store_le32(p + offsetof(list_save_header_t, length), length);
+	uint32_t crc = list_crc32c(0, p, offsetof(list_save_header_t, crc));
+	crc = list_crc32c(crc, p + sizeof(list_save_header_t), length);
+	list_store_le32(p + offsetof(list_save_header_t, crc), crc);
+}
+
+bool list_check_serialized(const void *buffer, uint32_t buffer_size, const void **data, uint32_t *data_size)
+{
+	if (buffer == NULL || data == NULL || data_size == NULL)
+		return false;
+
+	const uint8_t *p = (const uint8_t *)buffer;
+	if (buffer_size < sizeof(uint32_t) || list_load_le32(p + offsetof(list_save_header_t, magic)) != LIST_SAVE_MAGIC)
+	{
+		// 没有校验头部的旧数据
+		*data = buffer;
+		*data_size = buffer_size;
+		return true;
+	}
+
+	if (buffer_size < sizeof(list_save_header_t) ||
+	    list_load_le16(p + offsetof(list_save_header_t, version)) != LIST_SAVE_VERSION)
+		return false;
+
+	uint32_t length = list_load_le32(p + offsetof(list_save_header_t, length));
+	if (length > buffer_size - sizeof(list_save_header_t))
+		return false;
+
+	uint32_t crc = list_crc32c(0, p, offsetof(list_save_header_t, crc));
+	crc = list_crc32c(crc, p + sizeof(list_save_header_t), length);
+	if (crc != list_load_le32(p + offsetof(list_save_header_t, crc)))
+		return false;
+
+	*data = p + sizeof(list_save_header_t);
+	*data_size = length;
+	return true;
+}
+
 uint32_t list_serialize(list_handle_t list, void *buffer, uint32_t buffer_size)
 {
 	if (list == NULL || buffer == NULL)
@@ -64,10 +128,8 @@ uint32_t list_serialize(list_handle_t list, void *buffer, uint32_t buffer_size)
 	LIST_LOCK(list);
 
 	// 填充头部
-	list_persist_header_t *header = (list_persist_header_t *)buffer;
-	header->size = list->size;
-	header->capacity = list->capacity;
-	header->element_size = list->element_size;
+	uint8_t *data = (uint8_t *)buffer + sizeof(list_save_header_t);
+	list_persist_header_store(data, list);
 
 	// 填充节点数组（按照链表的逻辑顺序，每个节点包含index和data）
 	size_t node_persist_size = list_persist_node_size(list->element_size);
@@ -76,21 +138,20 @@ uint32_t list_serialize(list_handle_t list, void *buffer, uint32_t buffer_size)
 	uint16_t idx = 0;
 
 	// 节点起始地址（注意：list_persist_node_t包含灵活数组，不能直接用数组索引）
-	uint8_t *node_ptr = (uint8_t *)header + sizeof(list_persist_header_t);
+	uint8_t *node_ptr = data + sizeof(list_persist_header_t);
 
 	while (current != NULL && idx < list->size)
 	{
-		uint16_t node_idx = list_node_to_index(list, current);
-		if (node_idx == 0xFFFF)
+		uint16_t node_idx = list_node_slot(list, current);
+		if (node_idx == LIST_INVALID_SLOT)
 		{
 			LIST_UNLOCK(list);
 			return 0;  // 错误
 		}
 
-		// 手动计算偏移（因为list_persist_node_t包含灵活数组data[]）
-		list_persist_node_t *persist_node = (list_persist_node_t *)node_ptr;
-		persist_node->index = node_idx;
-		memcpy(persist_node->data, current->data, list->element_size);
+		// 手动计算偏移（因为list_persist_node_t包含灵活数组data[]），记录不保证对齐
+		list_store_le16(node_ptr + offsetof(list_persist_node_t, index), node_idx);
+		memcpy(node_ptr + offsetof(list_persist_node_t, data), current->data, list->element_size);
 
 		// 移动到下一个节点
 		node_ptr += node_persist_size;
@@ -100,6 +161,8 @@ uint32_t list_serialize(list_handle_t list, void *buffer, uint32_t buffer_size)
 	}
 
 	LIST_UNLOCK(list);
+
+	list_save_header_store(buffer, required_size - (uint32_t)sizeof(list_save_header_t));
 	return required_size;
 }
 // 反序列化：从缓冲区恢复链表
@@ -108,7 +171,16 @@ bool list_deserialize(list_handle_t list, const void *buffer, uint32_t buffer_si
 	if (list == NULL || buffer == NULL)
 		return false;
 
-	const list_persist_header_t *header = (const list_persist_header_t *)buffer;
+	// 校验失败时不修改链表，之后只使用校验头部后面的数据
+	if (!list_check_serialized(buffer, buffer_size, &buffer, &buffer_size))
+		return false;
+
+	if (buffer_size < sizeof(list_persist_header_t))
+		return false;
+
+	list_persist_header_t header_host;
+	list_persist_header_load(&header_host, buffer);
+	const list_persist_header_t *header = &header_host;
 
 	// 验证头部信息
 	// 1. 旧链表的size不能超过其capacity
@@ -119,6 +191,10 @@ bool list_deserialize(list_handle_t list, const void *buffer, uint32_t buffer_si
 	    list->capacity < header->capacity)
 		return false;
 
+	// 反序列化会重建整个节点池的 free_list，不能用于共享节点池的列表
+	if (list->pool_owner != NULL || list->pool_users != 0)
+		return false;
+
 	// 计算所需大小
 	size_t node_persist_size = list_persist_node_size(header->element_size);
 	uint32_t required_size = sizeof(list_persist_header_t) +
@@ -153,13 +229,12 @@ bool list_deserialize(list_handle_t list, const void *buffer, uint32_t buffer_si
 	list_node_t *prev_node = NULL;
 
 	// 读取节点数组，list_persist_node_t包含灵活数组，不能直接用数组索引
-	const uint8_t *node_ptr = (const uint8_t *)header + sizeof(list_persist_header_t);
+	const uint8_t *node_ptr = (const uint8_t *)buffer + sizeof(list_persist_header_t);
 
 	for (uint16_t i = 0; i < header->size; i++)
 	{
 		// 手动计算偏移，因为list_persist_node_t包含灵活数组data[]
-		const list_persist_node_t *persist_node = (const list_persist_node_t *)node_ptr;
-		uint16_t node_idx = persist_node->index;
+		uint16_t node_idx = list_load_le16(node_ptr + offsetof(list_persist_node_t, index));
 
 		if (node_idx >= list->capacity || node_used[node_idx])
 		{
@@ -178,7 +253,7 @@ bool list_deserialize(list_handle_t list, const void *buffer, uint32_t buffer_si
 		node_used[node_idx] = true;
 
 		// 恢复数据
-		memcpy(node->data, persist_node->data, list->element_size);
+		memcpy(node->data, node_ptr + offsetof(list_persist_node_t, data), list->element_size);
 
 		// 移动到下一个节点
 		node_ptr += node_persist_size;
@@ -219,6 +294,1828 @@ bool list_deserialize(list_handle_t list, const void *buffer, uint32_t buffer_si
 	}
 
 	free(node_used);
+
+	list_rebuild_live_map(list);
+	list_notify(list, LIST_EVENT_RESET, NULL);
+
+	LIST_UNLOCK(list);
+	return true;
+}
+// ========================= 流式序列化 =========================
+
+// 清空链表并把所有槽位放回 free_list（不发出事件）
+static void list_reset_pool(list_handle_t list)
+{
+	size_t node_size = LIST_NODE_SIZE(list->element_size);
+	list->head = NULL;
+	list->tail = NULL;
+	list->size = 0;
+	list->free_list = NULL;
+	for (uint16_t i = 0; i < list->capacity; i++)
+	{
+		list_node_t *node = (list_node_t *)((uint8_t *)list->node_pool + i * node_size);
+		node->next = list->free_list;
+		node->prev = NULL;
+		list->free_list = node;
+	}
+}
+
+typedef struct
+{
+	list_handle_t list;
+	list_node_t *cursor;  // 下一个要写出的节点
+	uint32_t offset;      // cursor 对应记录中已写出的字节数
+	bool modified;        // 两个块之间链表被修改过
+	list_observer_t observer;
+} list_stream_writer_t;
+
+static void list_stream_on_event(list_handle_t list, list_event_t event, list_iterator_t node, void *ctx)
+{
+	(void)list;
+	(void)event;
+	(void)node;
+	((list_stream_writer_t *)ctx)->modified = true;
+}
+
+// 从 cursor 开始把记录复制到块中，返回写入块中的字节数，记录可以跨越两个块
+static uint32_t list_stream_fill(list_stream_writer_t *writer, uint8_t *chunk, uint32_t used, uint32_t chunk_size)
+{
+	list_handle_t list = writer->list;
+	uint32_t record_size = (uint32_t)list_persist_node_size(list->element_size);
+
+	while (used < chunk_size && writer->cursor != NULL)
+	{
+		uint16_t index = list_le16(list_node_slot(list, writer->cursor));
+		const uint8_t *index_bytes = (const uint8_t *)&index;
+
+		while (writer->offset < sizeof(uint16_t) && used < chunk_size)
+			chunk[used++] = index_bytes[writer->offset++];
+
+		uint32_t n = record_size - writer->offset;
+		if (n > chunk_size - used)
+			n = chunk_size - used;
+		memcpy(chunk + used, writer->cursor->data + (writer->offset - sizeof(uint16_t)), n);
+		used += n;
+		writer->offset += n;
+
+		if (writer->offset == record_size)
+		{
+			writer->cursor = writer->cursor->next;
+			writer->offset = 0;
+		}
+	}
+	return used;
+}
+
+// checked 为true时每块写成一帧：uint32_t 长度 + 数据 + uint32_t CRC32C，返回写入的总字节数（包括帧）
+static uint32_t list_serialize_stream_impl(list_handle_t list, list_stream_write_func_t write, void *ctx,
+                                           uint32_t chunk_size, bool checked)
+{
+	if (list == NULL || write == NULL || chunk_size < sizeof(list_persist_header_t))
+		return 0;
+
+	uint32_t frame_overhead = checked ? 2 * (uint32_t)sizeof(uint32_t) : 0;
+	uint8_t *chunk = (uint8_t *)malloc((size_t)chunk_size + frame_overhead);
+	if (chunk == NULL)
+		return 0;
+	uint8_t *payload = chunk + (checked ? sizeof(uint32_t) : 0);
+
+	if (checked)
+	{
+		list_stream_checked_header_t stream_header;
+		stream_header.magic = list_le32(LIST_STREAM_CHECKED_MAGIC);
+		stream_header.version = list_le16(LIST_STREAM_CHECKED_VERSION);
+		stream_header.reserved = 0;
+		stream_header.chunk_size = list_le32(chunk_size);
+		stream_header.crc = list_le32(list_crc32c(0, &stream_header, offsetof(list_stream_checked_header_t, crc)));
+		if (!write(&stream_header, sizeof(stream_header), ctx))
+		{
+			free(chunk);
+			return 0;
+		}
+	}
+
+	list_stream_writer_t writer;
+	memset(&writer, 0, sizeof(writer));
+	writer.list = list;
+	writer.observer.callback = list_stream_on_event;
+	writer.observer.ctx = &writer;
+
+	LIST_LOCK(list);
+	uint32_t total = list_persist_data_size(list);
+	list_persist_header_store(payload, list);
+	writer.cursor = list->head;
+	list_add_observer(list, &writer.observer);
+
+	uint32_t written = 0;
+	uint32_t frames = 0;
+	uint32_t used = sizeof(list_persist_header_t);
+	bool ok = true;
+	for (;;)
+	{
+		// 第一块已经在锁内，之后每块重新加锁
+		if (written != 0)
+			LIST_LOCK(list);
+		if (writer.modified)
+		{
+			LIST_UNLOCK(list);
+			ok = false;
+			break;
+		}
+		used = list_stream_fill(&writer, payload, used, chunk_size);
+		LIST_UNLOCK(list);
+
+		if (checked)
+		{
+			list_store_le32(chunk, used);
+			list_store_le32(payload + used, list_crc32c(0, chunk, sizeof(uint32_t) + used));
+		}
+		if (!write(chunk, used + frame_overhead, ctx))
+		{
+			ok = false;
+			break;
+		}
+		written += used;
+		frames++;
+		used = 0;
+		if (written >= total)
+			break;
+	}
+
+	LIST_LOCK(list);
+	list_remove_observer(list, &writer.observer);
+	LIST_UNLOCK(list);
+
+	free(chunk);
+	if (!ok || written != total)
+		return 0;
+	return checked ? (uint32_t)sizeof(list_stream_checked_header_t) + total + frames * frame_overhead : total;
+}
+
+uint32_t list_serialize_stream(list_handle_t list, list_stream_write_func_t write, void *ctx, uint32_t chunk_size)
+{
+	return list_serialize_stream_impl(list, write, ctx, chunk_size, false);
+}
+
+uint32_t list_serialize_stream_checked(list_handle_t list, list_stream_write_func_t write, void *ctx,
+                                       uint32_t chunk_size)
+{
+	return list_serialize_stream_impl(list, write, ctx, chunk_size, true);
+}
+
+typedef struct
+{
+	list_stream_read_func_t read;
+	void *ctx;
+	uint8_t buffer[LIST_STREAM_READ_SIZE];
+	uint32_t pos;
+	uint32_t len;
+} list_stream_reader_t;
+
+// 读取恰好 size 字节，数据不足时返回false
+static bool list_stream_read(list_stream_reader_t *reader, void *dst, uint32_t size)
+{
+	uint8_t *out = (uint8_t *)dst;
+	while (size > 0)
+	{
+		if (reader->pos == reader->len)
+		{
+			reader->pos = 0;
+			reader->len = reader->read(reader->buffer, sizeof(reader->buffer), reader->ctx);
+			if (reader->len == 0 || reader->len > sizeof(reader->buffer))
+			{
+				reader->len = 0;
+				return false;
+			}
+		}
+		uint32_t n = reader->len - reader->pos;
+		if (n > size)
+			n = size;
+		memcpy(out, reader->buffer + reader->pos, n);
+		reader->pos += n;
+		out += n;
+		size -= n;
+	}
+	return true;
+}
+
+// 按顺序恢复节点时使用的状态：列表锁内由 list_restore_begin 开始，list_restore_end 结束
+typedef struct
+{
+	list_handle_t list;
+	uint32_t *used;         // 已使用的槽位位图
+	list_node_t *prev;      // 上一个恢复的节点
+	uint16_t count;         // 已恢复的节点数量
+} list_restore_t;
+
+static bool list_restore_begin(list_restore_t *restore, list_handle_t list)
+{
+	restore->list = list;
+	restore->prev = NULL;
+	restore->count = 0;
+	restore->used = (uint32_t *)calloc(LIST_LIVE_MAP_WORDS(list->capacity), sizeof(uint32_t));
+	if (restore->used == NULL)
+		return false;
+	list_clear(list);
+	return true;
+}
+
+// 把槽位 node_idx 作为下一个节点链接到链表末尾，返回节点（由调用者填写数据），槽位无效或重复时返回NULL
+static list_node_t *list_restore_append(list_restore_t *restore, uint16_t node_idx)
+{
+	list_handle_t list = restore->list;
+	if (node_idx >= list->capacity || (restore->used[node_idx >> 5] & (1u << (node_idx & 31))) != 0)
+		return NULL;
+	restore->used[node_idx >> 5] |= 1u << (node_idx & 31);
+
+	list_node_t *node = list_index_to_node(list, node_idx);
+	node->prev = restore->prev;
+	node->next = NULL;
+	if (restore->prev == NULL)
+		list->head = node;
+	else
+		restore->prev->next = node;
+	restore->prev = node;
+	restore->count++;
+	return node;
+}
+
+// 结束恢复：成功时用未使用的槽位重建 free_list，失败时清空链表
+static bool list_restore_end(list_restore_t *restore, bool valid)
+{
+	list_handle_t list = restore->list;
+	if (valid)
+	{
+		list->tail = restore->prev;
+		list->size = restore->count;
+
+		list->free_list = NULL;
+		for (uint16_t i = 0; i < list->capacity; i++)
+		{
+			if ((restore->used[i >> 5] & (1u << (i & 31))) == 0)
+			{
+				list_node_t *node = list_index_to_node(list, i);
+				node->next = list->free_list;
+				node->prev = NULL;
+				list->free_list = node;
+			}
+		}
+	}
+	else
+	{
+		list_reset_pool(list);
+	}
+
+	free(restore->used);
+	restore->used = NULL;
+
+	list_rebuild_live_map(list);
+	list_notify(list, LIST_EVENT_RESET, NULL);
+	return valid;
+}
+
+bool list_deserialize_stream(list_handle_t list, list_stream_read_func_t read, void *ctx)
+{
+	if (list == NULL || read == NULL)
+		return false;
+
+	// 反序列化会重建整个节点池的 free_list，不能用于共享节点池的列表
+	if (list->pool_owner != NULL || list->pool_users != 0)
+		return false;
+
+	list_stream_reader_t reader;
+	reader.read = read;
+	reader.ctx = ctx;
+	reader.pos = 0;
+	reader.len = 0;
+
+	uint8_t header_bytes[sizeof(list_persist_header_t)];
+	list_persist_header_t header;
+	if (!list_stream_read(&reader, header_bytes, sizeof(header_bytes)))
+		return false;
+	list_persist_header_load(&header, header_bytes);
+	if (header.size > header.capacity ||
+	    header.element_size != list->element_size ||
+	    list->capacity < header.capacity)
+		return false;
+
+	LIST_LOCK(list);
+	list_restore_t restore;
+	if (!list_restore_begin(&restore, list))
+	{
+		LIST_UNLOCK(list);
+		return false;
+	}
+
+	bool valid = true;
+	for (uint16_t i = 0; i < header.size && valid; i++)
+	{
+		uint8_t index_bytes[sizeof(uint16_t)];
+		list_node_t *node = NULL;
+		if (list_stream_read(&reader, index_bytes, sizeof(index_bytes)))
+			node = list_restore_append(&restore, list_load_le16(index_bytes));
+		valid = node != NULL && list_stream_read(&reader, node->data, list->element_size);
+	}
+
+	list_restore_end(&restore, valid);
 	LIST_UNLOCK(list);
+	return valid;
+}
+
+// 带校验的流：每次读取并校验一整帧，然后把帧中的数据交给 list_deserialize_stream
+typedef struct
+{
+	list_stream_read_func_t read;
+	void *ctx;
+	uint8_t *frame;       // 帧缓冲区：长度 + 数据
+	uint32_t chunk_size;  // 帧中数据的最大字节数
+	uint32_t pos;         // 当前帧中已交出的数据字节数
+	uint32_t len;         // 当前帧的数据字节数
+} list_stream_verifier_t;
+
+// 从读取回调读取恰好 size 字节
+static bool list_stream_read_exact(list_stream_read_func_t read, void *ctx, void *dst, uint32_t size)
+{
+	uint8_t *out = (uint8_t *)dst;
+	while (size > 0)
+	{
+		uint32_t n = read(out, size, ctx);
+		if (n == 0 || n > size)
+			return false;
+		out += n;
+		size -= n;
+	}
 	return true;
-}
\ No newline at end of file
+}
+
+static uint32_t list_stream_verified_read(void *data, uint32_t size, void *ctx)
+{
+	list_stream_verifier_t *verifier = (list_stream_verifier_t *)ctx;
+	if (verifier->pos == verifier->len)
+	{
+		uint8_t crc[sizeof(uint32_t)];
+		if (!list_stream_read_exact(verifier->read, verifier->ctx, verifier->frame, sizeof(uint32_t)))
+			return 0;
+		uint32_t len = list_load_le32(verifier->frame);
+		if (len == 0 || len > verifier->chunk_size ||
+		    !list_stream_read_exact(verifier->read, verifier->ctx, verifier->frame + sizeof(uint32_t), len) ||
+		    !list_stream_read_exact(verifier->read, verifier->ctx, crc, sizeof(crc)) ||
+		    list_load_le32(crc) != list_crc32c(0, verifier->frame, sizeof(uint32_t) + len))
+			return 0;
+		verifier->pos = 0;
+		verifier->len = len;
+	}
+
+	uint32_t n = verifier->len - verifier->pos;
+	if (n > size)
+		n = size;
+	memcpy(data, verifier->frame + sizeof(uint32_t) + verifier->pos, n);
+	verifier->pos += n;
+	return n;
+}
+
+bool list_deserialize_stream_checked(list_handle_t list, list_stream_read_func_t read, void *ctx)
+{
+	if (list == NULL || read == NULL)
+		return false;
+
+	list_stream_checked_header_t header;
+	if (!list_stream_read_exact(read, ctx, &header, sizeof(header)) ||
+	    list_le32(header.crc) != list_crc32c(0, &header, offsetof(list_stream_checked_header_t, crc)))
+		return false;
+	header.magic = list_le32(header.magic);
+	header.version = list_le16(header.version);
+	header.chunk_size = list_le32(header.chunk_size);
+	if (header.magic != LIST_STREAM_CHECKED_MAGIC || header.version != LIST_STREAM_CHECKED_VERSION ||
+	    header.chunk_size < sizeof(list_persist_header_t))
+		return false;
+
+	list_stream_verifier_t verifier;
+	verifier.read = read;
+	verifier.ctx = ctx;
+	verifier.chunk_size = header.chunk_size;
+	verifier.pos = 0;
+	verifier.len = 0;
+	verifier.frame = (uint8_t *)malloc((size_t)header.chunk_size + sizeof(uint32_t));
+	if (verifier.frame == NULL)
+		return false;
+
+	bool ok = list_deserialize_stream(list, list_stream_verified_read, &verifier);
+	free(verifier.frame);
+	return ok;
+}
+
+// ========================= 压缩格式 =========================
+
+// 哈希表位数，表在栈上占用 4 << LIST_PACK_LZ_HASH_BITS 字节
+#ifndef LIST_PACK_LZ_HASH_BITS
+#define LIST_PACK_LZ_HASH_BITS 12
+#endif
+#define LIST_PACK_LZ_MIN_MATCH 4
+#define LIST_PACK_LZ_MAX_OFFSET 65535
+
+static inline uint32_t list_lz_read32(const uint8_t *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint32_t list_lz_hash(uint32_t v)
+{
+	return (v * 2654435761u) >> (32 - LIST_PACK_LZ_HASH_BITS);
+}
+
+// 写入超过15的长度部分：若干个255加上余数
+static uint8_t *list_lz_put_length(uint8_t *op, const uint8_t *oend, uint32_t len)
+{
+	for (;;)
+	{
+		if (op >= oend)
+			return NULL;
+		if (len < 255)
+			break;
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = (uint8_t)len;
+	return op;
+}
+
+// 输出一个序列：字面量，然后是匹配（match_len 为0表示最后一个只有字面量的序列）
+static uint8_t *list_lz_emit(uint8_t *op, const uint8_t *oend, const uint8_t *literals, uint32_t literal_len,
+                             uint32_t offset, uint32_t match_len)
+{
+	if (op >= oend)
+		return NULL;
+
+	uint32_t extra = match_len != 0 ? match_len - LIST_PACK_LZ_MIN_MATCH : 0;
+	uint8_t *token = op++;
+	*token = (uint8_t)(((literal_len < 15 ? literal_len : 15) << 4) | (extra < 15 ? extra : 15));
+	if (literal_len >= 15 && (op = list_lz_put_length(op, oend, literal_len - 15)) == NULL)
+		return NULL;
+	if ((uint32_t)(oend - op) < literal_len)
+		return NULL;
+	memcpy(op, literals, literal_len);
+	op += literal_len;
+
+	if (match_len == 0)
+		return op;
+	if (oend - op < 2)
+		return NULL;
+	*op++ = (uint8_t)(offset & 0xFF);
+	*op++ = (uint8_t)(offset >> 8);
+	if (extra >= 15)
+		op = list_lz_put_length(op, oend, extra - 15);
+	return op;
+}
+
+static uint32_t list_lz_bound(uint32_t size)
+{
+	return size + size / 255 + 16;
+}
+
+static uint32_t list_lz_encode(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t dst_size)
+{
+	uint32_t table[1u << LIST_PACK_LZ_HASH_BITS];  // 保存位置 + 1，0表示空
+	memset(table, 0, sizeof(table));
+
+	const uint8_t *ip = src;
+	const uint8_t *anchor = src;
+	const uint8_t *iend = src + size;
+	uint8_t *op = dst;
+	const uint8_t *oend = dst + dst_size;
+
+	if (size >= LIST_PACK_LZ_MIN_MATCH)
+	{
+		const uint8_t *match_limit = iend - LIST_PACK_LZ_MIN_MATCH;
+		while (ip <= match_limit)
+		{
+			uint32_t sequence = list_lz_read32(ip);
+			uint32_t h = list_lz_hash(sequence);
+			uint32_t ref_pos = table[h];
+			table[h] = (uint32_t)(ip - src) + 1;
+
+			if (ref_pos != 0)
+			{
+				const uint8_t *ref = src + ref_pos - 1;
+				if (ip - ref <= LIST_PACK_LZ_MAX_OFFSET && list_lz_read32(ref) == sequence)
+				{
+					const uint8_t *m = ip + LIST_PACK_LZ_MIN_MATCH;
+					const uint8_t *r = ref + LIST_PACK_LZ_MIN_MATCH;
+					while (m < iend && *m == *r)
+					{
+						m++;
+						r++;
+					}
+					op = list_lz_emit(op, oend, anchor, (uint32_t)(ip - anchor), (uint32_t)(ip - ref),
+					                  (uint32_t)(m - ip));
+					if (op == NULL)
+						return 0;
+					ip = m;
+					anchor = ip;
+					continue;
+				}
+			}
+			ip++;
+		}
+	}
+
+	op = list_lz_emit(op, oend, anchor, (uint32_t)(iend - anchor), 0, 0);
+	return op != NULL ? (uint32_t)(op - dst) : 0;
+}
+
+// 读取超过15的长度部分
+static const uint8_t *list_lz_get_length(const uint8_t *ip, const uint8_t *iend, uint32_t *len)
+{
+	uint8_t b;
+	do
+	{
+		if (ip >= iend)
+			return NULL;
+		b = *ip++;
+		*len += b;
+	} while (b == 255);
+	return ip;
+}
+
+static uint32_t list_lz_decode(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t dst_size)
+{
+	const uint8_t *ip = src;
+	const uint8_t *iend = src + size;
+	uint8_t *op = dst;
+	uint8_t *oend = dst + dst_size;
+
+	while (ip < iend)
+	{
+		uint8_t token = *ip++;
+		uint32_t literal_len = token >> 4;
+		if (literal_len == 15 && (ip = list_lz_get_length(ip, iend, &literal_len)) == NULL)
+			return 0;
+		if ((uint32_t)(iend - ip) < literal_len || (uint32_t)(oend - op) < literal_len)
+			return 0;
+		memcpy(op, ip, literal_len);
+		ip += literal_len;
+		op += literal_len;
+
+		// 最后一个序列只有字面量
+		if (ip == iend)
+			break;
+
+		if (iend - ip < 2)
+			return 0;
+		uint32_t offset = (uint32_t)ip[0] | ((uint32_t)ip[1] << 8);
+		ip += 2;
+		uint32_t match_len = token & 15;
+		if (match_len == 15 && (ip = list_lz_get_length(ip, iend, &match_len)) == NULL)
+			return 0;
+		match_len += LIST_PACK_LZ_MIN_MATCH;
+		if (offset == 0 || offset > (uint32_t)(op - dst) || (uint32_t)(oend - op) < match_len)
+			return 0;
+
+		// 匹配可以与输出重叠（offset < match_len 时重复最近的字节）
+		const uint8_t *ref = op - offset;
+		if (offset >= match_len)
+		{
+			memcpy(op, ref, match_len);
+			op += match_len;
+		}
+		else
+		{
+			while (match_len-- > 0)
+				*op++ = *ref++;
+		}
+	}
+	return (uint32_t)(op - dst);
+}
+
+const list_pack_codec_t list_pack_lz = {LIST_PACK_CODEC_LZ, list_lz_bound, list_lz_encode, list_lz_decode};
+
+#define LIST_PACK_FLAGS (LIST_PACK_INDEX_DELTA | LIST_PACK_XOR_DELTA | LIST_PACK_ORDER_ONLY)
+
+// 编码后每条记录的最大字节数：索引差值的 zigzag 值最多18位，变长整数最多3字节
+static inline uint32_t list_pack_record_bound(uint16_t element_size, uint16_t flags)
+{
+	if (flags & LIST_PACK_ORDER_ONLY)
+		return element_size;
+	return ((flags & LIST_PACK_INDEX_DELTA) ? 3u : (uint32_t)sizeof(uint16_t)) + element_size;
+}
+
+static uint8_t *list_pack_put_varint(uint8_t *p, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		*p++ = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	*p++ = (uint8_t)value;
+	return p;
+}
+
+static const uint8_t *list_pack_get_varint(const uint8_t *p, const uint8_t *end, uint32_t *value)
+{
+	uint32_t v = 0;
+	for (uint32_t shift = 0; shift <= 14; shift += 7)
+	{
+		if (p >= end)
+			return NULL;
+		uint8_t b = *p++;
+		v |= (uint32_t)(b & 0x7F) << shift;
+		if ((b & 0x80) == 0)
+		{
+			*value = v;
+			return p;
+		}
+	}
+	return NULL;
+}
+
+// dst = a ^ b，按4字节处理（dst 可能不对齐）
+static inline void list_pack_xor(uint8_t *dst, const uint8_t *a, const uint8_t *b, uint16_t size)
+{
+	uint16_t k = 0;
+	for (; k + sizeof(uint32_t) <= size; k += sizeof(uint32_t))
+	{
+		uint32_t x, y;
+		memcpy(&x, a + k, sizeof(x));
+		memcpy(&y, b + k, sizeof(y));
+		x ^= y;
+		memcpy(dst + k, &x, sizeof(x));
+	}
+	for (; k < size; k++)
+		dst[k] = a[k] ^ b[k];
+}
+
+// 按链表顺序编码所有记录，返回字节数（需要在锁内调用）
+static uint32_t list_pack_records(list_handle_t list, uint8_t *out, uint16_t flags)
+{
+	uint8_t *p = out;
+	int32_t expected = 0;
+	const uint8_t *prev_data = NULL;
+
+	for (list_node_t *node = list->head; node != NULL; node = node->next)
+	{
+		if ((flags & LIST_PACK_ORDER_ONLY) == 0)
+		{
+			uint16_t index = list_node_slot(list, node);
+			if (flags & LIST_PACK_INDEX_DELTA)
+			{
+				int32_t delta = (int32_t)index - expected;
+				p = list_pack_put_varint(p, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+				expected = (int32_t)index + 1;
+			}
+			else
+			{
+				list_store_le16(p, index);
+				p += sizeof(index);
+			}
+		}
+
+		if ((flags & LIST_PACK_XOR_DELTA) && prev_data != NULL)
+		{
+			list_pack_xor(p, node->data, prev_data, list->element_size);
+		}
+		else
+		{
+			memcpy(p, node->data, list->element_size);
+		}
+		p += list->element_size;
+		prev_data = node->data;
+	}
+	return (uint32_t)(p - out);
+}
+
+// 在主机字节序和小端字节序之间转换头部（小端主机上不产生代码）
+static void list_pack_header_swap(list_pack_header_t *header)
+{
+	header->magic = list_le32(header->magic);
+	header->version = list_le16(header->version);
+	header->flags = list_le16(header->flags);
+	header->element_size = list_le16(header->element_size);
+	header->capacity = list_le16(header->capacity);
+	header->size = list_le16(header->size);
+	header->raw_size = list_le32(header->raw_size);
+	header->data_size = list_le32(header->data_size);
+}
+
+uint32_t list_get_pack_bound(list_handle_t list, uint16_t flags, const list_pack_codec_t *codec)
+{
+	if (list == NULL)
+		return 0;
+
+	uint32_t raw = (uint32_t)list->size * list_pack_record_bound(list->element_size, flags);
+	uint32_t data = raw;
+	if (codec != NULL && codec->bound != NULL && codec->bound(raw) > data)
+		data = codec->bound(raw);
+	return (uint32_t)sizeof(list_pack_header_t) + data + LIST_PACK_CRC_SIZE;
+}
+
+uint32_t list_serialize_packed(list_handle_t list, void *buffer, uint32_t buffer_size, uint16_t flags,
+                               const list_pack_codec_t *codec)
+{
+	if (list == NULL || buffer == NULL || buffer_size < sizeof(list_pack_header_t) + LIST_PACK_CRC_SIZE ||
+	    (flags & ~LIST_PACK_FLAGS) != 0)
+		return 0;
+	if (codec != NULL && (codec->id == LIST_PACK_CODEC_NONE || codec->encode == NULL))
+		return 0;
+	if (flags & LIST_PACK_ORDER_ONLY)
+		flags &= (uint16_t)~LIST_PACK_INDEX_DELTA;
+
+	list_pack_header_t host;
+	list_pack_header_t *header = &host;
+	uint8_t *data = (uint8_t *)buffer + sizeof(list_pack_header_t);
+	uint32_t data_room = buffer_size - (uint32_t)sizeof(list_pack_header_t) - LIST_PACK_CRC_SIZE;
+
+	LIST_LOCK(list);
+
+	// 不压缩时直接编码到输出缓冲区，压缩时先编码到临时内存，压缩在锁外进行
+	uint32_t raw_bound = (uint32_t)list->size * list_pack_record_bound(list->element_size, flags);
+	uint8_t *raw = NULL;
+	if (codec != NULL)
+		raw = (uint8_t *)malloc(raw_bound > 0 ? raw_bound : 1);
+	if (codec != NULL ? raw == NULL : data_room < raw_bound)
+	{
+		LIST_UNLOCK(list);
+		return 0;
+	}
+
+	header->magic = LIST_PACK_MAGIC;
+	header->version = LIST_PACK_VERSION;
+	header->flags = flags;
+	header->element_size = list->element_size;
+	header->capacity = list->capacity;
+	header->size = list->size;
+	header->codec = LIST_PACK_CODEC_NONE;
+	header->reserved = 0;
+	header->raw_size = list_pack_records(list, raw != NULL ? raw : data, flags);
+	header->data_size = header->raw_size;
+
+	LIST_UNLOCK(list);
+
+	if (raw != NULL)
+	{
+		uint32_t packed = codec->encode(raw, header->raw_size, data, data_room);
+		if (packed != 0 && packed < header->raw_size)
+		{
+			header->codec = codec->id;
+			header->data_size = packed;
+		}
+		else if (header->raw_size <= data_room)
+		{
+			// 压缩后没有变小，按不压缩保存
+			memcpy(data, raw, header->raw_size);
+		}
+		else
+		{
+			free(raw);
+			return 0;
+		}
+		free(raw);
+	}
+
+	// 版本2：数据后面是覆盖头部和数据的 CRC32C
+	uint32_t data_size = header->data_size;
+	list_pack_header_swap(header);
+	memcpy(buffer, header, sizeof(list_pack_header_t));
+	list_store_le32(data + data_size, list_crc32c(0, buffer, sizeof(list_pack_header_t) + data_size));
+	return (uint32_t)sizeof(list_pack_header_t) + data_size + LIST_PACK_CRC_SIZE;
+}
+
+// 恢复带槽位索引的记录
+static bool list_pack_restore_indexed(list_restore_t *restore, const list_pack_header_t *header, const uint8_t *raw)
+{
+	uint16_t element_size = restore->list->element_size;
+	const uint8_t *p = raw;
+	const uint8_t *end = raw + header->raw_size;
+	int32_t expected = 0;
+	for (uint16_t i = 0; i < header->size; i++)
+	{
+		int32_t index;
+		if (header->flags & LIST_PACK_INDEX_DELTA)
+		{
+			uint32_t zigzag = 0;
+			p = list_pack_get_varint(p, end, &zigzag);
+			index = expected + (int32_t)((zigzag >> 1) ^ (0u - (zigzag & 1)));
+		}
+		else if (end - p >= (ptrdiff_t)sizeof(uint16_t))
+		{
+			index = list_load_le16(p);
+			p += sizeof(uint16_t);
+		}
+		else
+		{
+			return false;
+		}
+		if (p == NULL || index < 0 || index >= LIST_INVALID_SLOT || end - p < (ptrdiff_t)element_size)
+			return false;
+
+		list_node_t *prev_node = restore->prev;
+		list_node_t *node = list_restore_append(restore, (uint16_t)index);
+		if (node == NULL)
+			return false;
+
+		if ((header->flags & LIST_PACK_XOR_DELTA) && prev_node != NULL)
+			list_pack_xor(node->data, p, prev_node->data, element_size);
+		else
+			memcpy(node->data, p, element_size);
+		p += element_size;
+		expected = index + 1;
+	}
+
+	return p == end;
+}
+
+// 恢复只保存顺序的记录：元素依次放入槽位 0..size-1，不需要检查槽位
+static bool list_pack_restore_order(list_restore_t *restore, const list_pack_header_t *header, const uint8_t *raw)
+{
+	list_handle_t list = restore->list;
+	if (header->raw_size != (uint32_t)header->size * list->element_size)
+		return false;
+
+	size_t node_size = LIST_NODE_SIZE(list->element_size);
+	list_node_t *prev = NULL;
+	for (uint16_t i = 0; i < header->size; i++)
+	{
+		list_node_t *node = (list_node_t *)((uint8_t *)list->node_pool + i * node_size);
+		if ((header->flags & LIST_PACK_XOR_DELTA) && prev != NULL)
+			list_pack_xor(node->data, raw, prev->data, list->element_size);
+		else
+			memcpy(node->data, raw, list->element_size);
+		raw += list->element_size;
+
+		node->prev = prev;
+		node->next = NULL;
+		if (prev == NULL)
+			list->head = node;
+		else
+			prev->next = node;
+		prev = node;
+		restore->used[i >> 5] |= 1u << (i & 31);
+	}
+
+	restore->prev = prev;
+	restore->count = header->size;
+	return true;
+}
+
+bool list_deserialize_packed(list_handle_t list, const void *buffer, uint32_t buffer_size,
+                             const list_pack_codec_t *codec)
+{
+	if (list == NULL || buffer == NULL || buffer_size < sizeof(list_pack_header_t))
+		return false;
+
+	list_pack_header_t host;
+	const list_pack_header_t *header = &host;
+	memcpy(&host, buffer, sizeof(host));
+	list_pack_header_swap(&host);
+	if (header->magic != LIST_PACK_MAGIC || header->version < 1 || header->version > LIST_PACK_VERSION ||
+	    (header->flags & ~LIST_PACK_FLAGS) != 0 ||
+	    header->size > header->capacity ||
+	    header->element_size != list->element_size ||
+	    list->capacity < ((header->flags & LIST_PACK_ORDER_ONLY) ? header->size : header->capacity) ||
+	    header->data_size > buffer_size - sizeof(list_pack_header_t))
+		return false;
+
+	// 反序列化会重建整个节点池的 free_list，不能用于共享节点池的列表
+	if (list->pool_owner != NULL || list->pool_users != 0)
+		return false;
+
+	const uint8_t *raw = (const uint8_t *)buffer + sizeof(list_pack_header_t);
+	if (header->version >= 2)
+	{
+		if (buffer_size - sizeof(list_pack_header_t) - header->data_size < LIST_PACK_CRC_SIZE ||
+		    list_load_le32(raw + header->data_size) !=
+		        list_crc32c(0, buffer, sizeof(list_pack_header_t) + header->data_size))
+			return false;
+	}
+
+	uint8_t *decoded = NULL;
+	if (header->codec != LIST_PACK_CODEC_NONE)
+	{
+		if (codec == NULL || codec->id != header->codec || codec->decode == NULL)
+			return false;
+		decoded = (uint8_t *)malloc(header->raw_size > 0 ? header->raw_size : 1);
+		if (decoded == NULL)
+			return false;
+		if (codec->decode(raw, header->data_size, decoded, header->raw_size) != header->raw_size)
+		{
+			free(decoded);
+			return false;
+		}
+		raw = decoded;
+	}
+	else if (header->raw_size != header->data_size)
+	{
+		return false;
+	}
+
+	LIST_LOCK(list);
+	list_restore_t restore;
+	if (!list_restore_begin(&restore, list))
+	{
+		LIST_UNLOCK(list);
+		free(decoded);
+		return false;
+	}
+
+	bool valid = (header->flags & LIST_PACK_ORDER_ONLY) ? list_pack_restore_order(&restore, header, raw)
+	                                                    : list_pack_restore_indexed(&restore, header, raw);
+	list_restore_end(&restore, valid);
+	LIST_UNLOCK(list);
+
+	free(decoded);
+	return valid;
+}
+
+// ========================= 映像格式 =========================
+
+static inline uint16_t list_image_record_size(uint16_t element_size)
+{
+	return (uint16_t)ALIGN_UP(sizeof(list_image_record_t) + element_size, 4);
+}
+
+static inline list_image_record_t *list_image_record(uint8_t *records, uint16_t record_size, uint16_t slot)
+{
+	return (list_image_record_t *)(records + (size_t)slot * record_size);
+}
+
+// 映像中需要的槽位记录数量：最大的已用槽位 + 1
+static uint16_t list_image_slot_count(list_handle_t list)
+{
+	uint32_t slots = 0;
+	for (list_node_t *node = list->head; node != NULL; node = node->next)
+	{
+		uint16_t slot = list_node_slot(list, node);
+		if (slot != LIST_INVALID_SLOT && slot >= slots)
+			slots = (uint32_t)slot + 1;
+	}
+	return (uint16_t)slots;
+}
+
+/**
+ * @brief 计算映像需要的缓冲区大小
+ * @param list 链表指针
+ * @return 映像字节数
+ * @note 需要遍历一次链表；整理过节点池（list_compact）的链表映像最小
+ */
+uint32_t list_image_size(list_handle_t list)
+{
+	if (list == NULL)
+		return 0;
+
+	LIST_LOCK(list);
+	uint32_t size = sizeof(list_image_header_t) +
+	                (uint32_t)list_image_slot_count(list) * list_image_record_size(list->element_size);
+	LIST_UNLOCK(list);
+	return size;
+}
+
+/**
+ * @brief 把链表写成与位置无关的映像
+ * @param list 链表指针
+ * @param buffer 映像缓冲区，4字节对齐
+ * @param buffer_size 缓冲区大小
+ * @return 实际使用的字节数，失败返回0
+ */
+uint32_t list_image_write(list_handle_t list, void *buffer, uint32_t buffer_size)
+{
+	if (list == NULL || buffer == NULL || ((uintptr_t)buffer & 3) != 0)
+		return 0;
+
+	LIST_LOCK(list);
+
+	uint16_t slots = list_image_slot_count(list);
+	uint16_t record_size = list_image_record_size(list->element_size);
+	uint32_t required_size = sizeof(list_image_header_t) + (uint32_t)slots * record_size;
+	if (buffer_size < required_size)
+	{
+		LIST_UNLOCK(list);
+		return 0;
+	}
+
+	list_image_header_t *header = (list_image_header_t *)buffer;
+	header->magic = list_le32(LIST_IMAGE_MAGIC);
+	header->version = list_le16(LIST_IMAGE_VERSION);
+	header->element_size = list_le16(list->element_size);
+	header->capacity = list_le16(list->capacity);
+	header->size = list_le16(list->size);
+	header->head = list_le16(list_node_slot(list, list->head));
+	header->tail = list_le16(list_node_slot(list, list->tail));
+	header->slots = list_le16(slots);
+	header->record_size = list_le16(record_size);
+
+	uint8_t *records = (uint8_t *)buffer + sizeof(list_image_header_t);
+	memset(records, 0, (size_t)slots * record_size);
+	for (uint16_t i = 0; i < slots; i++)
+	{
+		list_image_record_t *record = list_image_record(records, record_size, i);
+		record->next = LIST_INVALID_SLOT;
+		record->prev = LIST_INVALID_SLOT;
+	}
+
+	for (list_node_t *node = list->head; node != NULL; node = node->next)
+	{
+		list_image_record_t *record = list_image_record(records, record_size, list_node_slot(list, node));
+		record->next = list_le16(list_node_slot(list, node->next));
+		record->prev = list_le16(list_node_slot(list, node->prev));
+		memcpy(record->data, node->data, list->element_size);
+	}
+
+	LIST_UNLOCK(list);
+	return required_size;
+}
+
+/**
+ * @brief 打开映像，只检查头部，不复制数据
+ * @param image 输出的映像描述
+ * @param buffer 映像缓冲区（可以是内存映射的文件或 Flash），4字节对齐
+ * @param buffer_size 缓冲区大小
+ * @return 头部有效返回true
+ * @note O(1)；映像缓冲区在使用期间必须保持有效
+ */
+bool list_image_open(list_image_t *image, const void *buffer, uint32_t buffer_size)
+{
+	if (image == NULL || buffer == NULL || ((uintptr_t)buffer & 3) != 0 ||
+	    buffer_size < sizeof(list_image_header_t))
+		return false;
+
+	list_image_header_t host;
+	const list_image_header_t *header = &host;
+	memcpy(&host, buffer, sizeof(host));
+	host.magic = list_le32(host.magic);
+	host.version = list_le16(host.version);
+	host.element_size = list_le16(host.element_size);
+	host.capacity = list_le16(host.capacity);
+	host.size = list_le16(host.size);
+	host.head = list_le16(host.head);
+	host.tail = list_le16(host.tail);
+	host.slots = list_le16(host.slots);
+	host.record_size = list_le16(host.record_size);
+	if (header->magic != LIST_IMAGE_MAGIC || header->version != LIST_IMAGE_VERSION ||
+	    header->record_size != list_image_record_size(header->element_size) ||
+	    header->slots > header->capacity || header->size > header->slots ||
+	    buffer_size < sizeof(list_image_header_t) + (uint32_t)header->slots * header->record_size)
+		return false;
+
+	// 头尾槽位必须同时有效或同时无效（空链表）
+	bool empty = (header->size == 0);
+	if (empty != (header->head == LIST_INVALID_SLOT) || empty != (header->tail == LIST_INVALID_SLOT) ||
+	    (!empty && (header->head >= header->slots || header->tail >= header->slots)))
+		return false;
+
+	image->records = (const uint8_t *)buffer + sizeof(list_image_header_t);
+	image->slots = header->slots;
+	image->size = header->size;
+	image->head = header->head;
+	image->tail = header->tail;
+	image->element_size = header->element_size;
+	image->record_size = header->record_size;
+	return true;
+}
+
+static inline const list_image_record_t *list_image_slot_record(const list_image_t *image, uint16_t slot)
+{
+	if (image == NULL || slot >= image->slots)
+		return NULL;
+	return (const list_image_record_t *)(image->records + (size_t)slot * image->record_size);
+}
+
+/**
+ * @brief 获取映像中的第一个元素
+ * @return 槽位索引，空映像返回 LIST_INVALID_SLOT
+ */
+uint16_t list_image_begin(const list_image_t *image)
+{
+	return (image != NULL) ? image->head : LIST_INVALID_SLOT;
+}
+
+uint16_t list_image_end(const list_image_t *image)
+{
+	return (image != NULL) ? image->tail : LIST_INVALID_SLOT;
+}
+
+/**
+ * @brief 获取映像中 slot 的下一个元素
+ * @return 槽位索引，到达末尾或槽位无效时返回 LIST_INVALID_SLOT
+ * @note 映像内容不可信时，遍历次数应以 image->size 为上限
+ */
+uint16_t list_image_next(const list_image_t *image, uint16_t slot)
+{
+	const list_image_record_t *record = list_image_slot_record(image, slot);
+	if (record == NULL || list_le16(record->next) >= image->slots)
+		return LIST_INVALID_SLOT;
+	return list_le16(record->next);
+}
+
+uint16_t list_image_prev(const list_image_t *image, uint16_t slot)
+{
+	const list_image_record_t *record = list_image_slot_record(image, slot);
+	if (record == NULL || list_le16(record->prev) >= image->slots)
+		return LIST_INVALID_SLOT;
+	return list_le16(record->prev);
+}
+
+/**
+ * @brief 获取映像中 slot 的元素数据
+ * @return 指向映像内部的只读指针，槽位无效时返回NULL
+ */
+const void *list_image_data(const list_image_t *image, uint16_t slot)
+{
+	const list_image_record_t *record = list_image_slot_record(image, slot);
+	return (record != NULL) ? record->data : NULL;
+}
+
+// ========================= 增量序列化 =========================
+
+// slot_epoch 的最高位记录槽位是否在链表中使用（空闲节点的链接不可靠，不能据此判断）
+#define LIST_DELTA_SLOT_LIVE 0x80000000u
+#define LIST_DELTA_SLOT_EPOCH(value) ((value) & ~LIST_DELTA_SLOT_LIVE)
+
+static inline void list_delta_mark(list_delta_handle_t delta, list_node_t *node)
+{
+	uint16_t slot = list_node_slot(delta->list, node);
+	if (slot != LIST_INVALID_SLOT)
+		delta->slot_epoch[slot] = (delta->slot_epoch[slot] & LIST_DELTA_SLOT_LIVE) | delta->epoch;
+}
+
+static inline void list_delta_set_live(list_delta_handle_t delta, list_node_t *node, bool live)
+{
+	uint16_t slot = list_node_slot(delta->list, node);
+	if (slot != LIST_INVALID_SLOT)
+		delta->slot_epoch[slot] = delta->epoch | (live ? LIST_DELTA_SLOT_LIVE : 0);
+}
+
+// 把所有槽位标记为已变化，并根据当前链表重新记录使用状态
+static void list_delta_mark_all(list_delta_handle_t delta)
+{
+	for (uint16_t i = 0; i < delta->list->capacity; i++)
+		delta->slot_epoch[i] = delta->epoch;
+	for (list_node_t *it = delta->list->head; it != NULL; it = it->next)
+		list_delta_set_live(delta, it, true);
+}
+
+static void list_delta_on_event(list_handle_t list, list_event_t event, list_iterator_t node, void *ctx)
+{
+	list_delta_handle_t delta = (list_delta_handle_t)ctx;
+
+	switch (event)
+	{
+	case LIST_EVENT_LINK:
+	case LIST_EVENT_UNLINK:
+		// 节点本身和两侧邻居的链接都会改变
+		list_delta_set_live(delta, node, event == LIST_EVENT_LINK);
+		list_delta_mark(delta, node->prev);
+		list_delta_mark(delta, node->next);
+		break;
+	case LIST_EVENT_UPDATE:
+		list_delta_mark(delta, node);
+		break;
+	case LIST_EVENT_REORDER:
+		for (list_node_t *it = list->head; it != NULL; it = it->next)
+			list_delta_mark(delta, it);
+		break;
+	case LIST_EVENT_RESET:
+		list_delta_mark_all(delta);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief 为链表创建脏槽位跟踪器（动态分配跟踪器存储）
+ * @param list 被跟踪的链表
+ * @return 跟踪器句柄，失败返回NULL
+ * @note 创建后应先保存一次完整快照（list_serialize），之后的增量以检查点0为起点
+ */
+list_delta_handle_t list_delta_create(list_handle_t list)
+{
+	if (list == NULL)
+		return NULL;
+
+	size_t buf_size = LIST_DELTA_BUF_SIZE(list->capacity);
+	void *buf = malloc(buf_size);
+	if (buf == NULL)
+		return NULL;
+
+	list_delta_handle_t delta = list_delta_create_from_buf(list, buf, buf_size);
+	if (delta == NULL)
+	{
+		free(buf);
+		return NULL;
+	}
+
+	delta->is_static = false;
+	return delta;
+}
+
+/**
+ * @brief 使用外部缓冲区创建脏槽位跟踪器
+ * @param list 被跟踪的链表，不能共享节点池
+ * @param buf 跟踪器缓冲区，4字节对齐
+ * @param buf_size 缓冲区大小，至少 LIST_DELTA_BUF_SIZE(capacity)
+ * @return 跟踪器句柄，失败返回NULL
+ */
+list_delta_handle_t list_delta_create_from_buf(list_handle_t list, void *buf, size_t buf_size)
+{
+	if (list == NULL || buf == NULL || ((uintptr_t)buf & 3) != 0 || buf_size < LIST_DELTA_BUF_SIZE(list->capacity) ||
+	    list->pool_owner != NULL || list->pool_users != 0)
+		return NULL;
+
+	list_delta_handle_t delta = (list_delta_handle_t)malloc(sizeof(list_delta_t));
+	if (delta == NULL)
+		return NULL;
+
+	delta->list = list;
+	delta->slot_epoch = (uint32_t *)buf;
+	delta->epoch = 1;
+	delta->is_static = true;
+	delta->observer.callback = list_delta_on_event;
+	delta->observer.lookup = NULL;
+	delta->observer.ctx = delta;
+	delta->observer.next = NULL;
+	memset(delta->slot_epoch, 0, LIST_DELTA_BUF_SIZE(list->capacity));
+
+	LIST_LOCK(list);
+	for (list_node_t *it = list->head; it != NULL; it = it->next)
+		delta->slot_epoch[list_node_slot(list, it)] = LIST_DELTA_SLOT_LIVE;
+	list_add_observer(list, &delta->observer);
+	LIST_UNLOCK(list);
+
+	return delta;
+}
+
+void list_delta_free(list_delta_handle_t delta)
+{
+	if (delta == NULL)
+		return;
+
+	list_remove_observer(delta->list, &delta->observer);
+	if (!delta->is_static)
+		free(delta->slot_epoch);
+	free(delta);
+}
+
+/**
+ * @brief 获取当前检查点编号（正在记录的检查点）
+ */
+uint32_t list_delta_epoch(list_delta_handle_t delta)
+{
+	return (delta != NULL) ? delta->epoch : 0;
+}
+
+static uint32_t list_delta_size_locked(list_delta_handle_t delta, uint32_t since_epoch)
+{
+	list_handle_t list = delta->list;
+	uint32_t size = sizeof(list_delta_header_t);
+
+	for (uint16_t i = 0; i < list->capacity; i++)
+	{
+		if (LIST_DELTA_SLOT_EPOCH(delta->slot_epoch[i]) <= since_epoch)
+			continue;
+
+		size += sizeof(list_delta_record_t);
+		if (delta->slot_epoch[i] & LIST_DELTA_SLOT_LIVE)
+			size += list->element_size;
+	}
+	return size;
+}
+
+// 在主机字节序和小端字节序之间转换增量头部和槽位记录
+static void list_delta_header_swap(list_delta_header_t *header)
+{
+	header->magic = list_le32(header->magic);
+	header->since_epoch = list_le32(header->since_epoch);
+	header->epoch = list_le32(header->epoch);
+	header->element_size = list_le16(header->element_size);
+	header->capacity = list_le16(header->capacity);
+	header->size = list_le16(header->size);
+	header->head = list_le16(header->head);
+	header->tail = list_le16(header->tail);
+	header->count = list_le16(header->count);
+}
+
+static void list_delta_record_swap(list_delta_record_t *record)
+{
+	record->slot = list_le16(record->slot);
+	record->next = list_le16(record->next);
+	record->prev = list_le16(record->prev);
+	record->flags = list_le16(record->flags);
+}
+
+/**
+ * @brief 计算增量需要的缓冲区大小
+ * @param delta 跟踪器句柄
+ * @param since_epoch 起点检查点
+ * @return 增量字节数
+ */
+uint32_t list_get_delta_size(list_delta_handle_t delta, uint32_t since_epoch)
+{
+	if (delta == NULL)
+		return 0;
+
+	LIST_LOCK(delta->list);
+	uint32_t size = list_delta_size_locked(delta, since_epoch);
+	LIST_UNLOCK(delta->list);
+	return size;
+}
+
+/**
+ * @brief 增量序列化：只输出 since_epoch 之后变化过的槽位
+ * @param delta 跟踪器句柄
+ * @param buffer 保存缓冲区
+ * @param buffer_size 缓冲区大小
+ * @param since_epoch 起点检查点：上一次增量头部的 epoch，创建跟踪器后的第一次增量为0
+ * @return 实际使用的字节数，失败返回0
+ * @note 成功后开始记录下一个检查点；需要扫描所有槽位的检查点编号，O(capacity)
+ */
+uint32_t list_serialize_delta(list_delta_handle_t delta, void *buffer, uint32_t buffer_size, uint32_t since_epoch)
+{
+	if (delta == NULL || buffer == NULL)
+		return 0;
+
+	list_handle_t list = delta->list;
+	LIST_LOCK(list);
+
+	uint32_t required_size = list_delta_size_locked(delta, since_epoch);
+	if (buffer_size < required_size)
+	{
+		LIST_UNLOCK(list);
+		return 0;
+	}
+
+	list_delta_header_t header;
+	header.magic = LIST_DELTA_MAGIC;
+	header.since_epoch = since_epoch;
+	header.epoch = delta->epoch;
+	header.element_size = list->element_size;
+	header.capacity = list->capacity;
+	header.size = list->size;
+	header.head = list_node_slot(list, list->head);
+	header.tail = list_node_slot(list, list->tail);
+	header.count = 0;
+
+	size_t node_size = LIST_NODE_SIZE(list->element_size);
+	uint8_t *ptr = (uint8_t *)buffer + sizeof(list_delta_header_t);
+	for (uint16_t i = 0; i < list->capacity; i++)
+	{
+		if (LIST_DELTA_SLOT_EPOCH(delta->slot_epoch[i]) <= since_epoch)
+			continue;
+
+		list_node_t *node = (list_node_t *)((uint8_t *)list->node_pool + i * node_size);
+		bool live = (delta->slot_epoch[i] & LIST_DELTA_SLOT_LIVE) != 0;
+		list_delta_record_t record;
+		record.slot = i;
+		record.next = live ? list_node_slot(list, node->next) : LIST_INVALID_SLOT;
+		record.prev = live ? list_node_slot(list, node->prev) : LIST_INVALID_SLOT;
+		record.flags = live ? LIST_DELTA_LIVE : 0;
+		list_delta_record_swap(&record);
+
+		// 记录不保证对齐，使用 memcpy 写入
+		memcpy(ptr, &record, sizeof(record));
+		ptr += sizeof(record);
+		if (live)
+		{
+			memcpy(ptr, node->data, list->element_size);
+			ptr += list->element_size;
+		}
+		header.count++;
+	}
+	list_delta_header_swap(&header);
+	memcpy(buffer, &header, sizeof(header));
+
+	delta->epoch++;
+
+	LIST_UNLOCK(list);
+	return required_size;
+}
+
+/**
+ * @brief 应用增量
+ * @param list 由完整快照和之前的增量依次恢复的链表
+ * @param buffer 增量缓冲区
+ * @param buffer_size 缓冲区大小
+ * @param epoch 链表所在的检查点：由完整快照恢复后为0，成功后更新为增量头部的 epoch
+ * @return 是否成功
+ * @note 增量必须按顺序应用：since_epoch 不等于 *epoch（重复应用或漏掉了中间的增量）时返回false，不修改链表
+ * @note 增量内容与链表不匹配导致链表结构无效时，链表被清空并返回false
+ * @note 共享节点池的链表不能应用增量
+ */
+bool list_apply_delta(list_handle_t list, const void *buffer, uint32_t buffer_size, uint32_t *epoch)
+{
+	if (list == NULL || buffer == NULL || epoch == NULL || buffer_size < sizeof(list_delta_header_t))
+		return false;
+
+	list_delta_header_t header;
+	memcpy(&header, buffer, sizeof(header));
+	list_delta_header_swap(&header);
+	if (header.magic != LIST_DELTA_MAGIC || header.since_epoch != *epoch ||
+	    header.element_size != list->element_size ||
+	    header.capacity > list->capacity || header.size > header.capacity ||
+	    list->pool_owner != NULL || list->pool_users != 0)
+		return false;
+
+	// 第一遍只检查记录，不修改链表
+	const uint8_t *records = (const uint8_t *)buffer + sizeof(list_delta_header_t);
+	const uint8_t *end = (const uint8_t *)buffer + buffer_size;
+	const uint8_t *ptr = records;
+	for (uint16_t i = 0; i < header.count; i++)
+	{
+		list_delta_record_t record;
+		if ((size_t)(end - ptr) < sizeof(record))
+			return false;
+		memcpy(&record, ptr, sizeof(record));
+		list_delta_record_swap(&record);
+		ptr += sizeof(record);
+
+		if (record.slot >= header.capacity ||
+		    (record.next != LIST_INVALID_SLOT && record.next >= header.capacity) ||
+		    (record.prev != LIST_INVALID_SLOT && record.prev >= header.capacity))
+			return false;
+		if (record.flags & LIST_DELTA_LIVE)
+		{
+			if ((size_t)(end - ptr) < list->element_size)
+				return false;
+			ptr += list->element_size;
+		}
+	}
+
+	bool *node_used = (bool *)calloc(list->capacity, sizeof(bool));
+	if (node_used == NULL)
+		return false;
+
+	LIST_LOCK(list);
+
+	ptr = records;
+	for (uint16_t i = 0; i < header.count; i++)
+	{
+		list_delta_record_t record;
+		memcpy(&record, ptr, sizeof(record));
+		list_delta_record_swap(&record);
+		ptr += sizeof(record);
+
+		list_node_t *node = list_index_to_node(list, record.slot);
+		if (record.flags & LIST_DELTA_LIVE)
+		{
+			memcpy(node->data, ptr, list->element_size);
+			ptr += list->element_size;
+			node->next = list_index_to_node(list, record.next);
+			node->prev = list_index_to_node(list, record.prev);
+		}
+		else
+		{
+			node->next = NULL;
+			node->prev = NULL;
+		}
+	}
+
+	list->head = list_index_to_node(list, header.head);
+	list->tail = list_index_to_node(list, header.tail);
+	list->size = header.size;
+
+	// 沿链表检查结构并标记使用中的节点，然后重建 free_list
+	bool valid = true;
+	uint16_t count = 0;
+	list_node_t *prev_node = NULL;
+	for (list_node_t *node = list->head; node != NULL; node = node->next)
+	{
+		uint16_t slot = list_node_slot(list, node);
+		if (count >= header.size || node_used[slot] || node->prev != prev_node)
+		{
+			valid = false;
+			break;
+		}
+		node_used[slot] = true;
+		prev_node = node;
+		count++;
+	}
+
+	if (valid && count == header.size && prev_node == list->tail)
+	{
+		list->free_list = NULL;
+		for (uint16_t i = 0; i < list->capacity; i++)
+		{
+			if (!node_used[i])
+			{
+				list_node_t *node = list_index_to_node(list, i);
+				node->next = list->free_list;
+				node->prev = NULL;
+				list->free_list = node;
+			}
+		}
+	}
+	else
+	{
+		valid = false;
+		list_reset_pool(list);
+	}
+
+	free(node_used);
+	if (valid)
+		*epoch = header.epoch;
+
+	list_rebuild_live_map(list);
+	list_notify(list, LIST_EVENT_RESET, NULL);
+
+	LIST_UNLOCK(list);
+	return valid;
+}
+
+// ========================= 写时复制快照 =========================
+
+#define LIST_BIT_TEST(map, slot) (((map)[(slot) >> 5] & (1u << ((slot) & 31))) != 0)
+#define LIST_BIT_SET(map, slot) ((map)[(slot) >> 5] |= 1u << ((slot) & 31))
+
+static inline uint32_t list_snapshot_record_size(const list_snapshot_t *snapshot)
+{
+	return (uint32_t)list_persist_node_size(snapshot->list->element_size);
+}
+
+// 槽位第一次在快照后改变前保存它原来的后继和数据
+static void list_snapshot_save(list_snapshot_handle_t snapshot, list_node_t *node, list_node_t *next)
+{
+	list_handle_t list = snapshot->list;
+	uint16_t slot = list_node_slot(list, node);
+	if (slot == LIST_INVALID_SLOT || LIST_BIT_TEST(snapshot->frozen, slot))
+		return;
+
+	LIST_BIT_SET(snapshot->frozen, slot);
+	uint8_t *preimage = snapshot->preimage + (size_t)slot * list_snapshot_record_size(snapshot);
+	uint16_t next_slot = list_node_slot(list, next);
+	memcpy(preimage, &next_slot, sizeof(next_slot));
+	memcpy(preimage + sizeof(next_slot), node->data, list->element_size);
+}
+
+// 结束推迟的保存：此时 deferred_prev 后面的新节点都已通知，最后一个新节点的后继就是它原来的后继
+static void list_snapshot_resolve(list_snapshot_handle_t snapshot)
+{
+	if (snapshot->deferred_prev != NULL)
+	{
+		list_snapshot_save(snapshot, snapshot->deferred_prev, snapshot->deferred_last->next);
+		snapshot->deferred_prev = NULL;
+		snapshot->deferred_last = NULL;
+	}
+}
+
+static void list_snapshot_on_event(list_handle_t list, list_event_t event, list_iterator_t node, void *ctx)
+{
+	list_snapshot_handle_t snapshot = (list_snapshot_handle_t)ctx;
+	if (!snapshot->valid || snapshot->offset == snapshot->total)
+		return;
+
+	// 成段链接时逐个通知段内的节点，紧跟在上一个新节点后面的链接属于同一段
+	if (event == LIST_EVENT_LINK && snapshot->deferred_prev != NULL && node->prev == snapshot->deferred_last)
+	{
+		snapshot->deferred_last = node;
+		LIST_BIT_SET(snapshot->frozen, list_node_slot(list, node));
+		return;
+	}
+	list_snapshot_resolve(snapshot);
+
+	switch (event)
+	{
+	case LIST_EVENT_LINK:
+		// 前驱的后继第一次改变，段内后面的节点还没有通知，等这一段链接完再保存前驱
+		if (node->prev != NULL && !LIST_BIT_TEST(snapshot->frozen, list_node_slot(list, node->prev)))
+		{
+			snapshot->deferred_prev = node->prev;
+			snapshot->deferred_last = node;
+		}
+		// 快照之后才链接的节点不属于快照（属于快照的节点在之前删除时已经保存）
+		LIST_BIT_SET(snapshot->frozen, list_node_slot(list, node));
+		break;
+	case LIST_EVENT_UNLINK:
+		// 节点即将移除，它和前驱的链接都还没有改变
+		list_snapshot_save(snapshot, node, node->next);
+		if (node->prev != NULL)
+			list_snapshot_save(snapshot, node->prev, node);
+		break;
+	case LIST_EVENT_BEFORE_UPDATE:
+		list_snapshot_save(snapshot, node, node->next);
+		break;
+	case LIST_EVENT_REORDER:
+	case LIST_EVENT_RESET:
+		// 整体变化没有逐个节点的通知，无法保存原值
+		snapshot->valid = false;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief 开始写时复制快照（动态分配快照缓冲区）
+ * @param list 链表指针，不能共享节点池
+ * @return 快照句柄，失败返回NULL
+ */
+list_snapshot_handle_t list_snapshot_begin(list_handle_t list)
+{
+	if (list == NULL)
+		return NULL;
+
+	size_t buf_size = LIST_SNAPSHOT_BUF_SIZE(list->capacity, list->element_size);
+	void *buf = malloc(buf_size);
+	if (buf == NULL)
+		return NULL;
+
+	list_snapshot_handle_t snapshot = list_snapshot_begin_from_buf(list, buf, buf_size);
+	if (snapshot == NULL)
+	{
+		free(buf);
+		return NULL;
+	}
+
+	snapshot->is_static = false;
+	return snapshot;
+}
+
+/**
+ * @brief 使用外部缓冲区开始写时复制快照
+ * @param list 链表指针，不能共享节点池
+ * @param buf 快照缓冲区，4字节对齐
+ * @param buf_size 缓冲区大小，至少 LIST_SNAPSHOT_BUF_SIZE(capacity, element_size)
+ * @return 快照句柄，失败返回NULL
+ * @note 列表锁内只清零槽位位图，不遍历链表也不复制元素数据
+ */
+list_snapshot_handle_t list_snapshot_begin_from_buf(list_handle_t list, void *buf, size_t buf_size)
+{
+	if (list == NULL || buf == NULL || ((uintptr_t)buf & 3) != 0 ||
+	    buf_size < LIST_SNAPSHOT_BUF_SIZE(list->capacity, list->element_size) || list->pool_owner != NULL ||
+	    list->pool_users != 0)
+		return NULL;
+
+	list_snapshot_handle_t snapshot = (list_snapshot_handle_t)malloc(sizeof(list_snapshot_t));
+	if (snapshot == NULL)
+		return NULL;
+
+	size_t words = LIST_LIVE_MAP_WORDS(list->capacity);
+	snapshot->list = list;
+	snapshot->frozen = (uint32_t *)buf;
+	snapshot->preimage = (uint8_t *)(snapshot->frozen + words);
+	snapshot->deferred_prev = NULL;
+	snapshot->deferred_last = NULL;
+	snapshot->offset = 0;
+	snapshot->valid = true;
+	snapshot->is_static = true;
+	snapshot->observer.callback = list_snapshot_on_event;
+	snapshot->observer.lookup = NULL;
+	snapshot->observer.ctx = snapshot;
+	snapshot->observer.next = NULL;
+	memset(snapshot->frozen, 0, words * sizeof(uint32_t));
+
+	LIST_LOCK(list);
+	snapshot->size = list->size;
+	snapshot->cursor = list_node_slot(list, list->head);
+	snapshot->total = (uint32_t)(sizeof(list_persist_header_t) + (size_t)list->size * list_snapshot_record_size(snapshot));
+	list_add_observer(list, &snapshot->observer);
+	LIST_UNLOCK(list);
+
+	return snapshot;
+}
+
+/**
+ * @brief 获取快照的总字节数（开始时的 list_get_serialize_size 减去 sizeof(list_save_header_t)）
+ */
+uint32_t list_snapshot_size(list_snapshot_handle_t snapshot)
+{
+	return (snapshot != NULL) ? snapshot->total : 0;
+}
+
+// 把虚拟记录（槽位索引 + 数据）中从 offset 开始的部分复制到 out，返回复制的字节数
+static uint32_t list_snapshot_copy_record(uint8_t *out, uint32_t space, uint16_t slot, const uint8_t *data,
+                                          uint32_t offset, uint32_t record_size)
+{
+	uint8_t index[sizeof(uint16_t)];
+	list_store_le16(index, slot);
+
+	uint32_t copied = 0;
+	for (; offset < sizeof(index) && copied < space; offset++)
+		out[copied++] = index[offset];
+	if (copied == space)
+		return copied;
+	uint32_t n = record_size - offset;
+	if (n > space - copied)
+		n = space - copied;
+	memcpy(out + copied, data + (offset - sizeof(index)), n);
+	return copied + n;
+}
+
+/**
+ * @brief 读取快照的下一段数据
+ * @param snapshot 快照句柄
+ * @param buffer 输出缓冲区
+ * @param buffer_size 缓冲区大小，任意大小，记录可以跨越两次读取
+ * @return 复制的字节数，快照已全部读出或已失效时返回0
+ * @note 只在本次调用中持有列表锁；写出后的槽位不再需要保存原值
+ */
+uint32_t list_snapshot_read(list_snapshot_handle_t snapshot, void *buffer, uint32_t buffer_size)
+{
+	if (snapshot == NULL || buffer == NULL)
+		return 0;
+
+	list_handle_t list = snapshot->list;
+	uint8_t *out = (uint8_t *)buffer;
+	uint32_t record_size = list_snapshot_record_size(snapshot);
+	uint32_t used = 0;
+
+	LIST_LOCK(list);
+
+	if (!snapshot->valid)
+	{
+		LIST_UNLOCK(list);
+		return 0;
+	}
+	list_snapshot_resolve(snapshot);
+
+	if (snapshot->offset < sizeof(list_persist_header_t))
+	{
+		uint8_t bytes[sizeof(list_persist_header_t)];
+		list_store_le16(bytes + offsetof(list_persist_header_t, size), snapshot->size);
+		list_store_le16(bytes + offsetof(list_persist_header_t, capacity), list->capacity);
+		list_store_le16(bytes + offsetof(list_persist_header_t, element_size), list->element_size);
+		for (; snapshot->offset < sizeof(bytes) && used < buffer_size; snapshot->offset++)
+			out[used++] = bytes[snapshot->offset];
+	}
+
+	while (used < buffer_size && snapshot->offset < snapshot->total)
+	{
+		uint16_t slot = snapshot->cursor;
+		uint32_t offset = (snapshot->offset - (uint32_t)sizeof(list_persist_header_t)) % record_size;
+		uint16_t next;
+		const uint8_t *data;
+		if (LIST_BIT_TEST(snapshot->frozen, slot))
+		{
+			// 尚未写出的冻结槽位一定保存过原值
+			const uint8_t *preimage = snapshot->preimage + (size_t)slot * record_size;
+			memcpy(&next, preimage, sizeof(next));
+			data = preimage + sizeof(next);
+		}
+		else
+		{
+			list_node_t *node = list_index_to_node(list, slot);
+			next = list_node_slot(list, node->next);
+			data = node->data;
+		}
+
+		uint32_t n = list_snapshot_copy_record(out + used, buffer_size - used, slot, data, offset, record_size);
+		used += n;
+		snapshot->offset += n;
+		if (offset + n == record_size)
+		{
+			LIST_BIT_SET(snapshot->frozen, slot);
+			snapshot->cursor = next;
+		}
+	}
+
+	LIST_UNLOCK(list);
+	return used;
+}
+
+/**
+ * @brief 把快照按块写入回调（通常在后台线程中调用）
+ * @param snapshot 快照句柄
+ * @param write 写入回调，在锁外执行，每次最多 chunk_size 字节
+ * @param ctx 回调上下文
+ * @param chunk_size 块大小，额外内存只有一个块
+ * @return 写入的总字节数（等于 list_snapshot_size），写入失败或快照失效时返回0
+ */
+uint32_t list_snapshot_write(list_snapshot_handle_t snapshot, list_stream_write_func_t write, void *ctx,
+                             uint32_t chunk_size)
+{
+	if (snapshot == NULL || write == NULL || chunk_size == 0)
+		return 0;
+
+	uint8_t *chunk = (uint8_t *)malloc(chunk_size);
+	if (chunk == NULL)
+		return 0;
+
+	uint32_t written = 0;
+	uint32_t n;
+	while ((n = list_snapshot_read(snapshot, chunk, chunk_size)) > 0)
+	{
+		if (!write(chunk, n, ctx))
+			break;
+		written += n;
+	}
+
+	free(chunk);
+	// 失效后 list_snapshot_read 在锁内返回0，读完最后一条记录后观察者不再处理事件，所以写满即完整
+	return (written == snapshot->total) ? written : 0;
+}
+
+/**
+ * @brief 结束快照，注销观察者并释放快照
+ * @return 快照是否已全部写出且一直有效
+ */
+bool list_snapshot_end(list_snapshot_handle_t snapshot)
+{
+	if (snapshot == NULL)
+		return false;
+
+	list_remove_observer(snapshot->list, &snapshot->observer);
+	bool complete = snapshot->valid && snapshot->offset == snapshot->total;
+	if (!snapshot->is_static)
+		free(snapshot->frozen);
+	free(snapshot);
+	return complete;
+}
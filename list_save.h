@@ -23,6 +23,69 @@
 #define __LIST_SAVE_H__
 
 #include "embedded_list.h"
+#include <string.h>
+
+// ========================= 字节序 =========================
+// 所有持久化格式（快照、压缩格式、流、映像、增量、日志）的头部和记录字段都按小端字节序保存在固定偏移上，
+// 下面的结构体定义就是线上布局（字段自然对齐，没有填充）。元素数据按原样保存，跨平台使用时元素本身的布局
+// 需要由调用者保证。大端主机读写时交换字节序，小端主机上 list_le16/list_le32 不产生任何代码。
+// 编译器不提供 __BYTE_ORDER__ 时可以手动定义 LIST_BIG_ENDIAN 为 0 或 1。
+#ifndef LIST_BIG_ENDIAN
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define LIST_BIG_ENDIAN 1
+#elif defined(__BIG_ENDIAN__) || defined(__ARMEB__) || defined(__THUMBEB__) || defined(__AARCH64EB__) || \
+    defined(__MIPSEB__)
+#define LIST_BIG_ENDIAN 1
+#else
+#define LIST_BIG_ENDIAN 0
+#endif
+#endif
+
+// 主机字节序与小端字节序互相转换（两个方向相同）
+static inline uint16_t list_le16(uint16_t v)
+{
+#if LIST_BIG_ENDIAN
+	return (uint16_t)((v >> 8) | (v << 8));
+#else
+	return v;
+#endif
+}
+
+static inline uint32_t list_le32(uint32_t v)
+{
+#if LIST_BIG_ENDIAN
+	return (v >> 24) | ((v >> 8) & 0x0000FF00u) | ((v << 8) & 0x00FF0000u) | (v << 24);
+#else
+	return v;
+#endif
+}
+
+// 读写不保证对齐的小端字段
+static inline uint16_t list_load_le16(const void *p)
+{
+	uint16_t v;
+	memcpy(&v, p, sizeof(v));
+	return list_le16(v);
+}
+
+static inline uint32_t list_load_le32(const void *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return list_le32(v);
+}
+
+static inline void list_store_le16(void *p, uint16_t v)
+{
+	v = list_le16(v);
+	memcpy(p, &v, sizeof(v));
+}
+
+static inline void list_store_le32(void *p, uint32_t v)
+{
+	v = list_le32(v);
+	memcpy(p, &v, sizeof(v));
+}
 
 typedef struct
 {
@@ -44,12 +107,31 @@ typedef struct
 	uint8_t data[];         // 节点数据区域，通过指针算术访问，不使用list_persist_node_t nodes[]以兼容编译器
 } list_persist_header_t;
 
+// list_serialize 在 list_persist_header_t 前面写入校验头部；按 list_persist_header_t 解释时 magic 的
+// size 字段大于 capacity，不会与没有校验头部的旧数据混淆
+#define LIST_SAVE_MAGIC 0x31534C45u  // "ELS1"
+#define LIST_SAVE_VERSION 1
+
+/**
+ * @brief list_serialize 的校验头部
+ * @note 头部后面紧跟 length 字节 list_persist_header_t 格式的数据
+ */
+typedef struct
+{
+	uint32_t magic;     // LIST_SAVE_MAGIC
+	uint16_t version;   // LIST_SAVE_VERSION
+	uint16_t reserved;  // 保留，为0
+	uint32_t length;    // 后面数据的字节数
+	uint32_t crc;       // 前面字段和后面数据的 CRC32C
+} list_save_header_t;
+
 /**
  * @brief 序列化：将链表保存到缓冲区
  * @param list 链表指针
  * @param buffer 保存缓冲区（需要预先分配足够大小）
  * @param buffer_size 缓冲区大小
  * @return 实际使用的字节数，失败返回0
+ * @note 数据以 list_save_header_t 开头，CRC32C 覆盖头部和数据
  */
 uint32_t list_serialize(list_handle_t  list, void *buffer, uint32_t buffer_size);
 
@@ -61,9 +143,21 @@ uint32_t list_serialize(list_handle_t  list, void *buffer, uint32_t buffer_size)
  * @return 是否成功
  * @note 新链表的capacity必须 >= 旧链表的capacity，element_size必须一致
  * @note 允许新链表容量大于旧链表，这样可以实现"升级"到更大容量的链表
+ * @note 共享节点池的链表（list_create_shared）不能反序列化
+ * @note 带校验头部时先检查版本、长度和 CRC32C，不一致时不修改链表；没有校验头部的旧数据直接读取
  */
 bool list_deserialize(list_handle_t  list, const void *buffer, uint32_t buffer_size);
 
+/**
+ * @brief 检查 list_serialize 的校验头部
+ * @param buffer 保存的数据缓冲区
+ * @param buffer_size 缓冲区大小
+ * @param data 输出 list_persist_header_t 格式数据的位置
+ * @param data_size 输出数据的字节数
+ * @return 校验是否通过；没有校验头部的旧数据原样输出并返回true
+ */
+bool list_check_serialized(const void *buffer, uint32_t buffer_size, const void **data, uint32_t *data_size);
+
 /**
  * @brief 计算序列化所需缓冲区大小
  * @param list 链表指针
@@ -71,4 +165,298 @@ bool list_deserialize(list_handle_t  list, const void *buffer, uint32_t buffer_s
  */
 uint32_t list_get_serialize_size(list_handle_t  list);
 
+// ========================= 流式序列化 =========================
+// 与 list_serialize/list_deserialize 格式相同但没有校验头部（写出第一块时还不知道 CRC32C），不需要整块缓冲区：
+// 数据按块交给写入回调或从读取回调获取，适合直接写入 Flash、文件或网络。需要校验时使用带校验的流。
+
+// 写入回调：写入 size 字节，成功返回true
+typedef bool (*list_stream_write_func_t)(const void *data, uint32_t size, void *ctx);
+// 读取回调：最多读取 size 字节，返回实际读取的字节数，0表示数据结束或出错
+typedef uint32_t (*list_stream_read_func_t)(void *data, uint32_t size, void *ctx);
+
+// list_deserialize_stream 在栈上使用的读取缓冲区大小
+#ifndef LIST_STREAM_READ_SIZE
+#define LIST_STREAM_READ_SIZE 256
+#endif
+
+/**
+ * @brief 流式序列化：按块把链表写入回调
+ * @param list 链表指针
+ * @param write 写入回调，每次最多 chunk_size 字节（最后一块可能更少）
+ * @param ctx 回调上下文
+ * @param chunk_size 块大小，不能小于 sizeof(list_persist_header_t)；额外内存只有一个块
+ * @return 写入的总字节数（开始时的 list_get_serialize_size 减去 sizeof(list_save_header_t)），失败返回0
+ * @note 只在填充每个块时持有列表锁，写入回调在锁外执行；
+ *       两个块之间链表被修改时写出的数据不完整，返回0，调用者需要重新写入
+ */
+uint32_t list_serialize_stream(list_handle_t list, list_stream_write_func_t write, void *ctx, uint32_t chunk_size);
+
+/**
+ * @brief 流式反序列化：从读取回调恢复链表
+ * @param list 已创建的链表，要求与 list_deserialize 相同
+ * @param read 读取回调
+ * @param ctx 回调上下文
+ * @return 是否成功
+ * @note 节点数据直接读入节点池，额外内存只有栈上的 LIST_STREAM_READ_SIZE 字节和槽位位图
+ * @note 整个读取过程持有列表锁；数据不完整或无效时链表被清空并返回false
+ */
+bool list_deserialize_stream(list_handle_t list, list_stream_read_func_t read, void *ctx);
+
+// 带校验的流：流头部之后每块写成一帧（uint32_t 长度 + 数据 + uint32_t CRC32C(长度和数据)），
+// 所有帧的数据连接起来就是没有校验头部的 list_serialize 格式。读取时每帧校验通过后才使用其中的数据。
+#define LIST_STREAM_CHECKED_MAGIC 0x4B435345u  // "ESCK"
+#define LIST_STREAM_CHECKED_VERSION 1
+
+typedef struct
+{
+	uint32_t magic;       // LIST_STREAM_CHECKED_MAGIC
+	uint16_t version;     // LIST_STREAM_CHECKED_VERSION
+	uint16_t reserved;    // 保留，为0
+	uint32_t chunk_size;  // 每帧数据的最大字节数
+	uint32_t crc;         // 前面字段的 CRC32C
+} list_stream_checked_header_t;
+
+/**
+ * @brief 带校验的流式序列化，参数与 list_serialize_stream 相同
+ * @return 写入的总字节数（包括流头部和帧），失败返回0
+ */
+uint32_t list_serialize_stream_checked(list_handle_t list, list_stream_write_func_t write, void *ctx,
+                                       uint32_t chunk_size);
+
+/**
+ * @brief 带校验的流式反序列化
+ * @return 是否成功；任何一帧校验失败、数据不完整或无效时链表被清空并返回false
+ * @note 额外内存为一帧（流头部中的 chunk_size + 4 字节）
+ */
+bool list_deserialize_stream_checked(list_handle_t list, list_stream_read_func_t read, void *ctx);
+
+// ========================= 压缩格式 =========================
+// 按链表顺序保存节点（与 list_serialize 相同的内容），先对记录做轻量编码，再可选地用块压缩器压缩：
+// - LIST_PACK_INDEX_DELTA：槽位索引保存为相对"上一个索引 + 1"的差值（zigzag 变长整数），连续槽位只占1字节
+// - LIST_PACK_XOR_DELTA：元素数据保存为与上一个元素按字节异或的结果，缓慢变化的记录大部分字节变为0
+// - LIST_PACK_ORDER_ONLY：不保存槽位索引，只按顺序保存元素数据，恢复时放入连续的槽位 0..size-1
+// 差值编码都产生大量重复字节，再交给块压缩器（内置 list_pack_lz）效果最好。
+
+#define LIST_PACK_MAGIC 0x4B504C45u  // "ELPK"
+// 版本2在数据后面增加4字节 CRC32C（覆盖头部和数据）；版本1没有校验，仍然可以读取
+#define LIST_PACK_VERSION 2
+#define LIST_PACK_CRC_SIZE 4
+
+#define LIST_PACK_INDEX_DELTA 0x0001  // 槽位索引差值编码
+#define LIST_PACK_XOR_DELTA 0x0002    // 元素数据与上一个元素异或
+// 只保存顺序：恢复后槽位位置改变（相当于整理了节点池），持有槽位索引的调用者不能使用；
+// 同时设置 LIST_PACK_INDEX_DELTA 时忽略后者
+#define LIST_PACK_ORDER_ONLY 0x0004
+
+#define LIST_PACK_CODEC_NONE 0  // 不压缩
+#define LIST_PACK_CODEC_LZ 1    // 内置 list_pack_lz
+
+/**
+ * @brief 块压缩器
+ * @note 编码和解码函数返回输出的字节数，输出缓冲区不够或数据无效时返回0
+ * @note 自定义压缩器使用 LIST_PACK_CODEC_LZ 以外的非零编号，解码时需要传入相同编号的压缩器
+ */
+typedef struct
+{
+	uint8_t id;                                  // 写入头部的压缩器编号
+	uint32_t (*bound)(uint32_t size);            // size 字节输入的最大输出字节数
+	uint32_t (*encode)(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t dst_size);
+	uint32_t (*decode)(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t dst_size);
+} list_pack_codec_t;
+
+// 内置的 LZ 压缩器（LZ4 块格式：字面量 + 最长65535字节回溯的匹配），不依赖外部库
+extern const list_pack_codec_t list_pack_lz;
+
+/**
+ * @brief 压缩格式头部
+ * @note 头部后面紧跟 data_size 字节数据；codec 为 LIST_PACK_CODEC_NONE 时数据就是编码后的记录，
+ *       否则是压缩后的记录，解压后为 raw_size 字节；版本2的数据后面是 CRC32C
+ */
+typedef struct
+{
+	uint32_t magic;         // LIST_PACK_MAGIC
+	uint16_t version;       // LIST_PACK_VERSION
+	uint16_t flags;         // LIST_PACK_INDEX_DELTA | LIST_PACK_XOR_DELTA | LIST_PACK_ORDER_ONLY
+	uint16_t element_size;  // 元素大小
+	uint16_t capacity;      // 原链表容量
+	uint16_t size;          // 元素数量
+	uint8_t codec;          // 压缩器编号
+	uint8_t reserved;       // 保留，为0
+	uint32_t raw_size;      // 编码后（压缩前）的记录字节数
+	uint32_t data_size;     // 头部后面的数据字节数
+} list_pack_header_t;
+
+/**
+ * @brief 计算压缩格式需要的最大缓冲区大小
+ * @param codec 块压缩器，NULL表示不压缩
+ */
+uint32_t list_get_pack_bound(list_handle_t list, uint16_t flags, const list_pack_codec_t *codec);
+
+/**
+ * @brief 以压缩格式序列化链表
+ * @param flags LIST_PACK_INDEX_DELTA、LIST_PACK_XOR_DELTA、LIST_PACK_ORDER_ONLY 的组合
+ * @param codec 块压缩器，NULL表示不压缩
+ * @return 实际使用的字节数，失败返回0
+ * @note 使用压缩器时需要一块编码后记录大小的临时内存；压缩后没有变小时按不压缩保存
+ */
+uint32_t list_serialize_packed(list_handle_t list, void *buffer, uint32_t buffer_size, uint16_t flags,
+                               const list_pack_codec_t *codec);
+
+/**
+ * @brief 从压缩格式恢复链表
+ * @param codec 数据使用的块压缩器（编号需要与头部一致），数据未压缩时可以为NULL
+ * @return 是否成功；头部和压缩数据有效、但记录无效时链表被清空
+ * @note 版本2的数据先检查 CRC32C，不一致时不修改链表
+ * @note 对链表的要求与 list_deserialize 相同；解压在加锁和清空链表之前完成
+ * @note LIST_PACK_ORDER_ONLY 格式只要求链表容量不小于元素数量
+ */
+bool list_deserialize_packed(list_handle_t list, const void *buffer, uint32_t buffer_size,
+                             const list_pack_codec_t *codec);
+
+// ========================= 映像格式 =========================
+// 与位置无关的节点池映像：按槽位存放每个节点，链接关系用槽位索引代替指针。
+// 映像可以直接放在内存映射的文件或 Flash 中，只读访问时 list_image_open 为O(1)，不需要复制数据。
+
+#define LIST_IMAGE_MAGIC 0x4D494C45u  // "ELIM"
+#define LIST_IMAGE_VERSION 1
+
+/**
+ * @brief 映像头部
+ * @note 头部后面紧跟 slots 条槽位记录，每条记录 record_size 字节：
+ *       uint16_t next、uint16_t prev（槽位索引，LIST_INVALID_SLOT 表示没有），然后是元素数据，
+ *       未使用的槽位 next 和 prev 都为 LIST_INVALID_SLOT
+ */
+typedef struct
+{
+	uint32_t magic;         // LIST_IMAGE_MAGIC
+	uint16_t version;       // LIST_IMAGE_VERSION
+	uint16_t element_size;  // 元素大小
+	uint16_t capacity;      // 原链表容量
+	uint16_t size;          // 元素数量
+	uint16_t head;          // 头节点槽位
+	uint16_t tail;          // 尾节点槽位
+	uint16_t slots;         // 映像中的槽位记录数量（最大的已用槽位 + 1）
+	uint16_t record_size;   // 每条槽位记录的字节数（4字节对齐）
+} list_image_header_t;
+
+typedef struct
+{
+	uint16_t next;
+	uint16_t prev;
+	uint8_t data[];
+} list_image_record_t;
+
+// 打开的只读映像，只引用映像缓冲区，不复制数据
+typedef struct
+{
+	const uint8_t *records;  // 第一条槽位记录
+	uint16_t slots;          // 槽位记录数量
+	uint16_t size;           // 元素数量
+	uint16_t head;           // 头节点槽位
+	uint16_t tail;           // 尾节点槽位
+	uint16_t element_size;   // 元素大小
+	uint16_t record_size;    // 每条槽位记录的字节数
+} list_image_t;
+
+uint32_t list_image_size(list_handle_t list);
+uint32_t list_image_write(list_handle_t list, void *buffer, uint32_t buffer_size);
+bool list_image_open(list_image_t *image, const void *buffer, uint32_t buffer_size);
+uint16_t list_image_begin(const list_image_t *image);
+uint16_t list_image_end(const list_image_t *image);
+uint16_t list_image_next(const list_image_t *image, uint16_t slot);
+uint16_t list_image_prev(const list_image_t *image, uint16_t slot);
+const void *list_image_data(const list_image_t *image, uint16_t slot);
+
+// ========================= 增量序列化 =========================
+// 脏槽位跟踪器作为变更观察者注册到链表上，记录每个槽位最后一次变化时的检查点编号（epoch），
+// list_serialize_delta 只输出某个检查点之后变化过的槽位（数据和链接），list_apply_delta 把它应用到
+// 由完整快照（list_deserialize）恢复的链表上。完整快照保留槽位位置，所以增量可以直接按槽位应用。
+
+#define LIST_DELTA_MAGIC 0x544C4445u  // "EDLT"
+#define LIST_DELTA_LIVE 0x0001         // 槽位记录标志：槽位正在使用，后面跟着元素数据
+
+// 静态分配时跟踪器缓冲区需要的字节数（缓冲区需要4字节对齐）
+#define LIST_DELTA_BUF_SIZE(capacity) ((size_t)(capacity) * sizeof(uint32_t))
+
+typedef struct
+{
+	list_handle_t list;        // 被跟踪的链表
+	uint32_t *slot_epoch;      // 每个槽位最后一次变化时的检查点编号（capacity 个，最高位为使用标志）
+	uint32_t epoch;            // 当前检查点编号，从1开始，最大 0x7FFFFFFF
+	list_observer_t observer;  // 注册到链表上的观察者
+	bool is_static;            // 跟踪器存储是否由外部提供
+} list_delta_t;
+
+typedef list_delta_t *list_delta_handle_t;
+
+/**
+ * @brief 增量头部
+ * @note 头部后面紧跟 count 条槽位记录：list_delta_record_t，使用中的槽位后面再跟 element_size 字节数据
+ */
+typedef struct
+{
+	uint32_t magic;         // LIST_DELTA_MAGIC
+	uint32_t since_epoch;   // 增量的起点检查点（不包含）
+	uint32_t epoch;         // 增量包含的最后一个检查点，下一次增量以它为起点
+	uint16_t element_size;  // 元素大小
+	uint16_t capacity;      // 链表容量
+	uint16_t size;          // 应用后的元素数量
+	uint16_t head;          // 应用后的头节点槽位
+	uint16_t tail;          // 应用后的尾节点槽位
+	uint16_t count;         // 槽位记录数量
+} list_delta_header_t;
+
+typedef struct
+{
+	uint16_t slot;   // 槽位索引
+	uint16_t next;   // 后继槽位
+	uint16_t prev;   // 前驱槽位
+	uint16_t flags;  // LIST_DELTA_LIVE
+} list_delta_record_t;
+
+list_delta_handle_t list_delta_create(list_handle_t list);
+list_delta_handle_t list_delta_create_from_buf(list_handle_t list, void *buf, size_t buf_size);
+void list_delta_free(list_delta_handle_t delta);
+uint32_t list_delta_epoch(list_delta_handle_t delta);
+uint32_t list_get_delta_size(list_delta_handle_t delta, uint32_t since_epoch);
+uint32_t list_serialize_delta(list_delta_handle_t delta, void *buffer, uint32_t buffer_size, uint32_t since_epoch);
+bool list_apply_delta(list_handle_t list, const void *buffer, uint32_t buffer_size, uint32_t *epoch);
+
+// ========================= 写时复制快照 =========================
+// list_snapshot_begin 只记录快照开始时的头节点和元素数量并注册观察者，不复制数据也不遍历链表。之后修改操作
+// 第一次改变某个尚未写出的槽位（删除、替换，或在它后面插入）前，观察者把该槽位原来的后继和元素数据保存到
+// 快照缓冲区；后台线程用 list_snapshot_read/list_snapshot_write 按块写出开始时的链表，只在填充每个块时持有
+// 列表锁，所以长时间的写出不会长时间阻塞插入和删除。写出的数据与开始时调用 list_serialize 的结果中
+// 校验头部之后的部分相同（开始写出时还不知道 CRC32C），list_deserialize 按没有校验头部的数据读取。
+
+// 静态分配时快照缓冲区需要的字节数（槽位位图 + 每个槽位一份原值，缓冲区需要4字节对齐）
+#define LIST_SNAPSHOT_BUF_SIZE(capacity, element_size) \
+	((size_t)LIST_LIVE_MAP_WORDS(capacity) * sizeof(uint32_t) + (size_t)(capacity) * (sizeof(uint16_t) + (element_size)))
+
+typedef struct
+{
+	list_handle_t list;            // 快照的链表
+	uint32_t *frozen;              // 不再需要保存原值的槽位（已保存原值、已写出，或在快照之后才链接）
+	uint8_t *preimage;             // 每个槽位的原值：uint16_t 后继槽位 + 元素数据
+	list_node_t *deferred_prev;    // 后面刚链接了新节点、原来的后继还没有确定的槽位
+	list_node_t *deferred_last;    // 链接在 deferred_prev 后面的最后一个新节点
+	uint32_t total;                // 快照的总字节数
+	uint32_t offset;               // 已写出的字节数
+	uint16_t size;                 // 开始时的元素数量
+	uint16_t cursor;               // 下一条要写出的记录的槽位
+	bool valid;                    // 写出完成前链表没有发生整体重排或重置
+	bool is_static;                // 快照缓冲区是否由外部提供
+	list_observer_t observer;      // 注册到链表上的观察者
+} list_snapshot_t;
+
+typedef list_snapshot_t *list_snapshot_handle_t;
+
+list_snapshot_handle_t list_snapshot_begin(list_handle_t list);
+list_snapshot_handle_t list_snapshot_begin_from_buf(list_handle_t list, void *buf, size_t buf_size);
+uint32_t list_snapshot_size(list_snapshot_handle_t snapshot);
+uint32_t list_snapshot_read(list_snapshot_handle_t snapshot, void *buffer, uint32_t buffer_size);
+uint32_t list_snapshot_write(list_snapshot_handle_t snapshot, list_stream_write_func_t write, void *ctx,
+                             uint32_t chunk_size);
+bool list_snapshot_end(list_snapshot_handle_t snapshot);
+
 #endif
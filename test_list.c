@@ -1,7 +1,16 @@
 #include "test_list.h"
+#include <stddef.h>
 #include <time.h>
 // 在 test_list.c 文件开头添加头文件
 #include "list_save.h"
+#include "list_pq.h"
+#include "list_hash.h"
+#include "list_order.h"
+#include "list_lru.h"
+#include "list_parallel.h"
+#include "list_algo.h"
+#include "list_journal.h"
+#include "list_crc.h"
 #ifdef _WIN32
 #include <windows.h>  // 用于 Sleep 函数
 #else
@@ -28,6 +37,13 @@ bool compare_int_less(const void *a, const void *b)
 	return int_a <= int_b;
 }
 
+int compare_int_order(const void *a, const void *b)
+{
+	int int_a = *(const int *)a;
+	int int_b = *(const int *)b;
+	return (int_a > int_b) - (int_a < int_b);
+}
+
 bool is_even(const void *list_data, const void *predicate_data)
 {
 	int value = *(const int *)list_data;
@@ -599,6 +615,22 @@ test_result_t test_list_swap(void)
 		return result;
 	}
 
+	// 注册了观察者的列表不能与容量不同的节点池交换，索引按原容量分配
+	list_order_handle_t order = list_order_create(list1, compare_int_order);
+	if (order == NULL || list_swap(list1, list2) || list_size(list1) != size2_before ||
+	    list_size(list2) != size1_before || list_capacity(list1) != 3)
+	{
+		result.passed = false;
+		result.message = "有观察者时交换了容量不同的节点池";
+	}
+	if (order)
+		list_order_free(order);
+	if (result.passed && !list_swap(list1, list2))
+	{
+		result.passed = false;
+		result.message = "注销观察者后交换失败";
+	}
+
 	list_free(list1);
 	list_free(list2);
 	return result;
@@ -1860,6 +1892,2940 @@ test_result_t test_list_save_restore(void)
 	return result;
 }
 
+test_result_t test_list_erase_range(void)
+{
+	test_result_t result = {"范围删除与截断操作", true, ""};
+
+	list_handle_t list = list_create(20, sizeof(int));
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	for (int i = 0; i < 10; i++)
+	{
+		list_push_back(list, &i);
+	}
+
+	// 测试1: 删除 [2, 5) 范围
+	list_iterator_t first = list_at(list, 2);
+	list_iterator_t last = list_at(list, 5);
+	uint16_t erased = 0;
+	if (!list_erase_range(list, first, last, &erased) || erased != 3)
+	{
+		result.passed = false;
+		result.message = "范围删除失败";
+		list_free(list);
+		return result;
+	}
+
+	// 验证: 应该是 [0, 1, 5, 6, 7, 8, 9]
+	int expected1[] = {0, 1, 5, 6, 7, 8, 9};
+	list_iterator_t it = list_begin(list);
+	for (int i = 0; i < 7; i++)
+	{
+		if (it == NULL || *(int *)it->data != expected1[i])
+		{
+			result.passed = false;
+			result.message = "范围删除后数据错误";
+			list_free(list);
+			return result;
+		}
+		it = list_next(it);
+	}
+
+	// 测试2: 截断头部2个、尾部2个
+	if (list_truncate_front(list, 2) != 2 || list_truncate_back(list, 2) != 2)
+	{
+		result.passed = false;
+		result.message = "截断返回数量错误";
+		list_free(list);
+		return result;
+	}
+
+	// 验证: 应该是 [5, 6, 7]，并且反向链接完整
+	int expected2[] = {5, 6, 7};
+	it = list_end(list);
+	for (int i = 2; i >= 0; i--)
+	{
+		if (it == NULL || *(int *)it->data != expected2[i])
+		{
+			result.passed = false;
+			result.message = "截断后数据错误";
+			list_free(list);
+			return result;
+		}
+		it = list_prev(it);
+	}
+	if (it != NULL || list_size(list) != 3)
+	{
+		result.passed = false;
+		result.message = "截断后链表结构错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试3: last 为NULL时删除到末尾
+	if (!list_erase_range(list, list_at(list, 1), NULL, &erased) || erased != 2 || list_size(list) != 1)
+	{
+		result.passed = false;
+		result.message = "删除到末尾失败";
+		list_free(list);
+		return result;
+	}
+
+	// 测试4: 截断数量超过元素数量时清空列表
+	if (list_truncate_back(list, 100) != 1 || !list_empty(list) || list_begin(list) != NULL || list_end(list) != NULL)
+	{
+		result.passed = false;
+		result.message = "超量截断应该清空列表";
+		list_free(list);
+		return result;
+	}
+
+	// 测试5: 归还的节点可以被重新使用，容量不丢失
+	for (int i = 0; i < 20; i++)
+	{
+		if (!list_push_back(list, &i))
+		{
+			result.passed = false;
+			result.message = "删除后节点未正确归还";
+			list_free(list);
+			return result;
+		}
+	}
+
+	list_free(list);
+	return result;
+}
+
+test_result_t test_list_splice_n(void)
+{
+	test_result_t result = {"O(1)拼接与合并", true, ""};
+
+	list_handle_t list1 = list_create(20, sizeof(int));
+	list_handle_t list2 = list_create(20, sizeof(int));
+	if (list1 == NULL || list2 == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list1)
+			list_free(list1);
+		if (list2)
+			list_free(list2);
+		return result;
+	}
+
+	int values1[] = {1, 2, 3};
+	int values2[] = {10, 20, 30, 40, 50};
+	for (int i = 0; i < 3; i++)
+		list_push_back(list1, &values1[i]);
+	for (int i = 0; i < 5; i++)
+		list_push_back(list2, &values2[i]);
+
+	// 测试1: 调用者提供数量，将 [20, 40) 移动到 list1 的第二个位置之前
+	if (!list_splice_n(list1, list_at(list1, 1), list2, list_at(list2, 1), list_at(list2, 3), 2))
+	{
+		result.passed = false;
+		result.message = "list_splice_n 失败";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 验证 list1: [1, 20, 30, 2, 3]，list2: [10, 40, 50]
+	int expected1[] = {1, 20, 30, 2, 3};
+	list_iterator_t it = list_begin(list1);
+	for (int i = 0; i < 5; i++)
+	{
+		if (it == NULL || *(int *)it->data != expected1[i])
+		{
+			result.passed = false;
+			result.message = "list_splice_n 后 list1 数据错误";
+			list_free(list1);
+			list_free(list2);
+			return result;
+		}
+		it = list_next(it);
+	}
+	if (list_size(list1) != 5 || list_size(list2) != 3)
+	{
+		result.passed = false;
+		result.message = "list_splice_n 后大小错误";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 测试2: list_merge 移动 list2 的全部节点（包括尾节点）
+	if (!list_merge(list1, list2) || list_size(list1) != 8 || !list_empty(list2))
+	{
+		result.passed = false;
+		result.message = "list_merge 应该移动全部节点";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	int back = 0;
+	if (!list_back(list1, &back) || back != 50 || list_prev(list_end(list1)) == NULL ||
+	    *(int *)list_prev(list_end(list1))->data != 40)
+	{
+		result.passed = false;
+		result.message = "list_merge 后尾部链接错误";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 测试3: 合并空列表直接成功
+	if (!list_merge(list1, list2) || list_size(list1) != 8)
+	{
+		result.passed = false;
+		result.message = "合并空列表应该成功且不改变大小";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	list_free(list1);
+	list_free(list2);
+	return result;
+}
+
+test_result_t test_list_splice_cross_pool(void)
+{
+	test_result_t result = {"跨节点池拼接迁移", true, ""};
+
+	list_handle_t list1 = list_create(6, sizeof(int));
+	list_handle_t list2 = list_create(6, sizeof(int));
+	if (list1 == NULL || list2 == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list1)
+			list_free(list1);
+		if (list2)
+			list_free(list2);
+		return result;
+	}
+
+	int values1[] = {1, 2};
+	int values2[] = {10, 20, 30, 40};
+	for (int i = 0; i < 2; i++)
+		list_push_back(list1, &values1[i]);
+	for (int i = 0; i < 4; i++)
+		list_push_back(list2, &values2[i]);
+
+	// 测试1: 将 list2 的 [20, 40) 迁移到 list1 的开头
+	if (!list_splice(list1, list_begin(list1), list2, list_at(list2, 1), list_at(list2, 3)))
+	{
+		result.passed = false;
+		result.message = "跨节点池拼接失败";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 验证 list1: [20, 30, 1, 2]，且每个节点都位于 list1 的节点池内
+	int expected1[] = {20, 30, 1, 2};
+	size_t pool_bytes = LIST_POOL_BUF_SIZE(6, sizeof(int));
+	list_iterator_t it = list_begin(list1);
+	for (int i = 0; i < 4; i++)
+	{
+		if (it == NULL || *(int *)it->data != expected1[i] ||
+		    (uint8_t *)it < (uint8_t *)list1->node_pool || (uint8_t *)it >= (uint8_t *)list1->node_pool + pool_bytes)
+		{
+			result.passed = false;
+			result.message = "迁移后 list1 数据或节点归属错误";
+			list_free(list1);
+			list_free(list2);
+			return result;
+		}
+		it = list_next(it);
+	}
+
+	// 测试2: 两个列表都能重新填满到各自容量，说明 free_list 归属正确
+	int fill = 99;
+	for (int i = 0; i < 2; i++)
+	{
+		if (!list_push_back(list1, &fill))
+		{
+			result.passed = false;
+			result.message = "list1 free_list 被破坏";
+			list_free(list1);
+			list_free(list2);
+			return result;
+		}
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		if (!list_push_back(list2, &fill))
+		{
+			result.passed = false;
+			result.message = "list2 free_list 被破坏";
+			list_free(list1);
+			list_free(list2);
+			return result;
+		}
+	}
+	if (list_push_back(list1, &fill) || list_push_back(list2, &fill))
+	{
+		result.passed = false;
+		result.message = "超过容量的插入应该失败";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 测试3: 迁移后的列表可以正常序列化
+	uint8_t buffer[128];
+	if (list_serialize(list1, buffer, sizeof(buffer)) == 0)
+	{
+		result.passed = false;
+		result.message = "迁移后序列化失败";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 测试4: 交换后节点池随节点一起交换，仍可序列化
+	if (!list_swap(list1, list2) || list_serialize(list1, buffer, sizeof(buffer)) == 0 || list_serialize(list2, buffer, sizeof(buffer)) == 0)
+	{
+		result.passed = false;
+		result.message = "交换后序列化失败";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 测试5: 共享节点池的列表之间只重链接，节点（迭代器）保持不变
+	list_handle_t shared = list_create_shared(list1);
+	if (shared == NULL)
+	{
+		result.passed = false;
+		result.message = "创建共享节点池列表失败";
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	list_iterator_t moved = list_begin(list1);
+	if (!list_merge(shared, list1) || list_begin(shared) != moved || list_size(shared) != 6 || !list_empty(list1))
+	{
+		result.passed = false;
+		result.message = "共享节点池合并应该直接移动节点";
+		list_free(shared);
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 共享节点池已满，两个列表都不能再插入；释放后另一个列表可以使用
+	if (list_push_back(list1, &fill) || list_pop_front(shared, NULL) == false || !list_push_back(list1, &fill))
+	{
+		result.passed = false;
+		result.message = "共享 free_list 分配错误";
+		list_free(shared);
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 节点池被共享的列表不能与其他节点池的列表交换，两个列表都不修改
+	uint16_t size1 = list_size(list1);
+	uint16_t size2 = list_size(list2);
+	if (list_swap(list1, list2) || list_size(list1) != size1 || list_size(list2) != size2)
+	{
+		result.passed = false;
+		result.message = "共享节点池的列表不应与其他节点池交换";
+		list_free(shared);
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	// 共享节点池的列表不能反序列化
+	if (list_serialize(list2, buffer, sizeof(buffer)) == 0 || list_deserialize(list1, buffer, sizeof(buffer)))
+	{
+		result.passed = false;
+		result.message = "共享节点池的列表不应允许反序列化";
+		list_free(shared);
+		list_free(list1);
+		list_free(list2);
+		return result;
+	}
+
+	list_free(shared);
+	list_free(list1);
+	list_free(list2);
+	return result;
+}
+
+test_result_t test_list_ring_mode(void)
+{
+	test_result_t result = {"环形缓冲模式", true, ""};
+
+	list_handle_t list = list_create(3, sizeof(int));
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	// 测试1: 未启用环形模式时，满后插入失败
+	for (int i = 1; i <= 3; i++)
+		list_push_back(list, &i);
+	int value = 4;
+	if (list_push_back(list, &value))
+	{
+		result.passed = false;
+		result.message = "未启用环形模式时满后插入应该失败";
+		list_free(list);
+		return result;
+	}
+
+	// 测试2: 启用环形模式后，list_push_back 覆盖最旧的元素
+	list_set_ring_mode(list, true);
+	if (!list_push_back(list, &value) || list_size(list) != 3)
+	{
+		result.passed = false;
+		result.message = "环形模式插入失败";
+		list_free(list);
+		return result;
+	}
+
+	// 测试3: list_push_back_ring 返回被淘汰的元素
+	int evicted = 0;
+	bool overwritten = false;
+	value = 5;
+	if (!list_push_back_ring(list, &value, &evicted, &overwritten) || !overwritten || evicted != 2)
+	{
+		result.passed = false;
+		result.message = "未正确报告被淘汰的元素";
+		list_free(list);
+		return result;
+	}
+
+	// 验证: [3, 4, 5]，正反向链接完整
+	int expected[] = {3, 4, 5};
+	list_iterator_t it = list_begin(list);
+	for (int i = 0; i < 3; i++)
+	{
+		if (it == NULL || *(int *)it->data != expected[i])
+		{
+			result.passed = false;
+			result.message = "覆盖后数据错误";
+			list_free(list);
+			return result;
+		}
+		it = list_next(it);
+	}
+	int front = 0, back = 0;
+	if (it != NULL || !list_front(list, &front) || front != 3 || !list_back(list, &back) || back != 5 ||
+	    list_prev(list_end(list)) == NULL || *(int *)list_prev(list_end(list))->data != 4)
+	{
+		result.passed = false;
+		result.message = "覆盖后链表结构错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试4: 未满时不报告覆盖
+	list_pop_front(list, NULL);
+	value = 6;
+	if (!list_push_back_ring(list, &value, &evicted, &overwritten) || overwritten || list_size(list) != 3)
+	{
+		result.passed = false;
+		result.message = "未满时不应该覆盖";
+		list_free(list);
+		return result;
+	}
+
+	// 测试5: 容量为1的环形缓冲
+	list_handle_t single = list_create(1, sizeof(int));
+	if (single == NULL)
+	{
+		result.passed = false;
+		result.message = "创建容量为1的列表失败";
+		list_free(list);
+		return result;
+	}
+	list_set_ring_mode(single, true);
+	for (int i = 0; i < 5; i++)
+		list_push_back(single, &i);
+	if (list_size(single) != 1 || !list_front(single, &front) || front != 4 || list_begin(single) != list_end(single))
+	{
+		result.passed = false;
+		result.message = "容量为1的环形缓冲错误";
+		list_free(single);
+		list_free(list);
+		return result;
+	}
+
+	list_free(single);
+	list_free(list);
+	return result;
+}
+
+test_result_t test_list_pq(void)
+{
+	test_result_t result = {"优先队列", true, ""};
+
+	// 使用静态缓冲区创建
+	static uint32_t node_pool[LIST_POOL_BUF_SIZE(16, sizeof(int)) / sizeof(uint32_t)];
+	static uint16_t heap_buf[LIST_PQ_HEAP_BUF_COUNT(16)];
+	list_pq_handle_t pq = list_pq_create_from_buf(node_pool, heap_buf, 16, sizeof(int), compare_int_order);
+	if (pq == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	int values[] = {50, 20, 80, 10, 70, 30, 90, 60, 40};
+	list_iterator_t its[9];
+	for (int i = 0; i < 9; i++)
+	{
+		its[i] = list_pq_push(pq, &values[i]);
+		if (its[i] == NULL)
+		{
+			result.passed = false;
+			result.message = "插入失败";
+			list_pq_free(pq);
+			return result;
+		}
+	}
+
+	// 测试1: 提前定时器 80 -> 5，删除 30
+	int new_key = 5;
+	if (!list_pq_decrease_key(pq, its[2], &new_key) || !list_pq_remove(pq, its[5]))
+	{
+		result.passed = false;
+		result.message = "修改键值或删除失败";
+		list_pq_free(pq);
+		return result;
+	}
+
+	// 测试2: 已删除的迭代器不能再次删除
+	if (list_pq_remove(pq, its[5]))
+	{
+		result.passed = false;
+		result.message = "重复删除应该失败";
+		list_pq_free(pq);
+		return result;
+	}
+
+	// 测试3: 按优先级顺序出队
+	int expected[] = {5, 10, 20, 40, 50, 60, 70, 90};
+	for (int i = 0; i < 8; i++)
+	{
+		int value = 0;
+		if (*(int *)list_pq_top(pq)->data != expected[i] || !list_pq_pop_min(pq, &value) || value != expected[i])
+		{
+			result.passed = false;
+			result.message = "出队顺序错误";
+			list_pq_free(pq);
+			return result;
+		}
+	}
+
+	if (!list_pq_empty(pq) || list_pq_pop_min(pq, NULL) || list_pq_top(pq) != NULL)
+	{
+		result.passed = false;
+		result.message = "出队后队列应该为空";
+		list_pq_free(pq);
+		return result;
+	}
+
+	// 测试4: 随机插入和删除后仍保持堆序
+	unsigned int seed = 12345;
+	for (int i = 0; i < 16; i++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		int value = (int)((seed >> 16) % 1000);
+		list_pq_push(pq, &value);
+	}
+	list_pq_remove(pq, list_begin(pq->list));
+	list_pq_remove(pq, list_end(pq->list));
+	int last = -1;
+	while (!list_pq_empty(pq))
+	{
+		int value = 0;
+		list_pq_pop_min(pq, &value);
+		if (value < last)
+		{
+			result.passed = false;
+			result.message = "随机操作后出队顺序错误";
+			list_pq_free(pq);
+			return result;
+		}
+		last = value;
+	}
+
+	list_pq_free(pq);
+	return result;
+}
+
+typedef struct
+{
+	uint32_t id;
+	int value;
+} session_t;
+
+test_result_t test_list_hash_index(void)
+{
+	test_result_t result = {"哈希索引", true, ""};
+
+	list_handle_t list = list_create(32, sizeof(session_t));
+	list_handle_t other = list_create(32, sizeof(session_t));
+	static uint16_t table_buf[LIST_HASH_TABLE_COUNT(32)];
+	if (list == NULL || other == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list)
+			list_free(list);
+		if (other)
+			list_free(other);
+		return result;
+	}
+
+	// 先插入一部分元素，再创建索引，验证已有元素被索引
+	for (uint32_t i = 0; i < 10; i++)
+	{
+		session_t s = {i * 7, (int)i};
+		list_push_back(list, &s);
+	}
+
+	list_hash_handle_t index = list_hash_create_from_buf(list, offsetof(session_t, id), sizeof(uint32_t),
+	                                                     table_buf, LIST_HASH_TABLE_COUNT(32));
+	list_hash_handle_t other_index = list_hash_create(other, offsetof(session_t, id), sizeof(uint32_t));
+	if (index == NULL || other_index == NULL)
+	{
+		result.passed = false;
+		result.message = "创建索引失败";
+		list_hash_free(index);
+		list_hash_free(other_index);
+		list_free(list);
+		list_free(other);
+		return result;
+	}
+
+	for (uint32_t i = 10; i < 20; i++)
+	{
+		session_t s = {i * 7, (int)i};
+		list_push_back(list, &s);
+	}
+
+	// 测试1: 按键查找
+	for (uint32_t i = 0; i < 20; i++)
+	{
+		uint32_t key = i * 7;
+		list_iterator_t it = list_hash_find(index, &key);
+		if (it == NULL || ((session_t *)it->data)->value != (int)i)
+		{
+			result.passed = false;
+			result.message = "按键查找失败";
+			list_hash_free(index);
+			list_hash_free(other_index);
+			list_free(list);
+			list_free(other);
+			return result;
+		}
+	}
+	uint32_t missing = 3;
+	if (list_hash_find(index, &missing) != NULL)
+	{
+		result.passed = false;
+		result.message = "不存在的键应该查找失败";
+		list_hash_free(index);
+		list_hash_free(other_index);
+		list_free(list);
+		list_free(other);
+		return result;
+	}
+
+	// 测试2: 替换后索引更新
+	uint32_t key = 14;
+	session_t replaced = {1000, 2};
+	list_replace(list, list_hash_find(index, &key), &replaced);
+	if (list_hash_find(index, &replaced.id) == NULL || list_hash_find(index, &(uint32_t){14}) != NULL)
+	{
+		result.passed = false;
+		result.message = "替换后索引未更新";
+		list_hash_free(index);
+		list_hash_free(other_index);
+		list_free(list);
+		list_free(other);
+		return result;
+	}
+
+	// 测试3: 删除、范围删除后索引更新
+	list_erase(list, list_hash_find(index, &(uint32_t){21}));
+	list_truncate_front(list, 2);  // 删除 id 0 和 7
+	if (list_hash_find(index, &(uint32_t){21}) != NULL || list_hash_find(index, &(uint32_t){0}) != NULL ||
+	    list_hash_find(index, &(uint32_t){7}) != NULL || list_hash_find(index, &(uint32_t){28}) == NULL)
+	{
+		result.passed = false;
+		result.message = "删除后索引未更新";
+		list_hash_free(index);
+		list_hash_free(other_index);
+		list_free(list);
+		list_free(other);
+		return result;
+	}
+
+	// 测试4: list_find / list_contains / list_remove 使用索引，且要求整个元素相同
+	session_t probe = {28, 4};
+	session_t wrong = {28, 99};
+	if (list_find(list, &probe) == NULL || list_contains(list, &wrong) || list_remove(list, &probe) != 1 ||
+	    list_contains(list, &probe))
+	{
+		result.passed = false;
+		result.message = "list_find/list_remove 使用索引错误";
+		list_hash_free(index);
+		list_hash_free(other_index);
+		list_free(list);
+		list_free(other);
+		return result;
+	}
+
+	// 测试5: 拼接到另一个列表（跨节点池迁移）后两个索引都更新
+	uint16_t before = list_size(list);
+	list_iterator_t first = list_hash_find(index, &(uint32_t){35});
+	if (!list_splice(other, NULL, list, first, list_next(list_next(first))) ||
+	    list_hash_find(index, &(uint32_t){35}) != NULL || list_hash_find(other_index, &(uint32_t){35}) == NULL ||
+	    list_hash_find(other_index, &(uint32_t){42}) == NULL || list_size(list) != before - 2)
+	{
+		result.passed = false;
+		result.message = "拼接后索引未更新";
+		list_hash_free(index);
+		list_hash_free(other_index);
+		list_free(list);
+		list_free(other);
+		return result;
+	}
+
+	// 测试6: 清空后索引为空，重新插入可以找到
+	list_clear(list);
+	session_t again = {49, 7};
+	list_push_back(list, &again);
+	if (list_hash_find(index, &(uint32_t){56}) != NULL || list_hash_find(index, &again.id) == NULL)
+	{
+		result.passed = false;
+		result.message = "清空后索引错误";
+		list_hash_free(index);
+		list_hash_free(other_index);
+		list_free(list);
+		list_free(other);
+		return result;
+	}
+
+	// 测试7: 填满容量后仍然正确（负载因子上限）
+	for (uint32_t i = 100; list_size(list) < list_capacity(list); i++)
+	{
+		session_t s = {i, (int)i};
+		list_push_back(list, &s);
+	}
+	for (uint32_t i = 100; i < 131; i++)
+	{
+		if (list_hash_find(index, &i) == NULL)
+		{
+			result.passed = false;
+			result.message = "填满后查找失败";
+			list_hash_free(index);
+			list_hash_free(other_index);
+			list_free(list);
+			list_free(other);
+			return result;
+		}
+	}
+
+	list_hash_free(index);
+	list_hash_free(other_index);
+	list_free(list);
+	list_free(other);
+	return result;
+}
+
+test_result_t test_list_order_index(void)
+{
+	test_result_t result = {"有序索引", true, ""};
+
+	list_handle_t list = list_create(64, sizeof(int));
+	static uint16_t order_buf[LIST_ORDER_BUF_SIZE(64) / sizeof(uint16_t) + 1];
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	// 先插入一部分元素（乱序，含重复值），再创建索引
+	int values[] = {50, 10, 40, 30, 20, 30, 60, 0};
+	for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+		list_push_back(list, &values[i]);
+
+	list_order_handle_t index = list_order_create_from_buf(list, compare_int_order, order_buf, sizeof(order_buf));
+	if (index == NULL)
+	{
+		result.passed = false;
+		result.message = "创建索引失败";
+		list_free(list);
+		return result;
+	}
+
+	for (int v = 5; v < 100; v += 10)
+		list_push_front(list, &v);
+
+	// 测试1: 按索引顺序遍历有序，且元素数量相同
+	uint16_t count = 0;
+	int last = -1;
+	for (list_iterator_t it = list_order_first(index); it != NULL; it = list_order_next(index, it))
+	{
+		if (*(int *)it->data < last)
+		{
+			result.passed = false;
+			result.message = "索引顺序错误";
+			list_order_free(index);
+			list_free(list);
+			return result;
+		}
+		last = *(int *)it->data;
+		count++;
+	}
+	int front = 0;
+	list_front(list, &front);
+	if (count != list_size(list) || front != 95)
+	{
+		result.passed = false;
+		result.message = "索引元素数量错误或链表顺序被改变";
+		list_order_free(index);
+		list_free(list);
+		return result;
+	}
+
+	// 测试2: lower_bound / upper_bound
+	int key = 30;
+	list_iterator_t lower = list_lower_bound(index, &key);
+	list_iterator_t upper = list_upper_bound(index, &key);
+	int above = 96;
+	int between = 31;
+	if (lower == NULL || *(int *)lower->data != 30 || upper == NULL || *(int *)upper->data != 35 ||
+	    list_lower_bound(index, &above) != NULL || *(int *)list_lower_bound(index, &between)->data != 35)
+	{
+		result.passed = false;
+		result.message = "lower_bound/upper_bound 错误";
+		list_order_free(index);
+		list_free(list);
+		return result;
+	}
+
+	// 测试3: 区间 [20, 40) 包含两个重复的 30
+	int low = 20;
+	int high = 40;
+	int expected[] = {20, 25, 30, 30, 35};
+	list_order_range_t range;
+	list_order_range(index, &low, &high, &range);
+	count = 0;
+	for (list_iterator_t it; (it = list_order_range_next(&range)) != NULL; count++)
+	{
+		if (count >= 5 || *(int *)it->data != expected[count])
+		{
+			result.passed = false;
+			result.message = "区间迭代结果错误";
+			list_order_free(index);
+			list_free(list);
+			return result;
+		}
+	}
+	if (count != 5)
+	{
+		result.passed = false;
+		result.message = "区间迭代数量错误";
+		list_order_free(index);
+		list_free(list);
+		return result;
+	}
+
+	// 测试4: 删除和替换后索引更新
+	list_remove(list, &key);  // 删除两个 30
+	int replaced = 21;
+	list_replace(list, list_find(list, &(int){25}), &replaced);
+	list_order_range(index, &low, &high, &range);
+	int expected_after[] = {20, 21, 35};
+	count = 0;
+	for (list_iterator_t it; (it = list_order_range_next(&range)) != NULL; count++)
+	{
+		if (count >= 3 || *(int *)it->data != expected_after[count])
+		{
+			result.passed = false;
+			result.message = "修改后索引未更新";
+			list_order_free(index);
+			list_free(list);
+			return result;
+		}
+	}
+	if (count != 3)
+	{
+		result.passed = false;
+		result.message = "修改后区间数量错误";
+		list_order_free(index);
+		list_free(list);
+		return result;
+	}
+
+	// 测试5: 清空后填满容量，完整区间覆盖所有元素
+	list_clear(list);
+	if (list_order_first(index) != NULL)
+	{
+		result.passed = false;
+		result.message = "清空后索引不为空";
+		list_order_free(index);
+		list_free(list);
+		return result;
+	}
+	for (int v = 0; list_size(list) < list_capacity(list); v++)
+	{
+		int x = (v * 37) % 64;
+		list_push_back(list, &x);
+	}
+	list_order_range(index, NULL, NULL, &range);
+	count = 0;
+	for (list_iterator_t it; (it = list_order_range_next(&range)) != NULL; count++)
+	{
+		if (*(int *)it->data != count)
+		{
+			result.passed = false;
+			result.message = "填满后顺序错误";
+			list_order_free(index);
+			list_free(list);
+			return result;
+		}
+	}
+	if (count != 64)
+	{
+		result.passed = false;
+		result.message = "填满后数量错误";
+	}
+
+	list_order_free(index);
+	list_free(list);
+	return result;
+}
+
+// LRU淘汰回调：记录被淘汰的键
+static void lru_record_evict(const void *element, void *ctx)
+{
+	uint32_t *evicted = (uint32_t *)ctx;
+	evicted[0]++;
+	evicted[1] = ((const session_t *)element)->id;
+}
+
+test_result_t test_list_lru(void)
+{
+	test_result_t result = {"LRU缓存", true, ""};
+
+	static uint32_t node_pool[LIST_POOL_BUF_SIZE(4, sizeof(session_t)) / sizeof(uint32_t)];
+	static uint16_t table_buf[LIST_HASH_TABLE_COUNT(4)];
+	list_lru_handle_t lru = list_lru_create_from_buf(node_pool, table_buf, LIST_HASH_TABLE_COUNT(4), 4,
+	                                                 sizeof(session_t), offsetof(session_t, id), sizeof(uint32_t));
+	if (lru == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	uint32_t evicted[2] = {0, 0};
+	list_lru_set_evict_callback(lru, lru_record_evict, evicted);
+
+	for (uint32_t i = 1; i <= 4; i++)
+	{
+		session_t s = {i, (int)i * 10};
+		list_lru_put(lru, &s);
+	}
+
+	// 测试1: 命中后移动到头部，迭代器指向的节点不变
+	list_iterator_t peeked = list_lru_peek(lru, &(uint32_t){1});
+	list_iterator_t it = list_lru_get(lru, &(uint32_t){1});
+	if (it == NULL || it != peeked || ((session_t *)it->data)->value != 10 || list_begin(lru->list) != it)
+	{
+		result.passed = false;
+		result.message = "命中后未移动到头部";
+		list_lru_free(lru);
+		return result;
+	}
+
+	// 测试2: 满时淘汰最久未使用的元素（键2），并调用淘汰回调
+	session_t s5 = {5, 50};
+	list_iterator_t inserted = list_lru_put(lru, &s5);
+	if (evicted[0] != 1 || evicted[1] != 2 || list_lru_size(lru) != 4 || inserted != list_begin(lru->list) ||
+	    list_lru_peek(lru, &(uint32_t){2}) != NULL || list_lru_peek(lru, &s5.id) != inserted)
+	{
+		result.passed = false;
+		result.message = "淘汰错误";
+		list_lru_free(lru);
+		return result;
+	}
+
+	// 测试3: 更新已有键不淘汰，原地覆盖
+	session_t s3 = {3, 33};
+	list_iterator_t node3 = list_lru_peek(lru, &s3.id);
+	if (list_lru_put(lru, &s3) != node3 || evicted[0] != 1 || ((session_t *)node3->data)->value != 33 ||
+	    list_begin(lru->list) != node3)
+	{
+		result.passed = false;
+		result.message = "更新已有键错误";
+		list_lru_free(lru);
+		return result;
+	}
+
+	// 测试4: 命中统计
+	uint32_t hits = 0;
+	uint32_t misses = 0;
+	list_lru_get(lru, &(uint32_t){2});
+	list_lru_get(lru, &(uint32_t){4});
+	list_lru_stats(lru, &hits, &misses);
+	if (hits != 2 || misses != 1)
+	{
+		result.passed = false;
+		result.message = "命中统计错误";
+		list_lru_free(lru);
+		return result;
+	}
+
+	// 测试5: 最近使用顺序为 4, 3, 5, 1
+	uint32_t expected[] = {4, 3, 5, 1};
+	uint16_t count = 0;
+	for (list_iterator_t node = list_begin(lru->list); node != NULL; node = list_next(node), count++)
+	{
+		if (count >= 4 || ((session_t *)node->data)->id != expected[count])
+		{
+			result.passed = false;
+			result.message = "使用顺序错误";
+			list_lru_free(lru);
+			return result;
+		}
+	}
+
+	// 测试6: 删除不调用淘汰回调
+	if (!list_lru_remove(lru, &(uint32_t){5}) || list_lru_remove(lru, &(uint32_t){5}) || evicted[0] != 1 ||
+	    list_lru_size(lru) != 3)
+	{
+		result.passed = false;
+		result.message = "删除错误";
+	}
+
+	list_lru_free(lru);
+	return result;
+}
+
+// 检查列表正向和反向遍历的结果都与 expected 一致
+static bool list_equals_ints(list_handle_t list, const int *expected, uint16_t count)
+{
+	if (list_size(list) != count)
+		return false;
+
+	list_iterator_t it = list_begin(list);
+	for (uint16_t i = 0; i < count; i++, it = list_next(it))
+	{
+		if (it == NULL || *(int *)it->data != expected[i])
+			return false;
+	}
+
+	it = list_end(list);
+	for (uint16_t i = count; i > 0; i--, it = list_prev(it))
+	{
+		if (it == NULL || *(int *)it->data != expected[i - 1])
+			return false;
+	}
+	return it == NULL;
+}
+
+test_result_t test_list_move_nodes(void)
+{
+	test_result_t result = {"节点移动", true, ""};
+
+	list_handle_t list = list_create(5, sizeof(int));
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	int values[] = {1, 2, 3, 4, 5};
+	for (int i = 0; i < 5; i++)
+		list_push_back(list, &values[i]);
+
+	list_iterator_t n1 = list_at(list, 0);
+	list_iterator_t n3 = list_at(list, 2);
+	list_iterator_t n5 = list_at(list, 4);
+
+	// 测试1: 移动到头部和尾部，迭代器保持有效
+	list_move_to_front(list, n3);
+	list_move_to_back(list, n1);
+	int expected1[] = {3, 2, 4, 5, 1};
+	if (!list_equals_ints(list, expected1, 5) || *(int *)n3->data != 3 || list_begin(list) != n3)
+	{
+		result.passed = false;
+		result.message = "移动到头部/尾部错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试2: 移动到指定位置之前，包括原地不动的情况
+	list_move_before(list, n5, n3);
+	list_move_before(list, n5, n3);
+	list_move_before(list, n1, n1);
+	int expected2[] = {5, 3, 2, 4, 1};
+	if (!list_equals_ints(list, expected2, 5))
+	{
+		result.passed = false;
+		result.message = "移动到指定位置错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试3: 交换相邻节点（两种顺序）和不相邻节点
+	list_swap_nodes(list, n5, n3);
+	int expected3[] = {3, 5, 2, 4, 1};
+	if (!list_equals_ints(list, expected3, 5))
+	{
+		result.passed = false;
+		result.message = "交换相邻节点错误";
+		list_free(list);
+		return result;
+	}
+	list_swap_nodes(list, list_at(list, 3), list_at(list, 2));
+	int expected4[] = {3, 5, 4, 2, 1};
+	if (!list_equals_ints(list, expected4, 5))
+	{
+		result.passed = false;
+		result.message = "反向交换相邻节点错误";
+		list_free(list);
+		return result;
+	}
+	list_swap_nodes(list, n3, n1);
+	int expected5[] = {1, 5, 4, 2, 3};
+	if (!list_equals_ints(list, expected5, 5) || list_begin(list) != n1 || list_end(list) != n3)
+	{
+		result.passed = false;
+		result.message = "交换节点错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试4: 移动不分配节点，列表仍可填满
+	int extra = 6;
+	if (list_push_back(list, &extra) || list_size(list) != 5)
+	{
+		result.passed = false;
+		result.message = "移动后节点数量错误";
+	}
+
+	list_free(list);
+	return result;
+}
+
+typedef struct
+{
+	int sum;
+	int count;
+	int max;
+} sum_data_t;
+
+static void sum_values(list_iterator_t it, void *user_data)
+{
+	sum_data_t *data = (sum_data_t *)user_data;
+	int value = *(int *)it->data;
+	data->sum += value;
+	data->count++;
+	if (value > data->max)
+		data->max = value;
+}
+
+test_result_t test_list_unordered_traversal(void)
+{
+	test_result_t result = {"无序遍历与预取遍历", true, ""};
+
+	list_handle_t list = list_create(100, sizeof(int));
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	for (int i = 0; i < 100; i++)
+		list_push_back(list, &i);
+
+	// 测试1: 预取遍历下的条件删除和条件查找（长度远大于预取距离）
+	uint16_t removed = list_remove_if(list, is_even, NULL);
+	int target = 97;
+	list_iterator_t found = list_find_if(list, NULL, NULL, &target);
+	if (removed != 50 || list_size(list) != 50 || found == NULL || *(int *)found->data != 97 ||
+	    list_next(found) == NULL || *(int *)list_next(found)->data != 99)
+	{
+		result.passed = false;
+		result.message = "条件删除或查找错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试2: 打乱顺序并释放部分节点后，无序遍历访问每个元素恰好一次
+	list_reverse(list);
+	list_truncate_front(list, 5);  // 删除 99, 97, 95, 93, 91
+	for (int i = 200; i < 210; i++)
+		list_push_front(list, &i);
+
+	sum_data_t ordered = {0, 0, 0};
+	sum_data_t unordered = {0, 0, 0};
+	list_for_each_if(list, sum_values, &ordered);
+	list_for_each_unordered(list, sum_values, &unordered);
+	if (unordered.count != list_size(list) || unordered.sum != ordered.sum || unordered.max != 209)
+	{
+		result.passed = false;
+		result.message = "无序遍历结果错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试3: 无序遍历后列表仍然可以正常分配和释放节点
+	list_clear(list);
+	for (int i = 0; i < 100; i++)
+		list_push_back(list, &i);
+	unordered.sum = 0;
+	unordered.count = 0;
+	list_for_each_unordered(list, sum_values, &unordered);
+	if (unordered.count != 100 || unordered.sum != 4950 || list_push_back(list, &target))
+	{
+		result.passed = false;
+		result.message = "无序遍历后节点池状态错误";
+	}
+
+	list_free(list);
+	return result;
+}
+
+// 打乱列表：反复删除头部附近的元素并在尾部重新插入，使相邻元素分散到不同槽位
+static void churn_list(list_handle_t list, int rounds)
+{
+	for (int i = 0; i < rounds; i++)
+	{
+		int value = 0;
+		list_iterator_t it = list_at(list, (int16_t)(i % 3));
+		if (it == NULL)
+			break;
+		value = *(int *)it->data;
+		list_erase(list, it);
+		if (i % 2 == 0)
+			list_push_front(list, &value);
+		else
+			list_push_back(list, &value);
+	}
+}
+
+// 把列表中的元素依次复制到 values，返回元素个数
+static uint16_t copy_ints(list_handle_t list, int *values, uint16_t max)
+{
+	uint16_t count = 0;
+	for (list_iterator_t it = list_begin(list); it != NULL && count < max; it = list_next(it))
+		values[count++] = *(int *)it->data;
+	return count;
+}
+
+test_result_t test_list_compact(void)
+{
+	test_result_t result = {"节点池整理", true, ""};
+
+	list_handle_t list = list_create(40, sizeof(int));
+	list_hash_handle_t index = NULL;
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	for (int i = 0; i < 30; i++)
+		list_push_back(list, &i);
+	index = list_hash_create(list, 0, sizeof(int));
+	churn_list(list, 50);
+	list_truncate_back(list, 4);
+
+	int before[40];
+	int after[40];
+	uint16_t count = copy_ints(list, before, 40);
+
+	// 测试1: 完整整理后元素顺序不变，碎片为0，空闲节点从尾部槽位分配
+	if (list_fragmentation(list) == 0 || !list_compact(list) || list_fragmentation(list) != 0 ||
+	    copy_ints(list, after, 40) != count || memcmp(before, after, count * sizeof(int)) != 0 ||
+	    list_node_slot(list, list_begin(list)) != 0)
+	{
+		result.passed = false;
+		result.message = "完整整理错误";
+		list_hash_free(index);
+		list_free(list);
+		return result;
+	}
+	int extra = 100;
+	list_push_back(list, &extra);
+	if (list_node_slot(list, list_end(list)) != count || list_fragmentation(list) != 0 ||
+	    list_find(list, &before[5]) == NULL || *(int *)list_find(list, &before[5])->data != before[5])
+	{
+		result.passed = false;
+		result.message = "整理后分配或索引错误";
+		list_hash_free(index);
+		list_free(list);
+		return result;
+	}
+
+	// 测试2: 增量整理，中途修改列表后从头开始，最终完成
+	churn_list(list, 40);
+	list_compact_t state;
+	if (!list_compact_begin(list, &state))
+	{
+		result.passed = false;
+		result.message = "开始增量整理失败";
+		list_hash_free(index);
+		list_free(list);
+		return result;
+	}
+	int steps = 0;
+	bool done = false;
+	while (!done && steps < 100)
+	{
+		done = list_compact_step(&state, 4);
+		steps++;
+		if (steps == 3)
+		{
+			int value = 200;
+			list_push_front(list, &value);
+		}
+	}
+	count = copy_ints(list, before, 40);
+	if (!done || list_fragmentation(list) != 0 || count != list_size(list) || before[0] != 200)
+	{
+		result.passed = false;
+		result.message = "增量整理错误";
+		list_hash_free(index);
+		list_free(list);
+		return result;
+	}
+
+	// 测试3: 增量整理逐个通知移动，索引始终正确
+	for (uint16_t i = 0; i < count; i++)
+	{
+		list_iterator_t it = list_find(list, &before[i]);
+		if (it == NULL || *(int *)it->data != before[i])
+		{
+			result.passed = false;
+			result.message = "增量整理后索引错误";
+			list_hash_free(index);
+			list_free(list);
+			return result;
+		}
+	}
+
+	// 测试4: 共享节点池的列表不能整理
+	list_handle_t shared = list_create_shared(list);
+	if (shared == NULL || list_compact(list) || list_compact(shared))
+	{
+		result.passed = false;
+		result.message = "共享节点池不应整理";
+	}
+
+	list_free(shared);
+	list_hash_free(index);
+	list_free(list);
+	return result;
+}
+
+test_result_t test_list_live_map(void)
+{
+	test_result_t result = {"活动槽位位图扫描", true, ""};
+
+	list_handle_t list = list_create(70, sizeof(int));
+	static uint32_t map_buf[LIST_LIVE_MAP_WORDS(70)];
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	// 启用前已有的元素也要计入位图
+	for (int i = 0; i < 40; i++)
+		list_push_back(list, &i);
+	if (!list_enable_live_map(list, map_buf))
+	{
+		result.passed = false;
+		result.message = "启用位图失败";
+		list_free(list);
+		return result;
+	}
+
+	// 单个删除、范围删除、插入、环形覆盖都要维护位图
+	list_remove_if(list, is_even, NULL);
+	list_truncate_front(list, 3);  // 删除 1, 3, 5
+	for (int i = 100; i < 150; i++)
+		list_push_front(list, &i);
+	list_set_ring_mode(list, true);
+	for (int i = 300; i < 305; i++)
+		list_push_back(list, &i);
+
+	sum_data_t ordered = {0, 0, 0};
+	sum_data_t scanned = {0, 0, 0};
+	list_for_each_if(list, sum_values, &ordered);
+	list_scan_pool(list, sum_values, &scanned);
+	if (scanned.count != list_size(list) || scanned.sum != ordered.sum || scanned.max != 304)
+	{
+		result.passed = false;
+		result.message = "位图扫描结果错误";
+		list_free(list);
+		return result;
+	}
+
+	// 顺序扫描版 list_contains
+	int present = 7;
+	int absent = 8;
+	if (!list_contains(list, &present) || list_contains(list, &absent))
+	{
+		result.passed = false;
+		result.message = "位图扫描查找错误";
+		list_free(list);
+		return result;
+	}
+
+	// 整理和清空后位图仍然正确
+	list_compact(list);
+	scanned.sum = 0;
+	scanned.count = 0;
+	list_for_each_unordered(list, sum_values, &scanned);
+	if (scanned.count != list_size(list) || scanned.sum != ordered.sum)
+	{
+		result.passed = false;
+		result.message = "整理后位图错误";
+		list_free(list);
+		return result;
+	}
+	list_clear(list);
+	scanned.count = 0;
+	list_scan_pool(list, sum_values, &scanned);
+	if (scanned.count != 0 || list_contains(list, &present))
+	{
+		result.passed = false;
+		result.message = "清空后位图错误";
+		list_free(list);
+		return result;
+	}
+
+	// 关闭位图后退化为无序遍历
+	list_push_back(list, &present);
+	list_disable_live_map(list);
+	scanned.count = 0;
+	list_scan_pool(list, sum_values, &scanned);
+	if (scanned.count != 1 || !list_contains(list, &present))
+	{
+		result.passed = false;
+		result.message = "关闭位图后扫描错误";
+	}
+
+	list_free(list);
+	return result;
+}
+
+// 并行回调：每个元素只被一个线程访问，直接修改元素是线程安全的
+static void triple_value(list_iterator_t it, void *user_data)
+{
+	(void)user_data;
+	*(int *)it->data *= 3;
+}
+
+static bool is_multiple_of_six(const void *list_data, const void *predicate_data)
+{
+	(void)predicate_data;
+	return *(const int *)list_data % 6 == 0;
+}
+
+test_result_t test_list_parallel(void)
+{
+	test_result_t result = {"并行遍历", true, ""};
+
+	list_workers_handle_t workers = list_workers_create(4);
+	list_handle_t list = list_create(1000, sizeof(int));
+	if (workers == NULL || list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		list_workers_free(workers);
+		if (list)
+			list_free(list);
+		return result;
+	}
+
+	for (int i = 0; i < 999; i++)
+		list_push_back(list, &i);
+
+	// 测试1: 沿链表切分，每个元素恰好处理一次
+	list_parallel_for_each(workers, list, triple_value, NULL);
+	int index = 0;
+	for (list_iterator_t it = list_begin(list); it != NULL; it = list_next(it), index++)
+	{
+		if (*(int *)it->data != index * 3)
+		{
+			result.passed = false;
+			result.message = "并行 for_each 结果错误";
+			list_free(list);
+			list_workers_free(workers);
+			return result;
+		}
+	}
+
+	// 测试2: 并行计数与串行结果一致
+	if (list_parallel_count_if(workers, list, is_multiple_of_six, NULL) != 500 ||
+	    list_parallel_count_if(workers, list, NULL, &(int){9}) != 1)
+	{
+		result.passed = false;
+		result.message = "并行计数错误";
+		list_free(list);
+		list_workers_free(workers);
+		return result;
+	}
+
+	// 测试3: 按槽位范围切分（活动槽位位图）后并行删除
+	list_enable_live_map(list, NULL);
+	if (list_parallel_remove_if(workers, list, is_multiple_of_six, NULL) != 500 || list_size(list) != 499 ||
+	    list_parallel_count_if(workers, list, is_multiple_of_six, NULL) != 0)
+	{
+		result.passed = false;
+		result.message = "并行删除错误";
+		list_free(list);
+		list_workers_free(workers);
+		return result;
+	}
+
+	// 测试4: 剩余元素保持原来的相对顺序
+	int last = -1;
+	for (list_iterator_t it = list_begin(list); it != NULL; it = list_next(it))
+	{
+		int value = *(int *)it->data;
+		if (value <= last || value % 6 == 0)
+		{
+			result.passed = false;
+			result.message = "并行删除后顺序错误";
+			break;
+		}
+		last = value;
+	}
+
+	list_free(list);
+	list_workers_free(workers);
+	return result;
+}
+
+typedef struct
+{
+	uint16_t id;
+	int16_t reading;
+} algo_sample_t;
+
+test_result_t test_list_algorithms(void)
+{
+	test_result_t result = {"内联批量算法", true, ""};
+
+	list_handle_t list = list_create(100, sizeof(algo_sample_t));
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	// 读数依次为 0, 7, 14, ... 对 50 取模后减 20，范围 [-20, 29]
+	for (uint16_t i = 0; i < 60; i++)
+	{
+		algo_sample_t sample = {i, (int16_t)((i * 7) % 50 - 20)};
+		list_push_back(list, &sample);
+	}
+
+	// 测试1: 累加、归约、条件计数与逐个遍历的结果一致
+	int expected_sum = 0;
+	uint16_t expected_negative = 0;
+	uint32_t expected_hash = 0;
+	for (list_iterator_t it = list_begin(list); it != NULL; it = list_next(it))
+	{
+		const algo_sample_t *sample = (const algo_sample_t *)it->data;
+		expected_sum += sample->reading;
+		expected_negative += (sample->reading < 0);
+		expected_hash = expected_hash * 31u + (uint32_t)sample->id;
+	}
+
+	int sum = 0;
+	uint16_t negative = 0;
+	uint32_t hash = 0;
+	LIST_ACCUMULATE(list, algo_sample_t, s, sum, s.reading);
+	LIST_COUNT_IF(list, algo_sample_t, s, negative, s.reading < 0);
+	LIST_REDUCE(list, algo_sample_t, s, hash, hash * 31u + (uint32_t)s.id);
+	if (sum != expected_sum || negative != expected_negative || hash != expected_hash)
+	{
+		result.passed = false;
+		result.message = "累加、归约或计数结果错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试2: 最小最大值，相同值时返回链表中第一个
+	list_iterator_t min_it, max_it;
+	LIST_MIN_MAX(list, algo_sample_t, a, b, min_it, max_it, a.reading < b.reading);
+	if (min_it == NULL || max_it == NULL || ((algo_sample_t *)min_it->data)->reading != -20 ||
+	    ((algo_sample_t *)min_it->data)->id != 0 || ((algo_sample_t *)max_it->data)->reading != 29 ||
+	    ((algo_sample_t *)max_it->data)->id != 7)
+	{
+		result.passed = false;
+		result.message = "最小最大值错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试3: 原地变换会通知索引
+	list_hash_handle_t index = list_hash_create(list, offsetof(algo_sample_t, id), sizeof(uint16_t));
+	LIST_TRANSFORM_INPLACE(list, algo_sample_t, s, (algo_sample_t){(uint16_t)(s.id + 1000), (int16_t)(s.reading * 2)});
+	uint16_t old_id = 5, new_id = 1005;
+	list_iterator_t found = list_hash_find(index, &new_id);
+	if (index == NULL || list_hash_find(index, &old_id) != NULL || found == NULL ||
+	    ((algo_sample_t *)found->data)->reading != 2 * ((5 * 7) % 50 - 20))
+	{
+		result.passed = false;
+		result.message = "原地变换错误";
+	}
+	list_hash_free(index);
+
+	// 测试4: 空列表和NULL列表
+	list_clear(list);
+	sum = 0;
+	LIST_ACCUMULATE(list, algo_sample_t, s, sum, s.reading);
+	LIST_MIN_MAX(list, algo_sample_t, a, b, min_it, max_it, a.reading < b.reading);
+	LIST_ACCUMULATE((list_handle_t)NULL, algo_sample_t, s, sum, s.reading);
+	if (sum != 0 || min_it != NULL || max_it != NULL)
+	{
+		result.passed = false;
+		result.message = "空列表处理错误";
+	}
+
+	list_free(list);
+	return result;
+}
+
+test_result_t test_list_partition_select(void)
+{
+	test_result_t result = {"稳定划分与第n小元素", true, ""};
+
+	list_handle_t list = list_create(64, sizeof(int));
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	int values[] = {5, 8, 1, 4, 7, 2, 6, 3};
+	for (int i = 0; i < 8; i++)
+		list_push_back(list, &values[i]);
+
+	// 测试1: 偶数在前，两部分都保持原来的相对顺序，节点本身不变
+	list_iterator_t node_four = list_find(list, &values[3]);
+	list_iterator_t split = list_partition(list, is_even, NULL);
+	int expected[] = {8, 4, 2, 6, 5, 1, 7, 3};
+	if (!list_equals_ints(list, expected, 8) || split == NULL || *(int *)split->data != 5 ||
+	    list_find(list, &values[3]) != node_four)
+	{
+		result.passed = false;
+		result.message = "稳定划分错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试2: 全部满足时返回NULL，不改变顺序
+	int zero = 0;
+	list_clear(list);
+	for (int i = 0; i < 4; i++)
+		list_push_back(list, &zero);
+	if (list_partition(list, NULL, &zero) != NULL || list_size(list) != 4)
+	{
+		result.passed = false;
+		result.message = "全部满足时划分错误";
+		list_free(list);
+		return result;
+	}
+
+	// 测试3: 对每个 n 选择，结果与排序后的位置一致，两侧满足大小关系（含重复元素）
+	int data[] = {9, 3, 7, 3, 1, 8, 2, 9, 5, 3, 0, 6};
+	int sorted[] = {0, 1, 2, 3, 3, 3, 5, 6, 7, 8, 9, 9};
+	for (uint16_t n = 0; n < 12 && result.passed; n++)
+	{
+		list_clear(list);
+		for (int i = 0; i < 12; i++)
+			list_push_back(list, &data[i]);
+
+		list_iterator_t nth = list_nth_element(list, n, compare_int_order);
+		if (nth == NULL || *(int *)nth->data != sorted[n] || list_at(list, (int16_t)n) != nth ||
+		    list_size(list) != 12)
+		{
+			result.passed = false;
+			result.message = "第n小元素错误";
+			break;
+		}
+
+		uint16_t position = 0;
+		for (list_iterator_t it = list_begin(list); it != NULL; it = list_next(it), position++)
+		{
+			int value = *(int *)it->data;
+			if ((position < n && value > sorted[n]) || (position > n && value < sorted[n]) ||
+			    (it->next != NULL && it->next->prev != it))
+			{
+				result.passed = false;
+				result.message = "第n小元素两侧顺序错误";
+				break;
+			}
+		}
+		if (list_end(list) == NULL || list_end(list)->next != NULL)
+		{
+			result.passed = false;
+			result.message = "尾指针错误";
+		}
+	}
+
+	// 测试4: 越界
+	if (list_nth_element(list, 12, compare_int_order) != NULL || list_nth_element(list, 0, NULL) != NULL)
+	{
+		result.passed = false;
+		result.message = "越界处理错误";
+	}
+
+	list_free(list);
+	return result;
+}
+
+test_result_t test_list_image(void)
+{
+	test_result_t result = {"节点池映像", true, ""};
+
+	list_handle_t list = list_create(16, sizeof(int));
+	uint32_t buffer[64];
+	if (list == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		return result;
+	}
+
+	// 删除部分元素后再插入，使链表顺序与槽位顺序不同
+	for (int i = 0; i < 8; i++)
+		list_push_back(list, &i);
+	list_remove_if(list, is_even, NULL);
+	int front = 100;
+	list_push_front(list, &front);
+	int expected[] = {100, 1, 3, 5, 7};
+
+	uint32_t size = list_image_size(list);
+	if (size == 0 || size > sizeof(buffer) || list_image_write(list, buffer, sizeof(buffer)) != size)
+	{
+		result.passed = false;
+		result.message = "写入映像失败";
+		list_free(list);
+		return result;
+	}
+
+	// 测试1: 打开映像后按槽位正向、反向遍历
+	list_image_t image;
+	if (!list_image_open(&image, buffer, size) || image.size != 5)
+	{
+		result.passed = false;
+		result.message = "打开映像失败";
+		list_free(list);
+		return result;
+	}
+
+	int index = 0;
+	for (uint16_t slot = list_image_begin(&image); slot != LIST_INVALID_SLOT; slot = list_image_next(&image, slot))
+	{
+		if (index >= 5 || *(const int *)list_image_data(&image, slot) != expected[index] ||
+		    slot != list_node_slot(list, list_at(list, (int16_t)index)))
+		{
+			result.passed = false;
+			result.message = "映像正向遍历错误";
+			break;
+		}
+		index++;
+	}
+	for (uint16_t slot = list_image_end(&image); slot != LIST_INVALID_SLOT; slot = list_image_prev(&image, slot))
+	{
+		if (index <= 0 || *(const int *)list_image_data(&image, slot) != expected[--index])
+		{
+			result.passed = false;
+			result.message = "映像反向遍历错误";
+			break;
+		}
+	}
+
+	// 测试2: 截断或损坏的映像被拒绝
+	if (list_image_open(&image, buffer, size - 1))
+	{
+		result.passed = false;
+		result.message = "截断映像未被拒绝";
+	}
+	buffer[0] ^= 1;
+	if (list_image_open(&image, buffer, size))
+	{
+		result.passed = false;
+		result.message = "损坏映像未被拒绝";
+	}
+
+	// 测试3: 整理节点池后映像只包含 size 条记录
+	list_compact(list);
+	if (list_image_write(list, buffer, sizeof(buffer)) != sizeof(list_image_header_t) + 5 * 8 ||
+	    !list_image_open(&image, buffer, sizeof(buffer)) || image.slots != 5 ||
+	    *(const int *)list_image_data(&image, list_image_begin(&image)) != 100)
+	{
+		result.passed = false;
+		result.message = "整理后映像错误";
+	}
+
+	// 测试4: 空链表
+	list_clear(list);
+	if (list_image_write(list, buffer, sizeof(buffer)) != sizeof(list_image_header_t) ||
+	    !list_image_open(&image, buffer, sizeof(list_image_header_t)) ||
+	    list_image_begin(&image) != LIST_INVALID_SLOT)
+	{
+		result.passed = false;
+		result.message = "空链表映像错误";
+	}
+
+	list_free(list);
+	return result;
+}
+
+// 比较两个链表的元素和槽位位置是否完全相同
+static bool list_same_layout(list_handle_t a, list_handle_t b)
+{
+	if (list_size(a) != list_size(b))
+		return false;
+
+	list_iterator_t x = list_begin(a);
+	list_iterator_t y = list_begin(b);
+	for (; x != NULL && y != NULL; x = list_next(x), y = list_next(y))
+	{
+		if (*(int *)x->data != *(int *)y->data || list_node_slot(a, x) != list_node_slot(b, y))
+			return false;
+	}
+	return x == NULL && y == NULL && list_node_slot(a, list_end(a)) == list_node_slot(b, list_end(b));
+}
+
+test_result_t test_list_delta(void)
+{
+	test_result_t result = {"增量序列化", true, ""};
+
+	list_handle_t list = list_create(32, sizeof(int));
+	list_handle_t replica = list_create(32, sizeof(int));
+	list_handle_t other = list_create(8, sizeof(int));
+	uint8_t buffer[512];
+	if (list == NULL || replica == NULL || other == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list)
+			list_free(list);
+		if (replica)
+			list_free(replica);
+		if (other)
+			list_free(other);
+		return result;
+	}
+
+	for (int i = 0; i < 20; i++)
+		list_push_back(list, &i);
+
+	// 基准：创建跟踪器后保存一次完整快照
+	list_delta_handle_t delta = list_delta_create(list);
+	uint32_t size = list_serialize(list, buffer, sizeof(buffer));
+	if (delta == NULL || size == 0 || !list_deserialize(replica, buffer, size))
+	{
+		result.passed = false;
+		result.message = "基准快照失败";
+		list_delta_free(delta);
+		list_free(list);
+		list_free(replica);
+		list_free(other);
+		return result;
+	}
+
+	// 测试1: 没有变化时增量只有头部
+	uint32_t since = 0;
+	uint32_t applied = 0;  // 副本所在的检查点，由完整快照恢复后为0
+	size = list_serialize_delta(delta, buffer, sizeof(buffer), since);
+	if (size != sizeof(list_delta_header_t) || !list_apply_delta(replica, buffer, size, &applied) ||
+	    !list_same_layout(list, replica))
+	{
+		result.passed = false;
+		result.message = "空增量错误";
+	}
+	since = ((list_delta_header_t *)buffer)->epoch;
+
+	// 测试2: 插入、删除、替换后增量只包含变化的槽位
+	int value = 100;
+	list_erase(list, list_at(list, 5));
+	list_replace(list, list_at(list, 10), &value);
+	value = 200;
+	list_push_front(list, &value);
+	uint32_t expected_size = list_get_delta_size(delta, since);
+	size = list_serialize_delta(delta, buffer, sizeof(buffer), since);
+	if (size == 0 || size != expected_size ||
+	    ((list_delta_header_t *)buffer)->count > 6 || !list_apply_delta(replica, buffer, size, &applied) ||
+	    !list_same_layout(list, replica))
+	{
+		result.passed = false;
+		result.message = "增量应用后不一致";
+	}
+	since = ((list_delta_header_t *)buffer)->epoch;
+
+	// 测试3: 跨链表拼接、反转、范围删除后继续应用
+	for (int i = 50; i < 53; i++)
+		list_push_back(other, &i);
+	list_splice(list, list_at(list, 3), other, list_begin(other), NULL);
+	list_reverse(list);
+	list_erase_range(list, list_at(list, 2), list_at(list, 6), NULL);
+	size = list_serialize_delta(delta, buffer, sizeof(buffer), since);
+	if (size == 0 || !list_apply_delta(replica, buffer, size, &applied) || !list_same_layout(list, replica))
+	{
+		result.passed = false;
+		result.message = "拼接反转后增量不一致";
+	}
+	since = ((list_delta_header_t *)buffer)->epoch;
+
+	// 测试4: 应用后副本可以正常使用
+	list_push_back(replica, &value);
+	list_pop_back(replica, NULL);
+	if (!list_same_layout(list, replica))
+	{
+		result.passed = false;
+		result.message = "应用后副本状态错误";
+	}
+
+	// 测试5: 损坏的增量被拒绝，缓冲区不足时失败
+	list_clear(list);
+	size = list_serialize_delta(delta, buffer, sizeof(buffer), since);
+	if (list_serialize_delta(delta, buffer, 8, 0) != 0 || list_apply_delta(replica, buffer, size - 1, &applied) ||
+	    !list_apply_delta(replica, buffer, size, &applied) || list_size(replica) != 0)
+	{
+		result.passed = false;
+		result.message = "异常增量处理错误";
+	}
+	since = ((list_delta_header_t *)buffer)->epoch;
+
+	// 测试6: 重复应用或跳过一个增量时被拒绝，副本和检查点都不变
+	value = 300;
+	list_push_back(list, &value);
+	size = list_serialize_delta(delta, buffer, sizeof(buffer), since);
+	since = ((list_delta_header_t *)buffer)->epoch;
+	if (!list_apply_delta(replica, buffer, size, &applied) || applied != since ||
+	    list_apply_delta(replica, buffer, size, &applied) || applied != since || !list_same_layout(list, replica))
+	{
+		result.passed = false;
+		result.message = "重复应用的增量未被拒绝";
+	}
+	list_push_back(list, &value);
+	list_serialize_delta(delta, buffer, sizeof(buffer), since);  // 这个增量丢失
+	since = ((list_delta_header_t *)buffer)->epoch;
+	list_push_back(list, &value);
+	size = list_serialize_delta(delta, buffer, sizeof(buffer), since);
+	if (list_apply_delta(replica, buffer, size, &applied) || applied == since || list_size(replica) != 1)
+	{
+		result.passed = false;
+		result.message = "跳过增量后应用未被拒绝";
+	}
+
+	list_delta_free(delta);
+	list_free(list);
+	list_free(replica);
+	list_free(other);
+	return result;
+}
+
+typedef struct
+{
+	uint8_t data[1024];
+	uint32_t size;
+	uint16_t writes;
+	uint16_t syncs;
+} journal_sink_t;
+
+static bool journal_sink_write(const void *data, uint32_t size, void *ctx)
+{
+	journal_sink_t *sink = (journal_sink_t *)ctx;
+	if (sink->size + size > sizeof(sink->data))
+		return false;
+	memcpy(sink->data + sink->size, data, size);
+	sink->size += size;
+	sink->writes++;
+	return true;
+}
+
+static bool journal_sink_sync(void *ctx)
+{
+	((journal_sink_t *)ctx)->syncs++;
+	return true;
+}
+
+// 比较两个链表的元素是否相同（不比较槽位）
+static bool list_same_values(list_handle_t a, list_handle_t b)
+{
+	if (list_size(a) != list_size(b))
+		return false;
+
+	list_iterator_t x = list_begin(a);
+	list_iterator_t y = list_begin(b);
+	for (; x != NULL && y != NULL; x = list_next(x), y = list_next(y))
+	{
+		if (*(int *)x->data != *(int *)y->data)
+			return false;
+	}
+	return x == NULL && y == NULL;
+}
+
+test_result_t test_list_journal(void)
+{
+	test_result_t result = {"变更日志", true, ""};
+
+	list_handle_t list = list_create(32, sizeof(int));
+	list_handle_t replica = list_create(32, sizeof(int));
+	journal_sink_t sink;
+	memset(&sink, 0, sizeof(sink));
+	uint8_t snapshot[256];
+	if (list == NULL || replica == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list)
+			list_free(list);
+		if (replica)
+			list_free(replica);
+		return result;
+	}
+
+	for (int i = 0; i < 10; i++)
+		list_push_back(list, &i);
+	uint32_t snapshot_size = list_serialize(list, snapshot, sizeof(snapshot));
+
+	// 每4条记录成组提交一次
+	list_journal_config_t config = {journal_sink_write, journal_sink_sync, &sink, 4};
+	list_journal_handle_t journal = list_journal_create(list, 256, &config);
+	if (journal == NULL || snapshot_size == 0)
+	{
+		result.passed = false;
+		result.message = "创建日志失败";
+		list_journal_free(journal);
+		list_free(list);
+		list_free(replica);
+		return result;
+	}
+
+	// 测试1: 插入、删除、替换、反转、整理节点池
+	int value = 100;
+	list_insert(list, list_at(list, 3), &value);
+	list_erase(list, list_at(list, 0));
+	list_remove_if(list, is_even, NULL);
+	value = 200;
+	list_replace(list, list_at(list, 1), &value);
+	list_reverse(list);
+	list_push_front(list, &value);
+	list_compact(list);
+	list_journal_commit(journal);
+	if (sink.writes == 0 || sink.syncs != sink.writes || journal->records < 10 || list_journal_failed(journal))
+	{
+		result.passed = false;
+		result.message = "成组提交错误";
+	}
+
+	uint32_t replayed = 0;
+	if (!list_deserialize(replica, snapshot, snapshot_size) ||
+	    !list_journal_replay(replica, sink.data, sink.size, &replayed) || replayed != journal->records ||
+	    !list_same_values(list, replica))
+	{
+		result.passed = false;
+		result.message = "快照加日志恢复后不一致";
+	}
+
+	// 测试2: 清空后重新写入，末尾记录写入不完整时被忽略
+	list_clear(list);
+	value = 7;
+	list_push_back(list, &value);
+	value = 8;
+	list_push_back(list, &value);
+	list_journal_commit(journal);
+	list_deserialize(replica, snapshot, snapshot_size);
+	if (!list_journal_replay(replica, sink.data, sink.size - 2, &replayed) || replayed != journal->records - 1 ||
+	    list_size(replica) != 1 || *(int *)list_begin(replica)->data != 7)
+	{
+		result.passed = false;
+		result.message = "不完整记录处理错误";
+	}
+
+	// 测试3: 日志与快照不匹配时失败
+	list_clear(replica);
+	uint8_t bad[LIST_JOURNAL_RECORD_HEADER_SIZE] = {LIST_JOURNAL_ERASE, 0, 5, 0, 0, 0, 0, 0};
+	if (list_journal_replay(replica, bad, sizeof(bad), &replayed) || replayed != 0)
+	{
+		result.passed = false;
+		result.message = "不匹配的日志未被拒绝";
+	}
+
+	// 测试4: 缓冲区模式，缓冲区放不下时标记丢失
+	list_journal_free(journal);
+	journal = list_journal_create(list, LIST_JOURNAL_RECORD_HEADER_SIZE + sizeof(int), NULL);
+	uint32_t used = 0;
+	list_push_back(list, &value);
+	list_journal_data(journal, &used);
+	if (journal == NULL || used != LIST_JOURNAL_RECORD_HEADER_SIZE + sizeof(int) || list_journal_failed(journal))
+	{
+		result.passed = false;
+		result.message = "缓冲区模式错误";
+	}
+	list_push_back(list, &value);
+	if (!list_journal_failed(journal))
+	{
+		result.passed = false;
+		result.message = "缓冲区溢出未标记";
+	}
+	list_journal_clear(journal);
+	if (list_journal_failed(journal))
+	{
+		result.passed = false;
+		result.message = "清空日志错误";
+	}
+
+	list_journal_free(journal);
+	list_free(list);
+	list_free(replica);
+	return result;
+}
+
+typedef struct
+{
+	const uint8_t *data;
+	uint32_t size;
+	uint32_t pos;
+	list_handle_t modify;  // 非NULL时写入回调修改这个链表
+} stream_source_t;
+
+static bool stream_modify_write(const void *data, uint32_t size, void *ctx)
+{
+	(void)data;
+	(void)size;
+	stream_source_t *source = (stream_source_t *)ctx;
+	int value = 0;
+	list_push_back(source->modify, &value);
+	return true;
+}
+
+// 每次最多返回5字节，模拟分段到达的数据
+static uint32_t stream_source_read(void *data, uint32_t size, void *ctx)
+{
+	stream_source_t *source = (stream_source_t *)ctx;
+	uint32_t n = source->size - source->pos;
+	if (n > size)
+		n = size;
+	if (n > 5)
+		n = 5;
+	memcpy(data, source->data + source->pos, n);
+	source->pos += n;
+	return n;
+}
+
+test_result_t test_list_stream(void)
+{
+	test_result_t result = {"流式序列化", true, ""};
+
+	list_handle_t list = list_create(20, sizeof(int));
+	list_handle_t restored = list_create(20, sizeof(int));
+	journal_sink_t sink;
+	memset(&sink, 0, sizeof(sink));
+	uint8_t expected[256];
+	if (list == NULL || restored == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list)
+			list_free(list);
+		if (restored)
+			list_free(restored);
+		return result;
+	}
+
+	for (int i = 0; i < 12; i++)
+		list_push_back(list, &i);
+	list_erase(list, list_at(list, 2));
+	list_reverse(list);
+
+	// 测试1: 记录跨越块边界，结果与 list_serialize 相同
+	uint32_t expected_size = list_serialize(list, expected, sizeof(expected)) - (uint32_t)sizeof(list_save_header_t);
+	uint32_t written = list_serialize_stream(list, journal_sink_write, &sink, 7);
+	if (written != expected_size || sink.size != expected_size ||
+	    memcmp(sink.data, expected + sizeof(list_save_header_t), expected_size) != 0 ||
+	    sink.writes != (expected_size + 6) / 7)
+	{
+		result.passed = false;
+		result.message = "流式序列化结果错误";
+	}
+
+	// 测试2: 分段读取恢复
+	stream_source_t source = {sink.data, sink.size, 0, NULL};
+	if (!list_deserialize_stream(restored, stream_source_read, &source) || !list_same_values(list, restored) ||
+	    list_node_slot(restored, list_begin(restored)) != list_node_slot(list, list_begin(list)))
+	{
+		result.passed = false;
+		result.message = "流式反序列化错误";
+	}
+	int value = 99;
+	if (!list_push_back(restored, &value) || list_size(restored) != 12)
+	{
+		result.passed = false;
+		result.message = "恢复后空闲节点错误";
+	}
+
+	// 测试3: 数据不完整时失败并清空链表
+	source.pos = 0;
+	source.size = sink.size - 3;
+	if (list_deserialize_stream(restored, stream_source_read, &source) || list_size(restored) != 0 ||
+	    list_push_back(restored, &value) == false)
+	{
+		result.passed = false;
+		result.message = "不完整数据处理错误";
+	}
+
+	// 测试4: 两个块之间链表被修改时失败
+	stream_source_t modifier = {NULL, 0, 0, list};
+	if (list_serialize_stream(list, stream_modify_write, &modifier, 8) != 0 ||
+	    list_serialize_stream(list, journal_sink_write, &sink, 4) != 0)
+	{
+		result.passed = false;
+		result.message = "并发修改或块大小检查错误";
+	}
+
+	list_free(list);
+	list_free(restored);
+	return result;
+}
+
+test_result_t test_list_packed(void)
+{
+	test_result_t result = {"压缩序列化", true, ""};
+
+	list_handle_t list = list_create(64, sizeof(int));
+	list_handle_t restored = list_create(64, sizeof(int));
+	uint8_t plain[512];
+	uint8_t packed[512];
+	if (list == NULL || restored == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list)
+			list_free(list);
+		if (restored)
+			list_free(restored);
+		return result;
+	}
+
+	// 缓慢变化的数据，中间删除和重新插入一些元素使槽位不连续，反转产生负的索引差值
+	for (int i = 0; i < 60; i++)
+	{
+		int value = 1000 + i / 4;
+		list_push_back(list, &value);
+	}
+	list_erase(list, list_at(list, 10));
+	list_erase(list, list_at(list, 30));
+	int value = 7;
+	list_push_front(list, &value);
+	list_reverse(list);
+	uint32_t plain_size = list_serialize(list, plain, sizeof(plain));
+
+	// 测试1: 所有编码组合都能恢复相同的链表和槽位
+	static const uint16_t flag_sets[] = {0, LIST_PACK_INDEX_DELTA, LIST_PACK_XOR_DELTA,
+	                                     LIST_PACK_INDEX_DELTA | LIST_PACK_XOR_DELTA};
+	for (size_t f = 0; f < sizeof(flag_sets) / sizeof(flag_sets[0]); f++)
+	{
+		for (int c = 0; c < 2; c++)
+		{
+			const list_pack_codec_t *codec = c ? &list_pack_lz : NULL;
+			uint32_t size = list_serialize_packed(list, packed, sizeof(packed), flag_sets[f], codec);
+			list_clear(restored);
+			if (size == 0 || size > list_get_pack_bound(list, flag_sets[f], codec) ||
+			    !list_deserialize_packed(restored, packed, size, codec) || !list_same_layout(list, restored))
+			{
+				result.passed = false;
+				result.message = "压缩格式往返错误";
+			}
+		}
+	}
+
+	// 测试2: 差值编码加压缩明显小于原格式
+	uint32_t size = list_serialize_packed(list, packed, sizeof(packed), LIST_PACK_INDEX_DELTA | LIST_PACK_XOR_DELTA,
+	                                      &list_pack_lz);
+	if (size == 0 || size * 3 > plain_size || ((list_pack_header_t *)packed)->codec != LIST_PACK_CODEC_LZ)
+	{
+		result.passed = false;
+		result.message = "压缩效果错误";
+	}
+
+	// 测试3: 缺少压缩器或数据损坏时失败，压缩数据无效时链表不变
+	if (list_deserialize_packed(restored, packed, size, NULL) || list_size(restored) != list_size(list))
+	{
+		result.passed = false;
+		result.message = "缺少压缩器未被拒绝";
+	}
+	packed[size - 1] ^= 0x5A;
+	packed[sizeof(list_pack_header_t)] ^= 0xF0;
+	if (list_deserialize_packed(restored, packed, size, &list_pack_lz) ||
+	    list_deserialize_packed(restored, packed, size - 1, &list_pack_lz))
+	{
+		result.passed = false;
+		result.message = "损坏的数据未被拒绝";
+	}
+
+	// 测试4: LZ 处理重叠匹配、长字面量和不可压缩数据
+	uint8_t src[300];
+	uint8_t encoded[400];
+	uint8_t decoded[300];
+	for (int i = 0; i < 300; i++)
+		src[i] = i < 100 ? 0 : (i < 200 ? (uint8_t)(i * 37 + (i >> 3)) : (uint8_t)(i % 3));
+	uint32_t encoded_size = list_pack_lz.encode(src, sizeof(src), encoded, sizeof(encoded));
+	if (encoded_size == 0 || encoded_size > list_pack_lz.bound(sizeof(src)) ||
+	    list_pack_lz.decode(encoded, encoded_size, decoded, sizeof(decoded)) != sizeof(src) ||
+	    memcmp(src, decoded, sizeof(src)) != 0 || list_pack_lz.encode(src, sizeof(src), encoded, 20) != 0)
+	{
+		result.passed = false;
+		result.message = "LZ 编解码错误";
+	}
+
+	list_free(list);
+	list_free(restored);
+	return result;
+}
+
+test_result_t test_list_pack_order_only(void)
+{
+	test_result_t result = {"只保存顺序的快照", true, ""};
+
+	list_handle_t list = list_create(32, sizeof(int));
+	list_handle_t small = list_create(12, sizeof(int));
+	list_handle_t tiny = list_create(4, sizeof(int));
+	uint8_t buffer[256];
+	if (list == NULL || small == NULL || tiny == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list)
+			list_free(list);
+		if (small)
+			list_free(small);
+		if (tiny)
+			list_free(tiny);
+		return result;
+	}
+
+	// 删除一些元素使槽位不连续
+	for (int i = 0; i < 20; i++)
+		list_push_back(list, &i);
+	list_remove_if(list, is_even, NULL);
+	list_reverse(list);
+
+	// 测试1: 只保存元素数据，同时设置的索引差值被忽略
+	uint32_t size =
+	    list_serialize_packed(list, buffer, sizeof(buffer), LIST_PACK_ORDER_ONLY | LIST_PACK_INDEX_DELTA, NULL);
+	if (size != sizeof(list_pack_header_t) + list_size(list) * sizeof(int) + LIST_PACK_CRC_SIZE ||
+	    ((list_pack_header_t *)buffer)->flags != LIST_PACK_ORDER_ONLY)
+	{
+		result.passed = false;
+		result.message = "快照大小错误";
+	}
+
+	// 测试2: 恢复到容量较小的链表中，元素放入连续的槽位
+	bool contiguous = list_deserialize_packed(small, buffer, size, NULL) && list_same_values(list, small);
+	uint16_t slot = 0;
+	for (list_iterator_t it = list_begin(small); it != NULL && contiguous; it = list_next(it))
+		contiguous = list_node_slot(small, it) == slot++;
+	int value = 100;
+	if (!contiguous || !list_push_back(small, &value) || !list_push_back(small, &value) || list_push_back(small, &value))
+	{
+		result.passed = false;
+		result.message = "恢复到连续槽位错误";
+	}
+
+	// 测试3: 与异或差值和压缩器组合
+	size = list_serialize_packed(list, buffer, sizeof(buffer), LIST_PACK_ORDER_ONLY | LIST_PACK_XOR_DELTA,
+	                             &list_pack_lz);
+	if (size == 0 || !list_deserialize_packed(small, buffer, size, &list_pack_lz) || !list_same_values(list, small))
+	{
+		result.passed = false;
+		result.message = "组合编码错误";
+	}
+
+	// 测试4: 容量小于元素数量时失败
+	if (list_deserialize_packed(tiny, buffer, size, &list_pack_lz))
+	{
+		result.passed = false;
+		result.message = "容量不足未被拒绝";
+	}
+
+	list_free(list);
+	list_free(small);
+	list_free(tiny);
+	return result;
+}
+
+test_result_t test_list_crc(void)
+{
+	test_result_t result = {"CRC32C校验", true, ""};
+
+	// 测试1: 标准校验值，分段计算和查表法结果相同
+	uint8_t bytes[301];
+	for (int i = 0; i < (int)sizeof(bytes); i++)
+		bytes[i] = (uint8_t)(i * 131 + 7);
+	uint32_t whole = list_crc32c(0, bytes + 1, 300);
+	if (list_crc32c(0, "123456789", 9) != 0xE3069283u || list_crc32c_table_only(0, "123456789", 9) != 0xE3069283u ||
+	    list_crc32c(list_crc32c(0, bytes + 1, 13), bytes + 14, 287) != whole ||
+	    list_crc32c_table_only(0, bytes + 1, 300) != whole)
+	{
+		result.passed = false;
+		result.message = "CRC32C计算错误";
+		return result;
+	}
+
+	list_handle_t list = list_create(32, sizeof(int));
+	list_handle_t restored = list_create(32, sizeof(int));
+	journal_sink_t sink;
+	memset(&sink, 0, sizeof(sink));
+	uint8_t buffer[256];
+	if (list == NULL || restored == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+		if (list)
+			list_free(list);
+		if (restored)
+			list_free(restored);
+		return result;
+	}
+	for (int i = 0; i < 24; i++)
+		list_push_back(list, &i);
+	list_erase(list, list_at(list, 5));
+
+	// 测试2: 压缩格式中任何一个字节损坏都被发现，链表不变
+	uint32_t size = list_serialize_packed(list, buffer, sizeof(buffer), LIST_PACK_INDEX_DELTA, NULL);
+	list_deserialize_packed(restored, buffer, size, NULL);
+	buffer[sizeof(list_pack_header_t) + 10] ^= 0x01;
+	if (list_deserialize_packed(restored, buffer, size, NULL) || !list_same_layout(list, restored))
+	{
+		result.passed = false;
+		result.message = "损坏的快照未被发现";
+	}
+	buffer[sizeof(list_pack_header_t) + 10] ^= 0x01;
+
+	// 测试3: 版本1（没有校验）仍然可以读取
+	list_store_le16(buffer + offsetof(list_pack_header_t, version), 1);
+	list_clear(restored);
+	if (!list_deserialize_packed(restored, buffer, size - LIST_PACK_CRC_SIZE, NULL) ||
+	    !list_same_layout(list, restored))
+	{
+		result.passed = false;
+		result.message = "版本1读取错误";
+	}
+
+	// 测试4: 带校验的流，每帧独立校验
+	uint32_t written = list_serialize_stream_checked(list, journal_sink_write, &sink, 16);
+	stream_source_t source = {sink.data, sink.size, 0, NULL};
+	list_clear(restored);
+	if (written == 0 || written != sink.size || !list_deserialize_stream_checked(restored, stream_source_read, &source) ||
+	    !list_same_layout(list, restored))
+	{
+		result.passed = false;
+		result.message = "带校验的流往返错误";
+	}
+
+	// 第二帧中的一个字节损坏：读取失败并清空链表
+	uint32_t second_frame = sizeof(list_stream_checked_header_t) + 16 + 2 * sizeof(uint32_t);
+	sink.data[second_frame + 6] ^= 0x40;
+	source.pos = 0;
+	if (list_deserialize_stream_checked(restored, stream_source_read, &source) || list_size(restored) != 0)
+	{
+		result.passed = false;
+		result.message = "损坏的帧未被发现";
+	}
+	sink.data[second_frame + 6] ^= 0x40;
+
+	// 最后一帧不完整
+	source.pos = 0;
+	source.size = sink.size - 1;
+	if (list_deserialize_stream_checked(restored, stream_source_read, &source))
+	{
+		result.passed = false;
+		result.message = "不完整的流未被发现";
+	}
+
+	// 测试5: list_serialize 的数据任何一个字节损坏或被截断都被发现，链表不变
+	size = list_serialize(list, buffer, sizeof(buffer));
+	list_deserialize(restored, buffer, size);
+	buffer[size - 3] ^= 0x08;
+	if (size == 0 || list_deserialize(restored, buffer, size) || list_deserialize(restored, buffer, size - 1) ||
+	    !list_same_layout(list, restored))
+	{
+		result.passed = false;
+		result.message = "损坏的 list_serialize 数据未被发现";
+	}
+	buffer[size - 3] ^= 0x08;
+
+	// 没有校验头部的旧数据仍然可以读取
+	list_clear(restored);
+	if (!list_deserialize(restored, buffer + sizeof(list_save_header_t), size - sizeof(list_save_header_t)) ||
+	    !list_same_layout(list, restored))
+	{
+		result.passed = false;
+		result.message = "旧格式读取错误";
+	}
+
+	list_free(list);
+	list_free(restored);
+	return result;
+}
+
+test_result_t test_list_portable_format(void)
+{
+	test_result_t result = {"持久化格式字节布局", true, ""};
+
+	// 元素使用字节数组，所有字节（包括头部字段）在任何主机上都应当相同
+	static const uint8_t snapshot[] = {
+		0x45, 0x4C, 0x53, 0x31, 0x01, 0x00, 0x00, 0x00,        // "ELS1", version=1, reserved
+		0x12, 0x00, 0x00, 0x00, 0x12, 0xDD, 0xC1, 0x22,        // length=18, CRC32C
+		0x02, 0x00, 0x04, 0x00, 0x04, 0x00,                    // size=2, capacity=4, element_size=4
+		0x01, 0x00, 0xA1, 0xA2, 0xA3, 0xA4,                    // 槽位1
+		0x00, 0x00, 0x11, 0x22, 0x33, 0x44,                    // 槽位0
+	};
+	static const uint8_t packed[] = {
+		0x45, 0x4C, 0x50, 0x4B, 0x02, 0x00, 0x00, 0x00,        // "ELPK", version=2, flags=0
+		0x04, 0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x00,        // element_size, capacity, size, codec, reserved
+		0x0C, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00,        // raw_size=12, data_size=12
+		0x01, 0x00, 0xA1, 0xA2, 0xA3, 0xA4,
+		0x00, 0x00, 0x11, 0x22, 0x33, 0x44,
+		0x1B, 0xD7, 0xC4, 0x0E,                                // CRC32C
+	};
+	static const uint8_t image[] = {
+		0x45, 0x4C, 0x49, 0x4D, 0x01, 0x00, 0x04, 0x00,        // "ELIM", version=1, element_size=4
+		0x04, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,        // capacity, size, head=1, tail=0
+		0x02, 0x00, 0x08, 0x00,                                // slots=2, record_size=8
+		0xFF, 0xFF, 0x01, 0x00, 0x11, 0x22, 0x33, 0x44,        // 槽位0: next=无, prev=1
+		0x00, 0x00, 0xFF, 0xFF, 0xA1, 0xA2, 0xA3, 0xA4,        // 槽位1: next=0, prev=无
+	};
+	static const uint8_t record[] = {
+		0x01, 0x00, 0x01, 0x00, 0xFF, 0xFF, 0x00, 0x00,        // 插入槽位1，前驱无，后继槽位0
+		0xA1, 0xA2, 0xA3, 0xA4,
+	};
+	const uint8_t first[4] = {0xA1, 0xA2, 0xA3, 0xA4};
+	const uint8_t second[4] = {0x11, 0x22, 0x33, 0x44};
+
+	list_handle_t list = list_create(4, sizeof(first));
+	list_handle_t restored = list_create(4, sizeof(first));
+	list_journal_handle_t journal = NULL;
+	uint8_t buffer[64];
+	uint8_t base[32];
+	if (list == NULL || restored == NULL)
+	{
+		result.passed = false;
+		result.message = "创建链表失败";
+	}
+	else
+	{
+		list_push_back(list, second);
+		list_serialize(list, base, sizeof(base));
+		journal = list_journal_create(list, 64, NULL);
+		list_push_front(list, first);
+	}
+
+	// 测试1: 各种格式的输出与固定的字节布局一致
+	uint32_t size;
+	const void *log;
+	if (result.passed)
+	{
+		log = list_journal_data(journal, &size);
+		if (size != sizeof(record) || memcmp(log, record, sizeof(record)) != 0)
+		{
+			result.passed = false;
+			result.message = "日志记录布局错误";
+		}
+		else if (list_serialize(list, buffer, sizeof(buffer)) != sizeof(snapshot) ||
+		         memcmp(buffer, snapshot, sizeof(snapshot)) != 0)
+		{
+			result.passed = false;
+			result.message = "快照布局错误";
+		}
+		else if (list_serialize_packed(list, buffer, sizeof(buffer), 0, NULL) != sizeof(packed) ||
+		         memcmp(buffer, packed, sizeof(packed)) != 0)
+		{
+			result.passed = false;
+			result.message = "压缩格式布局错误";
+		}
+		else if (list_image_write(list, buffer, sizeof(buffer)) != sizeof(image) ||
+		         memcmp(buffer, image, sizeof(image)) != 0)
+		{
+			result.passed = false;
+			result.message = "映像布局错误";
+		}
+	}
+
+	// 测试2: 从固定字节恢复（不要求缓冲区对齐）
+	if (result.passed)
+	{
+		memcpy(buffer + 1, snapshot, sizeof(snapshot));
+		uint8_t front[4] = {0}, back[4] = {0};
+		if (!list_deserialize(restored, buffer + 1, sizeof(snapshot)) || list_size(restored) != 2 ||
+		    !list_front(restored, front) || !list_back(restored, back) || memcmp(front, first, 4) != 0 ||
+		    memcmp(back, second, 4) != 0 ||
+		    list_node_slot(restored, list_begin(restored)) != 1)
+		{
+			result.passed = false;
+			result.message = "快照恢复失败";
+		}
+		list_clear(restored);
+		memcpy(buffer + 1, packed, sizeof(packed));
+		if (result.passed && (!list_deserialize_packed(restored, buffer + 1, sizeof(packed), NULL) ||
+		                      !list_same_layout(list, restored)))
+		{
+			result.passed = false;
+			result.message = "压缩格式恢复失败";
+		}
+		list_image_t view;
+		if (result.passed && (!list_image_open(&view, image, sizeof(image)) || list_image_begin(&view) != 1 ||
+		                      list_image_next(&view, 1) != 0 || list_image_next(&view, 0) != LIST_INVALID_SLOT ||
+		                      memcmp(list_image_data(&view, 0), second, 4) != 0))
+		{
+			result.passed = false;
+			result.message = "映像读取失败";
+		}
+		if (result.passed && (!list_deserialize(restored, base, sizeof(base)) ||
+		                      !list_journal_replay(restored, record, sizeof(record), NULL) ||
+		                      !list_same_values(list, restored)))
+		{
+			result.passed = false;
+			result.message = "日志重放失败";
+		}
+	}
+
+	list_journal_free(journal);
+	list_free(list);
+	list_free(restored);
+	return result;
+}
+
+test_result_t test_list_parallel_deserialize(void)
+{
+	test_result_t result = {"并行反序列化", true, ""};
+
+	list_workers_handle_t workers = list_workers_create(4);
+	list_workers_handle_t single = list_workers_create(1);
+	list_handle_t list = list_create(1000, sizeof(int));
+	list_handle_t serial = list_create(1000, sizeof(int));
+	list_handle_t parallel = list_create(1000, sizeof(int));
+	uint32_t buffer_size = 8 + 1000 * 6;
+	uint8_t *buffer = (uint8_t *)malloc(buffer_size);
+	if (workers == NULL || single == NULL || list == NULL || serial == NULL || parallel == NULL || buffer == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+	}
+	else
+	{
+		// 删除一部分元素并打乱顺序，使槽位不连续
+		for (int i = 0; i < 990; i++)
+			list_push_back(list, &i);
+		list_remove_if(list, is_multiple_of_six, NULL);
+		list_reverse(list);
+		list_enable_live_map(parallel, NULL);
+	}
+
+	// 测试1: 链接、数据和空闲链表都与 list_deserialize 相同（之后分配的槽位顺序也相同）
+	uint32_t size = 0;
+	if (result.passed)
+	{
+		size = list_serialize(list, buffer, buffer_size);
+		if (!list_deserialize(serial, buffer, size) || !list_parallel_deserialize(workers, parallel, buffer, size) ||
+		    !list_same_layout(serial, parallel))
+		{
+			result.passed = false;
+			result.message = "恢复结果与串行不同";
+		}
+		for (int i = 0; result.passed && list_size(serial) < 1000; i++)
+		{
+			list_push_front(serial, &i);
+			list_push_front(parallel, &i);
+		}
+		if (result.passed && (!list_same_layout(serial, parallel) || list_push_back(parallel, &size)))
+		{
+			result.passed = false;
+			result.message = "空闲链表与串行不同";
+		}
+	}
+
+	// 测试2: 活动槽位位图同时重建
+	if (result.passed && (!list_parallel_deserialize(workers, parallel, buffer, size) ||
+	                      list_parallel_count_if(workers, parallel, is_multiple_of_six, NULL) != 0 ||
+	                      list_parallel_count_if(workers, parallel, NULL, &(int){7}) != 1))
+	{
+		result.passed = false;
+		result.message = "活动槽位位图错误";
+	}
+
+	// 测试3: 不同分区中的重复槽位和越界槽位被发现，链表不被修改（没有校验头部的旧数据）
+	if (result.passed)
+	{
+		list_deserialize(serial, buffer, size);
+		uint8_t *data = buffer + sizeof(list_save_header_t);
+		uint32_t data_size = size - (uint32_t)sizeof(list_save_header_t);
+		uint8_t saved[2];
+		uint8_t *last = data + data_size - (2 + sizeof(int));
+		memcpy(saved, last, 2);
+		memcpy(last, data + 6, 2);
+		if (list_parallel_deserialize(workers, parallel, data, data_size) || !list_same_layout(serial, parallel))
+		{
+			result.passed = false;
+			result.message = "重复槽位未被发现";
+		}
+		last[0] = 0xE8;
+		last[1] = 0x03;
+		if (result.passed &&
+		    (list_parallel_deserialize(single, parallel, data, data_size) || !list_same_layout(serial, parallel)))
+		{
+			result.passed = false;
+			result.message = "越界槽位未被发现";
+		}
+		memcpy(last, saved, 2);
+	}
+
+	// 测试4: 损坏或被截断的数据在并行恢复开始前被校验头部发现，链表不被修改
+	if (result.passed)
+	{
+		buffer[size - 1] ^= 0x20;
+		if (list_parallel_deserialize(workers, parallel, buffer, size) || !list_same_layout(serial, parallel))
+		{
+			result.passed = false;
+			result.message = "损坏的数据未被发现";
+		}
+		buffer[size - 1] ^= 0x20;
+		if (result.passed &&
+		    (list_parallel_deserialize(workers, parallel, buffer, size - 1) || !list_same_layout(serial, parallel)))
+		{
+			result.passed = false;
+			result.message = "被截断的数据未被发现";
+		}
+	}
+
+	// 测试5: 单线程和空链表
+	if (result.passed)
+	{
+		list_clear(list);
+		uint32_t empty = list_serialize(list, buffer, buffer_size);
+		if (!list_parallel_deserialize(single, parallel, buffer, empty) || list_size(parallel) != 0 ||
+		    !list_push_back(parallel, &empty) || list_size(parallel) != 1)
+		{
+			result.passed = false;
+			result.message = "空链表恢复失败";
+		}
+	}
+
+	free(buffer);
+	if (list)
+		list_free(list);
+	if (serial)
+		list_free(serial);
+	if (parallel)
+		list_free(parallel);
+	list_workers_free(workers);
+	list_workers_free(single);
+	return result;
+}
+
+// 快照写出过程中的生产者：每写出一块就修改一次链表
+typedef struct
+{
+	journal_sink_t sink;
+	list_handle_t list;
+	int next;
+} snapshot_producer_t;
+
+static bool snapshot_producer_write(const void *data, uint32_t size, void *ctx)
+{
+	snapshot_producer_t *producer = (snapshot_producer_t *)ctx;
+	int value = producer->next++;
+	list_pop_front(producer->list, NULL);
+	list_push_back(producer->list, &value);
+	return journal_sink_write(data, size, &producer->sink);
+}
+
+// 快照不带校验头部：list_serialize 的结果去掉校验头部后与快照相同
+static uint32_t snapshot_serialize(list_handle_t list, uint8_t *buffer, uint32_t buffer_size)
+{
+	uint32_t size = list_serialize(list, buffer, buffer_size);
+	if (size < sizeof(list_save_header_t))
+		return 0;
+	size -= (uint32_t)sizeof(list_save_header_t);
+	memmove(buffer, buffer + sizeof(list_save_header_t), size);
+	return size;
+}
+
+// 按步骤修改链表，覆盖插入、删除、替换、成段删除和跨节点池拼接
+static void snapshot_mutate(list_handle_t list, list_handle_t other, int step)
+{
+	int value = 1000 + step;
+	switch (step % 7)
+	{
+	case 0:
+		list_push_back(list, &value);
+		break;
+	case 1:
+		list_pop_front(list, NULL);
+		break;
+	case 2:
+		list_insert(list, list_at(list, 5), &value);
+		break;
+	case 3:
+		list_erase(list, list_at(list, 7));
+		break;
+	case 4:
+		list_replace(list, list_at(list, 3), &value);
+		break;
+	case 5:
+		list_erase_range(list, list_at(list, 2), list_at(list, 4), NULL);
+		break;
+	default:
+		for (int i = 0; i < 3; i++, value += 100)
+			list_push_back(other, &value);
+		list_splice(list, list_at(list, 6), other, list_begin(other), NULL);
+		break;
+	}
+}
+
+test_result_t test_list_snapshot(void)
+{
+	test_result_t result = {"写时复制快照", true, ""};
+
+	list_handle_t list = list_create(64, sizeof(int));
+	list_handle_t other = list_create(8, sizeof(int));
+	snapshot_producer_t producer;
+	memset(&producer, 0, sizeof(producer));
+	uint8_t expected[512];
+	uint8_t output[512];
+	static uint32_t snapshot_buf[(LIST_SNAPSHOT_BUF_SIZE(64, sizeof(int)) + 3) / 4];
+	if (list == NULL || other == NULL)
+	{
+		result.passed = false;
+		result.message = "创建失败";
+	}
+	for (int i = 0; result.passed && i < 40; i++)
+		list_push_back(list, &i);
+
+	// 测试1: 每读出几个字节就修改一次链表，读出的数据仍然与开始时的 list_serialize（去掉校验头部）相同
+	uint32_t size = 0;
+	if (result.passed)
+	{
+		size = snapshot_serialize(list, expected, sizeof(expected));
+		list_snapshot_handle_t snapshot = list_snapshot_begin(list);
+		uint32_t used = 0;
+		uint32_t n;
+		for (int step = 0; snapshot != NULL && (n = list_snapshot_read(snapshot, output + used, 7)) > 0; step++)
+		{
+			used += n;
+			snapshot_mutate(list, other, step);
+		}
+		if (snapshot == NULL || list_snapshot_size(snapshot) != size || !list_snapshot_end(snapshot) ||
+		    used != size || memcmp(output, expected, size) != 0)
+		{
+			result.passed = false;
+			result.message = "快照与开始时的链表不同";
+		}
+	}
+
+	// 测试2: 写出过程中增量整理节点池（节点移动到其他槽位）
+	if (result.passed)
+	{
+		size = snapshot_serialize(list, expected, sizeof(expected));
+		list_snapshot_handle_t snapshot = list_snapshot_begin(list);
+		list_compact_t compact;
+		bool compacting = list_compact_begin(list, &compact);
+		uint32_t used = 0;
+		uint32_t n;
+		while (snapshot != NULL && (n = list_snapshot_read(snapshot, output + used, 10)) > 0)
+		{
+			used += n;
+			if (compacting)
+				compacting = !list_compact_step(&compact, 2);
+		}
+		if (compacting)
+			list_compact_end(&compact);
+		if (snapshot == NULL || !list_snapshot_end(snapshot) || used != size || memcmp(output, expected, size) != 0)
+		{
+			result.passed = false;
+			result.message = "整理节点池后快照错误";
+		}
+	}
+
+	// 测试3: 整体重排后快照失效
+	if (result.passed)
+	{
+		list_snapshot_handle_t snapshot = list_snapshot_begin(list);
+		list_snapshot_read(snapshot, output, 16);
+		list_reverse(list);
+		journal_sink_t sink;
+		memset(&sink, 0, sizeof(sink));
+		if (snapshot == NULL || list_snapshot_read(snapshot, output, sizeof(output)) != 0 ||
+		    list_snapshot_write(snapshot, journal_sink_write, &sink, 12) != 0 || sink.size != 0 ||
+		    list_snapshot_end(snapshot))
+		{
+			result.passed = false;
+			result.message = "重排后快照未失效";
+		}
+	}
+
+	// 测试4: 外部缓冲区，写入回调（锁外）中继续修改链表，写出的数据可以直接恢复
+	if (result.passed)
+	{
+		size = snapshot_serialize(list, expected, sizeof(expected));
+		producer.list = list;
+		producer.next = 2000;
+		list_snapshot_handle_t snapshot = list_snapshot_begin_from_buf(list, snapshot_buf, sizeof(snapshot_buf));
+		list_handle_t restored = list_create(64, sizeof(int));
+		if (snapshot == NULL || list_snapshot_write(snapshot, snapshot_producer_write, &producer, 12) != size ||
+		    !list_snapshot_end(snapshot) || producer.sink.size != size ||
+		    memcmp(producer.sink.data, expected, size) != 0 || restored == NULL ||
+		    !list_deserialize(restored, producer.sink.data, size) || list_size(restored) != (size - 6) / 6)
+		{
+			result.passed = false;
+			result.message = "写入回调中修改链表后快照错误";
+		}
+		if (restored)
+			list_free(restored);
+	}
+
+	if (list)
+		list_free(list);
+	if (other)
+		list_free(other);
+	return result;
+}
+
 // ========================= 主测试函数 =========================
 
 void run_all_tests(void)
@@ -1891,6 +4857,31 @@ void run_all_tests(void)
 	print_test_result(test_list_edge_cases());
 	print_test_result(test_list_performance());
 	print_test_result(test_list_save_restore());
+	print_test_result(test_list_erase_range());
+	print_test_result(test_list_splice_n());
+	print_test_result(test_list_splice_cross_pool());
+	print_test_result(test_list_ring_mode());
+	print_test_result(test_list_pq());
+	print_test_result(test_list_hash_index());
+	print_test_result(test_list_order_index());
+	print_test_result(test_list_lru());
+	print_test_result(test_list_move_nodes());
+	print_test_result(test_list_unordered_traversal());
+	print_test_result(test_list_compact());
+	print_test_result(test_list_live_map());
+	print_test_result(test_list_parallel());
+	print_test_result(test_list_algorithms());
+	print_test_result(test_list_partition_select());
+	print_test_result(test_list_image());
+	print_test_result(test_list_delta());
+	print_test_result(test_list_journal());
+	print_test_result(test_list_stream());
+	print_test_result(test_list_packed());
+	print_test_result(test_list_pack_order_only());
+	print_test_result(test_list_crc());
+	print_test_result(test_list_portable_format());
+	print_test_result(test_list_parallel_deserialize());
+	print_test_result(test_list_snapshot());
 
 	printf("==============================\n");
 	printf("测试完成！\n");
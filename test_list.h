@@ -37,10 +37,36 @@ test_result_t test_list_recursive_lock(void);
 test_result_t test_list_edge_cases(void);
 test_result_t test_list_performance(void);
 test_result_t test_list_save_restore(void);
+test_result_t test_list_erase_range(void);
+test_result_t test_list_splice_n(void);
+test_result_t test_list_splice_cross_pool(void);
+test_result_t test_list_ring_mode(void);
+test_result_t test_list_pq(void);
+test_result_t test_list_hash_index(void);
+test_result_t test_list_order_index(void);
+test_result_t test_list_lru(void);
+test_result_t test_list_move_nodes(void);
+test_result_t test_list_unordered_traversal(void);
+test_result_t test_list_compact(void);
+test_result_t test_list_live_map(void);
+test_result_t test_list_parallel(void);
+test_result_t test_list_algorithms(void);
+test_result_t test_list_partition_select(void);
+test_result_t test_list_image(void);
+test_result_t test_list_delta(void);
+test_result_t test_list_journal(void);
+test_result_t test_list_stream(void);
+test_result_t test_list_packed(void);
+test_result_t test_list_pack_order_only(void);
+test_result_t test_list_crc(void);
+test_result_t test_list_portable_format(void);
+test_result_t test_list_parallel_deserialize(void);
+test_result_t test_list_snapshot(void);
 
 // 测试辅助函数
 void print_test_result(test_result_t result);
 bool compare_int(const void *a, const void *b);
+int compare_int_order(const void *a, const void *b);
 bool is_even(const void *list_data, const void *predicate_data);
 bool is_positive(const void *data);
 